@@ -0,0 +1,238 @@
+/*******************************************************************************
+ * File Name        : deferred_log.c
+ *
+ * Description      : This file contains the deferred logger. A message is
+ *                    stored as a pointer to its format string and its raw
+ *                    arguments in a lock-free RAM ring. The formatting and
+ *                    the UART output are done later by deferred_log_drain()
+ *                    from the idle loop.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "deferred_log.h"
+#include "cybsp.h"
+#include <inttypes.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define RING_INDEX_MASK                     (DEFERRED_LOG_RING_SIZE - 1U)
+
+#if (0U != (DEFERRED_LOG_RING_SIZE & RING_INDEX_MASK))
+#error "DEFERRED_LOG_RING_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    /* NULL until the producer has filled in the arguments */
+    const char * volatile   format;
+    uint32_t                args[DEFERRED_LOG_MAX_ARGS];
+} log_entry_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static log_entry_t log_ring[DEFERRED_LOG_RING_SIZE];
+
+/* Free-running counters; the ring index is the counter masked. The head is
+ * advanced by the producers, the tail only by the drain.
+ */
+static volatile uint32_t log_head;
+static volatile uint32_t log_tail;
+
+static volatile uint32_t log_dropped;
+static uint32_t log_dropped_reported;
+static uint32_t log_printed;
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: deferred_log_put
+ *******************************************************************************
+ *
+ * Summary:
+ *  Stores a message in the ring without formatting it. A slot is claimed with
+ *  an exclusive access on the head, so that the function may be called from
+ *  interrupt handlers as well as from the main loop. When the ring is full
+ *  the message is counted as dropped.
+ *
+ * Parameters:
+ *  format - format string; must stay valid until the message is drained.
+ *  arg0 - arg3 - arguments of the format string.
+ *
+ * Return:
+ *  bool - true if the message was stored
+ *
+ ******************************************************************************/
+bool deferred_log_put(const char *format, uint32_t arg0, uint32_t arg1,
+                        uint32_t arg2, uint32_t arg3)
+{
+    uint32_t head;
+    log_entry_t *entry;
+
+    do
+    {
+        head = __LDREXW(&log_head);
+
+        if ((head - log_tail) >= DEFERRED_LOG_RING_SIZE)
+        {
+            __CLREX();
+
+            do
+            {
+                head = __LDREXW(&log_dropped);
+            } while (0U != __STREXW(head + 1U, &log_dropped));
+
+            return false;
+        }
+    } while (0U != __STREXW(head + 1U, &log_head));
+
+    entry = &log_ring[head & RING_INDEX_MASK];
+    entry->args[0] = arg0;
+    entry->args[1] = arg1;
+    entry->args[2] = arg2;
+    entry->args[3] = arg3;
+
+    /* Publish the entry only once its arguments are visible */
+    __DMB();
+    entry->format = format;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: deferred_log_drain
+ *******************************************************************************
+ *
+ * Summary:
+ *  Formats and prints stored messages in the order their slots were claimed.
+ *  Stops at a slot that is claimed but not yet filled in. Messages dropped
+ *  since the previous drain are reported once all others are printed.
+ *  Must not be called from more than one context.
+ *
+ * Parameters:
+ *  max_count - maximum number of messages to print.
+ *
+ * Return:
+ *  uint32_t - number of messages printed
+ *
+ ******************************************************************************/
+uint32_t deferred_log_drain(uint32_t max_count)
+{
+    uint32_t count = 0U;
+    uint32_t tail = log_tail;
+    uint32_t dropped;
+    log_entry_t *entry;
+    const char *format;
+
+    while ((count < max_count) && (tail != log_head))
+    {
+        entry = &log_ring[tail & RING_INDEX_MASK];
+        format = entry->format;
+
+        if (NULL == format)
+        {
+            break;
+        }
+
+        __DMB();
+        (void)printf(format, entry->args[0], entry->args[1], entry->args[2],
+                        entry->args[3]);
+
+        entry->format = NULL;
+        __DMB();
+        tail++;
+        log_tail = tail;
+        count++;
+    }
+
+    log_printed += count;
+    dropped = log_dropped;
+
+    if ((tail == log_head) && (dropped != log_dropped_reported))
+    {
+        (void)printf("\r\n[log] %"PRIu32" message(s) dropped\r\n",
+                        dropped - log_dropped_reported);
+        log_dropped_reported = dropped;
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+ * Function Name: deferred_log_flush
+ *******************************************************************************
+ *
+ * Summary:
+ *  Prints every stored message. Used before output that bypasses the ring,
+ *  so that the console keeps the program order.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void deferred_log_flush(void)
+{
+    while (0U != deferred_log_drain(DEFERRED_LOG_RING_SIZE))
+    {
+    }
+}
+
+/*******************************************************************************
+ * Function Name: deferred_log_get_stats
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the message counters of the logger.
+ *
+ * Parameters:
+ *  stats - receives the counters.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void deferred_log_get_stats(deferred_log_stats_t *stats)
+{
+    stats->dropped = log_dropped;
+    stats->printed = log_printed;
+    stats->written = log_head;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * File Name        : deferred_log.h
+ *
+ * Description      : This file is the public interface of deferred_log.c which
+ *                    records log messages in a RAM ring and prints them later.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _DEFERRED_LOG_H_
+#define _DEFERRED_LOG_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Set to 1U to defer the formatting of DEFERRED_LOGn() messages to
+ * deferred_log_drain(). With 0U they are printed immediately.
+ */
+#ifndef DEFERRED_LOG_ENABLE
+#define DEFERRED_LOG_ENABLE                 (0U)
+#endif
+
+/* Number of entries of the ring; must be a power of two */
+#ifndef DEFERRED_LOG_RING_SIZE
+#define DEFERRED_LOG_RING_SIZE              (32U)
+#endif
+
+#define DEFERRED_LOG_MAX_ARGS               (4U)
+
+/* The format must be a string literal and every argument is passed to it as
+ * a 32-bit word, so conversions are limited to 32-bit integers and to %s of
+ * strings that outlive the drain.
+ */
+#if (DEFERRED_LOG_ENABLE)
+#define DEFERRED_LOG0(fmt)                  \
+    (void)deferred_log_put((fmt), 0U, 0U, 0U, 0U)
+#define DEFERRED_LOG1(fmt, a)               \
+    (void)deferred_log_put((fmt), (uint32_t)(a), 0U, 0U, 0U)
+#define DEFERRED_LOG2(fmt, a, b)            \
+    (void)deferred_log_put((fmt), (uint32_t)(a), (uint32_t)(b), 0U, 0U)
+#define DEFERRED_LOG3(fmt, a, b, c)         \
+    (void)deferred_log_put((fmt), (uint32_t)(a), (uint32_t)(b), \
+                            (uint32_t)(c), 0U)
+#define DEFERRED_LOG4(fmt, a, b, c, d)      \
+    (void)deferred_log_put((fmt), (uint32_t)(a), (uint32_t)(b), \
+                            (uint32_t)(c), (uint32_t)(d))
+#else
+#define DEFERRED_LOG0(fmt)                  (void)printf((fmt))
+#define DEFERRED_LOG1(fmt, a)               \
+    (void)printf((fmt), (uint32_t)(a))
+#define DEFERRED_LOG2(fmt, a, b)            \
+    (void)printf((fmt), (uint32_t)(a), (uint32_t)(b))
+#define DEFERRED_LOG3(fmt, a, b, c)         \
+    (void)printf((fmt), (uint32_t)(a), (uint32_t)(b), (uint32_t)(c))
+#define DEFERRED_LOG4(fmt, a, b, c, d)      \
+    (void)printf((fmt), (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), \
+                    (uint32_t)(d))
+#endif /* (DEFERRED_LOG_ENABLE) */
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t            written;        /* Messages stored in the ring */
+    uint32_t            dropped;        /* Messages lost to a full ring */
+    uint32_t            printed;        /* Messages formatted by the drain */
+} deferred_log_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+bool deferred_log_put(const char *format, uint32_t arg0, uint32_t arg1,
+                        uint32_t arg2, uint32_t arg3);
+uint32_t deferred_log_drain(uint32_t max_count);
+void deferred_log_flush(void);
+void deferred_log_get_stats(deferred_log_stats_t *stats);
+
+#endif /* _DEFERRED_LOG_H_ */
+
+/* [] END OF FILE */
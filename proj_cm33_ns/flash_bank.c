@@ -0,0 +1,308 @@
+/*******************************************************************************
+ * File Name        : flash_bank.c
+ *
+ * Description      : This file splits the memory into equally sized banks,
+ *                    tracks the bank that has an erase in progress and serves
+ *                    reads to the other banks without waiting for the erase.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bank.h"
+#include <string.h>
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: bank_read
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads data with the normal read command of the memory. The raw command
+ *  interface is used so that the read is issued even though the status
+ *  register of the memory reports an erase in progress.
+ *
+ * Parameters:
+ *  obj - bank object.
+ *  address - memory address to read from.
+ *  length - number of bytes to read.
+ *  buf - destination buffer.
+ *
+ * Return:
+ *  cy_en_smif_status_t - status of the operation
+ *
+ ******************************************************************************/
+static cy_en_smif_status_t bank_read(flash_bank_t *obj, uint32_t address,
+                                    uint32_t length, uint8_t *buf)
+{
+    cy_en_smif_status_t status;
+
+    flash_cmd_begin(obj->cmd);
+    status = flash_cmd_read(obj->cmd, address, length, buf,
+                            obj->cmd->mem_config->deviceCfg->readCmd->mode,
+                            false);
+    flash_cmd_end(obj->cmd);
+
+    obj->stats.reads++;
+
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: flash_bank_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Initializes the bank object. The memory is split in bank_count banks of
+ *  equal size.
+ *
+ * Parameters:
+ *  obj - bank object to initialize.
+ *  cmd - raw command interface of the memory.
+ *  bank_count - number of banks, usually FLASH_BANK_COUNT.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bank_init(flash_bank_t *obj, flash_cmd_t *cmd, uint32_t bank_count)
+{
+    obj->cmd = cmd;
+    obj->bank_count = (0U == bank_count) ? 1U : bank_count;
+    obj->bank_size = cmd->mem_config->deviceCfg->memSize / obj->bank_count;
+    obj->busy_bank = FLASH_BANK_NONE;
+    memset(&obj->stats, 0, sizeof(obj->stats));
+}
+
+/*******************************************************************************
+ * Function Name: flash_bank_of
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the bank that contains the address.
+ *
+ * Parameters:
+ *  obj - bank object.
+ *  address - memory address.
+ *
+ * Return:
+ *  uint32_t - bank index
+ *
+ ******************************************************************************/
+uint32_t flash_bank_of(const flash_bank_t *obj, uint32_t address)
+{
+    return address / obj->bank_size;
+}
+
+/*******************************************************************************
+ * Function Name: flash_bank_get_placement
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the bank an allocator should place data with the given access
+ *  pattern in. Read-hot data goes to the first bank and write-heavy data to
+ *  the last one, so that erases of write-heavy data do not stall reads of
+ *  read-hot data. With a single bank both share the whole memory.
+ *
+ * Parameters:
+ *  obj - bank object.
+ *  data - access pattern of the data.
+ *  base - start address of the bank.
+ *  size - size of the bank.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bank_get_placement(const flash_bank_t *obj, flash_bank_data_t data,
+                                uint32_t *base, uint32_t *size)
+{
+    uint32_t bank = (FLASH_BANK_DATA_WRITE_HEAVY == data) ?
+                        (obj->bank_count - 1U) : 0U;
+
+    *base = bank * obj->bank_size;
+    *size = obj->bank_size;
+}
+
+/*******************************************************************************
+ * Function Name: flash_bank_erase_start
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts the erase of a sector and marks its bank busy. Waits first for a
+ *  previous erase to complete, as only one erase can be in progress.
+ *
+ * Parameters:
+ *  obj - bank object.
+ *  address - address within the sector to erase.
+ *
+ * Return:
+ *  cy_en_smif_status_t - status of the operation
+ *
+ ******************************************************************************/
+cy_en_smif_status_t flash_bank_erase_start(flash_bank_t *obj,
+                                            uint32_t address)
+{
+    cy_en_smif_status_t status;
+
+    flash_bank_wait(obj);
+
+    status = flash_cmd_erase_start(obj->cmd, address);
+
+    if (CY_SMIF_SUCCESS == status)
+    {
+        obj->busy_bank = flash_bank_of(obj, address);
+        obj->stats.erases++;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: flash_bank_is_busy
+ *******************************************************************************
+ *
+ * Summary:
+ *  Checks whether a bank has an erase in progress. The status register of the
+ *  memory is read only while an erase is pending.
+ *
+ * Parameters:
+ *  obj - bank object.
+ *  bank - bank index.
+ *
+ * Return:
+ *  bool - true if the bank is busy
+ *
+ ******************************************************************************/
+bool flash_bank_is_busy(flash_bank_t *obj, uint32_t bank)
+{
+    if ((FLASH_BANK_NONE != obj->busy_bank) && !flash_cmd_is_busy(obj->cmd))
+    {
+        obj->busy_bank = FLASH_BANK_NONE;
+    }
+
+    return (bank == obj->busy_bank);
+}
+
+/*******************************************************************************
+ * Function Name: flash_bank_wait
+ *******************************************************************************
+ *
+ * Summary:
+ *  Waits for the erase in progress, if any, to complete.
+ *
+ * Parameters:
+ *  obj - bank object.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bank_wait(flash_bank_t *obj)
+{
+    while ((FLASH_BANK_NONE != obj->busy_bank) &&
+            flash_bank_is_busy(obj, obj->busy_bank))
+    {
+        /* Poll the status register until the erase completes */
+    }
+}
+
+/*******************************************************************************
+ * Function Name: flash_bank_try_read
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads data if the bank that holds it is idle. Lets the caller serve reads
+ *  to idle banks first and come back to the busy one later. The read must
+ *  not cross a bank boundary.
+ *
+ * Parameters:
+ *  obj - bank object.
+ *  address - memory address to read from.
+ *  length - number of bytes to read.
+ *  buf - destination buffer.
+ *
+ * Return:
+ *  cy_en_smif_status_t - CY_SMIF_BUSY if the bank is busy, otherwise the
+ *  status of the read
+ *
+ ******************************************************************************/
+cy_en_smif_status_t flash_bank_try_read(flash_bank_t *obj, uint32_t address,
+                                        uint32_t length, uint8_t *buf)
+{
+    if (flash_bank_is_busy(obj, flash_bank_of(obj, address)))
+    {
+        return CY_SMIF_BUSY;
+    }
+
+    if (FLASH_BANK_NONE != obj->busy_bank)
+    {
+        obj->stats.reads_during_erase++;
+    }
+
+    return bank_read(obj, address, length, buf);
+}
+
+/*******************************************************************************
+ * Function Name: flash_bank_read
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads data, waiting for the erase in progress only if it is in the bank
+ *  that holds the data. The read must not cross a bank boundary.
+ *
+ * Parameters:
+ *  obj - bank object.
+ *  address - memory address to read from.
+ *  length - number of bytes to read.
+ *  buf - destination buffer.
+ *
+ * Return:
+ *  cy_en_smif_status_t - status of the read
+ *
+ ******************************************************************************/
+cy_en_smif_status_t flash_bank_read(flash_bank_t *obj, uint32_t address,
+                                    uint32_t length, uint8_t *buf)
+{
+    cy_en_smif_status_t status = flash_bank_try_read(obj, address, length, buf);
+
+    if (CY_SMIF_BUSY == status)
+    {
+        obj->stats.reads_stalled++;
+        flash_bank_wait(obj);
+        status = bank_read(obj, address, length, buf);
+    }
+
+    return status;
+}
+
+/* [] END OF FILE */
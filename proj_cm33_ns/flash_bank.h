@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * File Name        : flash_bank.h
+ *
+ * Description      : This file is the public interface of flash_bank.c which
+ *                    schedules reads around erases on memories that can read
+ *                    from one bank while another bank is busy.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_BANK_H_
+#define _FLASH_BANK_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_cmd.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Number of equally sized banks that support read-while-write. The serial
+ * memory configuration does not describe banks, so set this from the
+ * datasheet. 1U treats the memory as a single bank: reads wait for erases.
+ */
+#ifndef FLASH_BANK_COUNT
+#define FLASH_BANK_COUNT                    (1U)
+#endif
+
+/* Value of busy_bank when no erase is in progress */
+#define FLASH_BANK_NONE                     (0xFFFFFFFFUL)
+
+/*******************************************************************************
+ * Enumerations
+ ******************************************************************************/
+/* Access pattern of the data an allocator wants to place */
+typedef enum
+{
+    FLASH_BANK_DATA_READ_HOT,       /* Read often, rarely written */
+    FLASH_BANK_DATA_WRITE_HEAVY     /* Programmed and erased often */
+} flash_bank_data_t;
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t    erases;
+    uint32_t    reads;
+    uint32_t    reads_during_erase;
+    uint32_t    reads_stalled;
+} flash_bank_stats_t;
+
+typedef struct
+{
+    flash_cmd_t         *cmd;
+    uint32_t            bank_count;
+    uint32_t            bank_size;
+    uint32_t            busy_bank;
+    flash_bank_stats_t  stats;
+} flash_bank_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void flash_bank_init(flash_bank_t *obj, flash_cmd_t *cmd, uint32_t bank_count);
+uint32_t flash_bank_of(const flash_bank_t *obj, uint32_t address);
+void flash_bank_get_placement(const flash_bank_t *obj, flash_bank_data_t data,
+                                uint32_t *base, uint32_t *size);
+cy_en_smif_status_t flash_bank_erase_start(flash_bank_t *obj,
+                                            uint32_t address);
+bool flash_bank_is_busy(flash_bank_t *obj, uint32_t bank);
+void flash_bank_wait(flash_bank_t *obj);
+cy_en_smif_status_t flash_bank_try_read(flash_bank_t *obj, uint32_t address,
+                                        uint32_t length, uint8_t *buf);
+cy_en_smif_status_t flash_bank_read(flash_bank_t *obj, uint32_t address,
+                                    uint32_t length, uint8_t *buf);
+
+#endif /* _FLASH_BANK_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * File Name        : flash_bench.c
+ *
+ * Description      : This file contains the helpers shared by the benchmarks
+ *                    of the flash access helpers.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bench.h"
+#include "perf_counter.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+uint8_t flash_bench_buf[FLASH_BENCH_BUF_SIZE];
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: flash_bench_random
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the next value of a xorshift32 sequence.
+ *
+ * Parameters:
+ *  state - state of the sequence, updated in place.
+ *
+ * Return:
+ *  uint32_t - next pseudo-random value
+ *
+ ******************************************************************************/
+uint32_t flash_bench_random(uint32_t *state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return x;
+}
+
+/*******************************************************************************
+ * Function Name: flash_bench_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts the cycle counter used by the benchmarks.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bench_init(void)
+{
+    perf_counter_init();
+}
+
+/* [] END OF FILE */
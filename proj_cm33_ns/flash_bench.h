@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * File Name        : flash_bench.h
+ *
+ * Description      : This file is the public interface of flash_bench.c, the
+ *                    helpers shared by the benchmarks of the flash access
+ *                    helpers, one flash_bench_<feature>.c module per helper.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_BENCH_H_
+#define _FLASH_BENCH_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "mtb_serial_memory.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Set to 1U to run the benchmarks after the read/write test in main() */
+#ifndef FLASH_BENCHMARK_ENABLE
+#define FLASH_BENCHMARK_ENABLE              (0U)
+#endif
+
+/* Size of the scratch buffer the benchmarks take their data from */
+#define FLASH_BENCH_BUF_SIZE                (4096U)
+
+/* Seed of the pseudo-random sequences of the benchmarks */
+#define FLASH_BENCH_SEED                    (0x2545F491UL)
+
+/* Random reads issued per read size by the read latency benchmarks */
+#define FLASH_BENCH_READ_COUNT              (256U)
+#define FLASH_BENCH_READ_MIN_SIZE           (16U)
+#define FLASH_BENCH_READ_MAX_SIZE           (128U)
+
+/*******************************************************************************
+ * Data Types
+ ******************************************************************************/
+/* Runs the full serial memory set-up done at boot */
+typedef cy_rslt_t (*flash_bench_setup_t)(void);
+
+/* Starts (true) or stops (false) a periodic interrupt that wakes the CPU from
+ * deep sleep */
+typedef void (*flash_bench_wake_timer_t)(bool enable);
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Scratch buffer shared by the benchmarks, which run one at a time */
+extern uint8_t flash_bench_buf[FLASH_BENCH_BUF_SIZE];
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void flash_bench_init(void);
+uint32_t flash_bench_random(uint32_t *state);
+
+#endif /* _FLASH_BENCH_H_ */
+
+/* [] END OF FILE */
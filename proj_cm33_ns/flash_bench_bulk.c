@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * File Name        : flash_bench_bulk.c
+ *
+ * Description      : This file contains the benchmark of factory bulk
+ *                    programming. Results are printed to the UART console.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bench_bulk.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* The image arrives in pieces of this size and every BULK_BLANK_EVERY-th page
+ * of it is blank.
+ */
+#define BULK_STREAM_CHUNK_SIZE              (64U)
+#define BULK_BLANK_EVERY                    (4U)
+#define BYTES_PER_KIB                       (1024U)
+#define NSEC_PER_MSEC                       (1000000U)
+#define NSEC_PER_SEC                        (1000000000ULL)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static flash_bulk_t bench_bulk;
+static uint8_t bulk_chunk[BULK_STREAM_CHUNK_SIZE];
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: flash_bench_bulk
+ *******************************************************************************
+ *
+ * Summary:
+ *  Programs a synthetic image over a region in factory bulk mode and reports
+ *  the erase and program times and the programming throughput as a share of
+ *  the datasheet limit. The image arrives in small pieces, like a stream
+ *  from a programmer, and every BULK_BLANK_EVERY-th page is blank.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  cmd - raw command interface of the same memory.
+ *  region_addr - start of a range of sectors that may be erased.
+ *  region_size - size of the range.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bench_bulk(mtb_serial_memory_t *mem, flash_cmd_t *cmd,
+                        uint32_t region_addr, uint32_t region_size)
+{
+    uint32_t page;
+    cy_rslt_t result = flash_bulk_begin(&bench_bulk, mem, cmd, region_addr,
+                                        region_size);
+
+    for (uint32_t offset = 0U; (offset < region_size) &&
+        (CY_RSLT_SUCCESS == result); offset += BULK_STREAM_CHUNK_SIZE)
+    {
+        page = offset / bench_bulk.page_size;
+
+        for (uint32_t index = 0U; index < BULK_STREAM_CHUNK_SIZE; index++)
+        {
+            bulk_chunk[index] =
+                ((BULK_BLANK_EVERY - 1U) == (page % BULK_BLANK_EVERY)) ?
+                0xFFU : (uint8_t)(offset + index);
+        }
+
+        result = flash_bulk_write(&bench_bulk, bulk_chunk,
+                                    BULK_STREAM_CHUNK_SIZE);
+    }
+
+    result = (CY_RSLT_SUCCESS != result) ? result :
+                flash_bulk_end(&bench_bulk);
+
+    printf("\r\nBulk programming (%"PRIu32" bytes):\r\n", region_size);
+    printf("-------------------------\r\n");
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed: 0x%08"PRIX32"\r\n", (uint32_t)result);
+        return;
+    }
+
+    printf("Erase: %"PRIu32" ms (%s)\r\n",
+            (uint32_t)(bench_bulk.stats.erase_nsec /
+                        NSEC_PER_MSEC),
+            bench_bulk.stats.chip_erase ? "chip" : "sectors");
+    printf("Program: %"PRIu32" ms, %"PRIu32" pages, %"PRIu32
+            " blank pages skipped, %"PRIu32" polls\r\n",
+            (uint32_t)(bench_bulk.stats.program_nsec /
+                        NSEC_PER_MSEC),
+            bench_bulk.stats.pages_programmed,
+            bench_bulk.stats.pages_skipped, bench_bulk.stats.polls);
+    printf("Image: %"PRIu32" KiB/s with the erase; programming at %"PRIu32
+            "%% of the datasheet limit\r\n",
+            (uint32_t)(((uint64_t)region_size * NSEC_PER_SEC) /
+                        ((bench_bulk.stats.erase_nsec +
+                        bench_bulk.stats.program_nsec) * BYTES_PER_KIB)),
+            flash_bulk_get_efficiency(&bench_bulk));
+}
+
+/* [] END OF FILE */
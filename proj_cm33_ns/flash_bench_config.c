@@ -0,0 +1,216 @@
+/*******************************************************************************
+ * File Name        : flash_bench_config.c
+ *
+ * Description      : This file contains the benchmark of the config store.
+ *                    Results are printed to the UART console.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bench_config.h"
+#include "perf_counter.h"
+#include "flash_config.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* One simulated minute in 1 ms steps. Every step reads CONFIG_READS_PER_MS
+ * values. A setting is dragged like a slider, one change every
+ * CONFIG_SLIDER_STEP_MS for CONFIG_SLIDER_CHANGES changes, once every
+ * CONFIG_SLIDER_PERIOD_MS, and a flag toggles every CONFIG_TOGGLE_PERIOD_MS.
+ */
+#define CONFIG_DURATION_MS                  (60000U)
+#define CONFIG_READS_PER_MS                 (4U)
+#define CONFIG_SLIDER_KEY                   (3U)
+#define CONFIG_SLIDER_PERIOD_MS             (5000U)
+#define CONFIG_SLIDER_STEP_MS               (10U)
+#define CONFIG_SLIDER_CHANGES               (20U)
+#define CONFIG_TOGGLE_KEY                   (7U)
+#define CONFIG_TOGGLE_PERIOD_MS             (2000U)
+#define CONFIG_FLASH_READS                  (64U)
+#define MSEC_PER_SEC                        (1000U)
+#define PERCENT                             (100U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static flash_config_t bench_config;
+static flash_config_t bench_config_reload;
+static const uint32_t config_defaults[FLASH_CONFIG_MAX_ENTRIES] = { 0U };
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: config_step
+ *******************************************************************************
+ *
+ * Summary:
+ *  Runs one millisecond of the config store workload: the reads, the
+ *  changes due at this time and the poll.
+ *
+ * Parameters:
+ *  now_ms - simulated time.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+static cy_rslt_t config_step(uint32_t now_ms)
+{
+    uint32_t phase = now_ms % CONFIG_SLIDER_PERIOD_MS;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    for (uint32_t index = 0U; index < CONFIG_READS_PER_MS; index++)
+    {
+        (void)flash_config_get(&bench_config,
+                                (now_ms + index) % FLASH_CONFIG_MAX_ENTRIES);
+    }
+
+    if ((0U == (phase % CONFIG_SLIDER_STEP_MS)) &&
+        (phase < (CONFIG_SLIDER_STEP_MS * CONFIG_SLIDER_CHANGES)))
+    {
+        result = flash_config_set(&bench_config, CONFIG_SLIDER_KEY,
+                                    now_ms, now_ms);
+    }
+
+    if ((CY_RSLT_SUCCESS == result) &&
+        (0U == (now_ms % CONFIG_TOGGLE_PERIOD_MS)))
+    {
+        result = flash_config_set(&bench_config, CONFIG_TOGGLE_KEY,
+                    flash_config_get(&bench_config, CONFIG_TOGGLE_KEY) ^ 1U,
+                    now_ms);
+    }
+
+    return (CY_RSLT_SUCCESS != result) ? result :
+            flash_config_poll(&bench_config, now_ms);
+}
+
+/*******************************************************************************
+ * Function Name: flash_bench_config
+ *******************************************************************************
+ *
+ * Summary:
+ *  Runs a read-mostly workload on the config store, then reloads the store
+ *  from flash and checks it against the shadow. Reports the records written
+ *  against the writes of a write-through store, which programs one record
+ *  per change, and the cost of a read from the shadow and from flash.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  region_addr - start of FLASH_CONFIG_SECTORS sectors that may be erased.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bench_config(mtb_serial_memory_t *mem, uint32_t region_addr)
+{
+    uint32_t value;
+    uint32_t start;
+    uint32_t shadow_cycles;
+    uint32_t flash_cycles;
+    uint32_t saved;
+    bool match = true;
+    cy_rslt_t result;
+
+    result = flash_config_init(&bench_config, mem, region_addr,
+                                config_defaults);
+    start = perf_counter_get();
+
+    for (uint32_t index = 0U; (index < CONFIG_FLASH_READS) &&
+        (CY_RSLT_SUCCESS == result); index++)
+    {
+        result = mtb_serial_memory_read(mem, region_addr, sizeof(value),
+                                        (uint8_t *)&value);
+    }
+
+    flash_cycles = perf_counter_get() - start;
+    start = perf_counter_get();
+
+    for (uint32_t index = 0U; index < CONFIG_FLASH_READS; index++)
+    {
+        (void)flash_config_get(&bench_config,
+                                index % FLASH_CONFIG_MAX_ENTRIES);
+    }
+
+    shadow_cycles = perf_counter_get() - start;
+
+    for (uint32_t now_ms = 0U; (now_ms < CONFIG_DURATION_MS) &&
+        (CY_RSLT_SUCCESS == result); now_ms++)
+    {
+        result = config_step(now_ms);
+    }
+
+    result = (CY_RSLT_SUCCESS != result) ? result :
+                flash_config_flush(&bench_config);
+    result = (CY_RSLT_SUCCESS != result) ? result :
+                flash_config_init(&bench_config_reload, mem, region_addr,
+                                    config_defaults);
+
+    for (uint32_t key = 0U; key < FLASH_CONFIG_MAX_ENTRIES; key++)
+    {
+        match = match && (flash_config_get(&bench_config, key) ==
+                            flash_config_get(&bench_config_reload, key));
+    }
+
+    printf("\r\nConfig store (%"PRIu32" s, %"PRIu32" reads):\r\n",
+            (uint32_t)(CONFIG_DURATION_MS / MSEC_PER_SEC),
+            (uint32_t)(CONFIG_DURATION_MS * CONFIG_READS_PER_MS));
+    printf("-------------------------\r\n");
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed: 0x%08"PRIX32"\r\n", (uint32_t)result);
+        return;
+    }
+
+    saved = bench_config.stats.changes - bench_config.stats.records;
+    printf("Read: shadow %"PRIu32" ns, flash %"PRIu32" ns\r\n",
+            (uint32_t)(perf_counter_cycles_to_nsec(shadow_cycles) /
+                        CONFIG_FLASH_READS),
+            (uint32_t)(perf_counter_cycles_to_nsec(flash_cycles) /
+                        CONFIG_FLASH_READS));
+    printf("Writes: %"PRIu32" records (%"PRIu32" entries, %"PRIu32
+            " compactions) for %"PRIu32" changes\r\n",
+            bench_config.stats.records, bench_config.stats.entries_written,
+            bench_config.stats.compactions, bench_config.stats.changes);
+    printf("Saved: %"PRIu32" flash writes (%"PRIu32"%%) against "
+            "write-through\r\n", saved,
+            (0U == bench_config.stats.changes) ? 0U :
+            ((saved * PERCENT) / bench_config.stats.changes));
+    printf("Reload: version %"PRIu32", %s\r\n",
+            bench_config_reload.sequence, match ? "matches" : "MISMATCH");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * File Name        : flash_bench_cont_read.c
+ *
+ * Description      : This file contains the benchmark of continuous read mode.
+ *                    Results are printed to the UART console.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bench_cont_read.h"
+#include "flash_bench.h"
+#include "perf_counter.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: flash_bench_cont_read
+ *******************************************************************************
+ *
+ * Summary:
+ *  Measures the latency of random 16 to 128 byte reads issued one by one
+ *  through the serial-memory library and as a burst in continuous read mode.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  cont - continuous read object of the same memory.
+ *  region_addr - start of the region to read from.
+ *  region_size - size of the region to read from.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bench_cont_read(mtb_serial_memory_t *mem, flash_cont_read_t *cont,
+                            uint32_t region_addr, uint32_t region_size)
+{
+    uint32_t seed;
+    uint32_t start;
+    uint64_t lib_cycles;
+    uint64_t cont_cycles;
+    uint32_t address;
+
+    printf("\r\nRandom read latency (%"PRIu32" reads per size):\r\n",
+            (uint32_t)FLASH_BENCH_READ_COUNT);
+    printf("-------------------------\r\n");
+
+    for (uint32_t size = FLASH_BENCH_READ_MIN_SIZE;
+            size <= FLASH_BENCH_READ_MAX_SIZE; size *= 2U)
+    {
+        lib_cycles = 0U;
+        seed = FLASH_BENCH_SEED;
+
+        for (uint32_t count = 0U; count < FLASH_BENCH_READ_COUNT; count++)
+        {
+            address = region_addr +
+                        (flash_bench_random(&seed) % (region_size - size));
+            start = perf_counter_get();
+            (void)mtb_serial_memory_read(mem, address, size, flash_bench_buf);
+            lib_cycles += perf_counter_get() - start;
+        }
+
+        /* Same address sequence, one burst */
+        cont_cycles = 0U;
+        seed = FLASH_BENCH_SEED;
+        flash_cont_read_begin(cont);
+
+        for (uint32_t count = 0U; count < FLASH_BENCH_READ_COUNT; count++)
+        {
+            address = region_addr +
+                        (flash_bench_random(&seed) % (region_size - size));
+            start = perf_counter_get();
+            (void)flash_cont_read(cont, address, size, flash_bench_buf);
+            cont_cycles += perf_counter_get() - start;
+        }
+
+        (void)flash_cont_read_end(cont);
+
+        printf("%3"PRIu32" bytes: library %"PRIu32" ns, continuous %"PRIu32
+                " ns\r\n", size,
+                (uint32_t)(perf_counter_cycles_to_nsec(lib_cycles) /
+                            FLASH_BENCH_READ_COUNT),
+                (uint32_t)(perf_counter_cycles_to_nsec(cont_cycles) /
+                            FLASH_BENCH_READ_COUNT));
+    }
+}
+
+/* [] END OF FILE */
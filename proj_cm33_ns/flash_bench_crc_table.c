@@ -0,0 +1,255 @@
+/*******************************************************************************
+ * File Name        : flash_bench_crc_table.c
+ *
+ * Description      : This file contains the benchmark of the CRC side table.
+ *                    Results are printed to the UART console.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bench_crc_table.h"
+#include "flash_bench.h"
+#include "perf_counter.h"
+#include "flash_crc_table.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* One CRC per page. The first half of the region is written a page at a time,
+ * the second half in two pieces per page split at a random offset; then the
+ * region is read back page by page.
+ */
+#define CRC_GRANULE_SIZE                    (256U)
+#define CRC_SPLIT_MIN                       (16U)
+#define CRC_MAX_REGION_SIZE                 (CRC_GRANULE_SIZE * \
+                                            FLASH_CRC_TABLE_MAX_ENTRIES)
+#define PERCENT                             (100U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static flash_crc_table_t bench_crc_table;
+static uint8_t crc_buf[CRC_GRANULE_SIZE];
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: bench_overhead
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns how much longer a checked operation took than a plain one.
+ *
+ * Parameters:
+ *  plain_cycles - duration without checks.
+ *  checked_cycles - duration with checks.
+ *
+ * Return:
+ *  uint32_t - overhead in percent of the plain duration
+ *
+ ******************************************************************************/
+static uint32_t bench_overhead(uint64_t plain_cycles, uint64_t checked_cycles)
+{
+    return ((0U == plain_cycles) || (checked_cycles <= plain_cycles)) ? 0U :
+            (uint32_t)(((checked_cycles - plain_cycles) * PERCENT) /
+                        plain_cycles);
+}
+
+/*******************************************************************************
+ * Function Name: flash_bench_crc_table
+ *******************************************************************************
+ *
+ * Summary:
+ *  Measures the cost of keeping and checking the CRC side table. The region
+ *  is erased and the table built for the blank region, then random data is
+ *  written through flash_crc_table_write(), whole pages and pages split in
+ *  two, which stores the new CRCs as it goes. Page reads over the whole
+ *  region and random 16 to 128 byte reads are then issued once unchecked
+ *  and once checked; none of them may report a CRC error.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  region_addr - start of the region, a sector the benchmark may erase.
+ *  region_size - size of the sector; at most CRC_MAX_REGION_SIZE is used.
+ *  table_addr - sector holding the table, outside the region.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bench_crc_table(mtb_serial_memory_t *mem, uint32_t region_addr,
+                            uint32_t region_size, uint32_t table_addr)
+{
+    uint32_t size = (region_size < CRC_MAX_REGION_SIZE) ?
+                        (region_size - (region_size % CRC_GRANULE_SIZE)) :
+                        CRC_MAX_REGION_SIZE;
+    uint32_t pages = size / CRC_GRANULE_SIZE;
+    uint64_t plain_cycles = 0U;
+    uint64_t checked_cycles = 0U;
+    uint64_t whole_cycles = 0U;
+    uint64_t split_cycles = 0U;
+    uint32_t bad = 0U;
+    uint32_t bad_total = 0U;
+    uint32_t start;
+    uint32_t seed = FLASH_BENCH_SEED;
+    uint32_t address;
+    uint32_t split;
+    cy_rslt_t result;
+
+    printf("\r\nCRC side table (%"PRIu32" granules of %"PRIu32" bytes):\r\n",
+            pages, (uint32_t)CRC_GRANULE_SIZE);
+    printf("-------------------------\r\n");
+
+    result = mtb_serial_memory_erase(mem, region_addr, region_size);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = flash_crc_table_init(&bench_crc_table, mem, region_addr, size,
+                                        CRC_GRANULE_SIZE, table_addr);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = flash_crc_table_build(&bench_crc_table);
+    }
+
+    for (uint32_t page = 0U; (page < pages) && (CY_RSLT_SUCCESS == result);
+            page++)
+    {
+        address = region_addr + (page * CRC_GRANULE_SIZE);
+
+        for (uint32_t index = 0U; index < CRC_GRANULE_SIZE; index++)
+        {
+            crc_buf[index] = (uint8_t)flash_bench_random(&seed);
+        }
+
+        start = perf_counter_get();
+
+        if (page < (pages / 2U))
+        {
+            result = flash_crc_table_write(&bench_crc_table, address,
+                                            CRC_GRANULE_SIZE, crc_buf);
+            whole_cycles += perf_counter_get() - start;
+        }
+        else
+        {
+            split = CRC_SPLIT_MIN + (flash_bench_random(&seed) %
+                    (CRC_GRANULE_SIZE - (2U * CRC_SPLIT_MIN)));
+            result = flash_crc_table_write(&bench_crc_table, address, split,
+                                            crc_buf);
+
+            if (CY_RSLT_SUCCESS == result)
+            {
+                result = flash_crc_table_write(&bench_crc_table,
+                                                address + split,
+                                                CRC_GRANULE_SIZE - split,
+                                                &crc_buf[split]);
+            }
+
+            split_cycles += perf_counter_get() - start;
+        }
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed: 0x%08"PRIX32"\r\n", (uint32_t)result);
+        return;
+    }
+
+    printf("Page writes: whole %"PRIu32" ns, split in two %"PRIu32" ns, "
+            "update records %"PRIu32", compactions %"PRIu32"\r\n",
+            (uint32_t)(perf_counter_cycles_to_nsec(whole_cycles) / pages / 2U),
+            (uint32_t)(perf_counter_cycles_to_nsec(split_cycles) /
+                        (pages - (pages / 2U))),
+            bench_crc_table.stats.updates,
+            bench_crc_table.stats.compactions);
+
+    for (address = region_addr; address < (region_addr + size);
+            address += CRC_GRANULE_SIZE)
+    {
+        start = perf_counter_get();
+        (void)mtb_serial_memory_read(mem, address, CRC_GRANULE_SIZE, crc_buf);
+        plain_cycles += perf_counter_get() - start;
+
+        start = perf_counter_get();
+        (void)flash_crc_table_read(&bench_crc_table, address, CRC_GRANULE_SIZE,
+                                    crc_buf, &bad);
+        checked_cycles += perf_counter_get() - start;
+        bad_total += bad;
+    }
+
+    printf("Page reads: plain %"PRIu32" ns, checked %"PRIu32" ns (+%"PRIu32
+            "%%)\r\n",
+            (uint32_t)(perf_counter_cycles_to_nsec(plain_cycles) / pages),
+            (uint32_t)(perf_counter_cycles_to_nsec(checked_cycles) / pages),
+            bench_overhead(plain_cycles, checked_cycles));
+
+    for (uint32_t read_size = FLASH_BENCH_READ_MIN_SIZE;
+            read_size <= FLASH_BENCH_READ_MAX_SIZE; read_size *= 2U)
+    {
+        plain_cycles = 0U;
+        checked_cycles = 0U;
+        seed = FLASH_BENCH_SEED;
+
+        for (uint32_t count = 0U; count < FLASH_BENCH_READ_COUNT; count++)
+        {
+            address = region_addr +
+                        (flash_bench_random(&seed) % (size - read_size));
+
+            start = perf_counter_get();
+            (void)mtb_serial_memory_read(mem, address, read_size,
+                                            flash_bench_buf);
+            plain_cycles += perf_counter_get() - start;
+
+            start = perf_counter_get();
+            (void)flash_crc_table_read(&bench_crc_table, address, read_size,
+                                        flash_bench_buf, &bad);
+            checked_cycles += perf_counter_get() - start;
+            bad_total += bad;
+        }
+
+        printf("%3"PRIu32" bytes: plain %"PRIu32" ns, checked %"PRIu32
+                " ns (+%"PRIu32"%%)\r\n", read_size,
+                (uint32_t)(perf_counter_cycles_to_nsec(plain_cycles) /
+                            FLASH_BENCH_READ_COUNT),
+                (uint32_t)(perf_counter_cycles_to_nsec(checked_cycles) /
+                            FLASH_BENCH_READ_COUNT),
+                bench_overhead(plain_cycles, checked_cycles));
+    }
+
+    printf("Extra bytes read: %"PRIu32", CRC errors: %"PRIu32"\r\n",
+            bench_crc_table.stats.extra_bytes, bad_total);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,281 @@
+/*******************************************************************************
+ * File Name        : flash_bench_energy.c
+ *
+ * Description      : This file contains the benchmark of the energy of the
+ *                    flash wait strategies. Results are printed to the UART
+ *                    console.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bench_energy.h"
+#include "cybsp.h"
+#include "flash_energy.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* ENERGY_RECORD_COUNT records of ENERGY_RECORD_SIZE bytes are logged into an
+ * erased sector three times: waiting for each operation by spinning on the
+ * status, by sleeping between status polls, and by sleeping with the records
+ * batched into full pages. The records are taken from the scratch buffer.
+ */
+#define ENERGY_RECORD_COUNT                 (64U)
+#define ENERGY_RECORD_SIZE                  (64U)
+#define ENERGY_STRATEGY_COUNT               (3U)
+#define ENERGY_DATA_SIZE                    (ENERGY_RECORD_COUNT * \
+                                            ENERGY_RECORD_SIZE)
+#define NSEC_PER_USEC                       (1000U)
+#define PJ_PER_NJ                           (1000U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static const char *const energy_names[ENERGY_STRATEGY_COUNT] =
+{
+    "Spin-wait", "Sleep-wait", "Batched"
+};
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: energy_sleep_wait
+ *******************************************************************************
+ *
+ * Summary:
+ *  Sleeps until the wake-up timer or another interrupt fires, then polls the
+ *  status register, until the operation in progress completes.
+ *
+ * Parameters:
+ *  cmd - raw command interface of the memory.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void energy_sleep_wait(flash_cmd_t *cmd)
+{
+    while (flash_cmd_is_busy(cmd))
+    {
+        (void)Cy_SysPm_CpuEnterSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: energy_run
+ *******************************************************************************
+ *
+ * Summary:
+ *  Erases the sector and logs the records of the scratch buffer into it,
+ *  booking each operation with the energy model. A spin-waiting run uses the
+ *  blocking serial memory calls; a sleep-waiting run starts each operation
+ *  through the raw command interface and sleeps until it completes.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  cmd - raw command interface of the same memory.
+ *  region_addr - start of the sector.
+ *  region_size - size of the sector.
+ *  write_size - bytes programmed per write; a divisor of the page size.
+ *  sleep_wait - true to sleep while waiting, false to spin.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+static cy_rslt_t energy_run(mtb_serial_memory_t *mem, flash_cmd_t *cmd,
+                            uint32_t region_addr, uint32_t region_size,
+                            uint32_t write_size, bool sleep_wait)
+{
+    cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    flash_energy_cpu_state_t cpu_state = sleep_wait ?
+                        FLASH_ENERGY_CPU_SLEEP : FLASH_ENERGY_CPU_ACTIVE;
+
+    flash_energy_reset();
+
+    flash_energy_begin();
+    if (sleep_wait)
+    {
+        status = flash_cmd_erase_start(cmd, region_addr);
+        energy_sleep_wait(cmd);
+    }
+    else
+    {
+        result = mtb_serial_memory_erase(mem, region_addr, region_size);
+    }
+    flash_energy_end(FLASH_ENERGY_OP_ERASE, region_size, cpu_state);
+
+    for (uint32_t offset = 0U; (offset < ENERGY_DATA_SIZE) &&
+        (CY_SMIF_SUCCESS == status) && (CY_RSLT_SUCCESS == result);
+        offset += write_size)
+    {
+        flash_energy_begin();
+        if (sleep_wait)
+        {
+            status = flash_cmd_program_start(cmd, region_addr + offset,
+                                                &flash_bench_buf[offset],
+                                                write_size);
+            energy_sleep_wait(cmd);
+        }
+        else
+        {
+            result = mtb_serial_memory_write(mem, region_addr + offset,
+                                                write_size,
+                                                &flash_bench_buf[offset]);
+        }
+        flash_energy_end(FLASH_ENERGY_OP_WRITE, write_size, cpu_state);
+    }
+
+    return (CY_SMIF_SUCCESS == status) ? result : (cy_rslt_t)status;
+}
+
+/*******************************************************************************
+ * Function Name: flash_bench_energy
+ *******************************************************************************
+ *
+ * Summary:
+ *  Compares the energy of logging records into a sector when the CPU
+ *  spin-waits on each operation, sleeps until each operation completes, or
+ *  sleeps with the records batched into full pages. The energy comes from
+ *  the power model of flash_energy.h applied to the measured cycles.
+ *  The sleeping strategies need the raw command interface and are skipped
+ *  on a memory-mapped (XIP) memory.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  cmd - raw command interface of the same memory.
+ *  wake_timer - starts or stops the periodic wake-up interrupt the
+ *  sleep-waiting runs need, or NULL to run only the spin-waiting one.
+ *  region_addr - start of a sector that may be erased.
+ *  region_size - size of the sector.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bench_energy(mtb_serial_memory_t *mem, flash_cmd_t *cmd,
+                        flash_bench_wake_timer_t wake_timer,
+                        uint32_t region_addr, uint32_t region_size)
+{
+    flash_energy_report_t erase;
+    flash_energy_report_t write;
+    uint32_t page_size = (uint32_t)mtb_serial_memory_get_prog_size(mem,
+                                                                region_addr);
+    const uint32_t write_sizes[ENERGY_STRATEGY_COUNT] =
+    {
+        ENERGY_RECORD_SIZE, ENERGY_RECORD_SIZE, page_size
+    };
+    cy_rslt_t result;
+
+    for (uint32_t index = 0U; index < ENERGY_DATA_SIZE; index++)
+    {
+        flash_bench_buf[index] = (uint8_t)(index * 7U);
+    }
+
+    printf("\r\nEnergy per wait strategy (%"PRIu32" records of %"PRIu32
+            " bytes):\r\n", (uint32_t)ENERGY_RECORD_COUNT,
+            (uint32_t)ENERGY_RECORD_SIZE);
+    printf("-------------------------\r\n");
+
+    if ((ENERGY_DATA_SIZE > region_size) || (0U == page_size) ||
+        (0U != (page_size % ENERGY_RECORD_SIZE)) ||
+        (0U != (ENERGY_DATA_SIZE % page_size)))
+    {
+        printf("Skipped: records do not fit the sector or page\r\n");
+        return;
+    }
+
+    for (uint32_t strategy = 0U; strategy < ENERGY_STRATEGY_COUNT; strategy++)
+    {
+        /* The sleeping strategies start each operation through the raw
+         * command interface, which rejects a memory-mapped memory
+         */
+        if ((0U != strategy) && (0U != (cmd->mem_config->flags &
+                                        CY_SMIF_FLAG_MEMORY_MAPPED)))
+        {
+            printf("%-10s: not available on XIP memory\r\n",
+                    energy_names[strategy]);
+            continue;
+        }
+
+        if ((0U != strategy) && (NULL == wake_timer))
+        {
+            printf("%-10s: skipped, no wake-up timer\r\n",
+                    energy_names[strategy]);
+            continue;
+        }
+
+        if (0U != strategy)
+        {
+            wake_timer(true);
+        }
+
+        result = energy_run(mem, cmd, region_addr, region_size,
+                            write_sizes[strategy], (0U != strategy));
+
+        if (0U != strategy)
+        {
+            wake_timer(false);
+        }
+
+        if (CY_RSLT_SUCCESS != result)
+        {
+            printf("%-10s: failed: 0x%08"PRIX32"\r\n",
+                    energy_names[strategy], (uint32_t)result);
+            continue;
+        }
+
+        flash_energy_get_report(FLASH_ENERGY_OP_ERASE, &erase);
+        flash_energy_get_report(FLASH_ENERGY_OP_WRITE, &write);
+        /* A sector erase and one sector of records stay well below 4 J, so
+         * the energies fit the 32-bit conversions of newlib-nano's printf()
+         */
+        printf("%-10s: %"PRIu32" writes in %"PRIu32" us, erase %"PRIu32
+                " nJ, write %"PRIu32" nJ, %"PRIu32" uJ/MB written\r\n",
+                energy_names[strategy], write.ops,
+                (uint32_t)((write.cpu_nsec[FLASH_ENERGY_CPU_ACTIVE] +
+                            write.cpu_nsec[FLASH_ENERGY_CPU_SLEEP]) /
+                            NSEC_PER_USEC),
+                (uint32_t)((erase.flash_energy_pj + erase.cpu_energy_pj) /
+                            PJ_PER_NJ),
+                (uint32_t)((write.flash_energy_pj + write.cpu_energy_pj) /
+                            PJ_PER_NJ),
+                (uint32_t)flash_energy_per_mb_uj(&write));
+    }
+
+    flash_energy_reset();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,194 @@
+/*******************************************************************************
+ * File Name        : flash_bench_fifo.c
+ *
+ * Description      : This file contains the benchmark of the persistent FIFO.
+ *                    Results are printed to the UART console.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bench_fifo.h"
+#include "flash_bench.h"
+#include "perf_counter.h"
+#include "flash_fifo.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Messages are committed and drained in batches */
+#define FIFO_MESSAGE_COUNT                  (512U)
+#define FIFO_MESSAGE_SIZE                   (32U)
+#define FIFO_BATCH_SIZE                     (16U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static flash_fifo_t bench_fifo;
+static uint32_t fifo_drained;
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: fifo_drain_record
+ *******************************************************************************
+ *
+ * Summary:
+ *  Counts the records drained by the FIFO benchmark.
+ *
+ * Parameters:
+ *  data - record.
+ *  length - length of the record.
+ *  arg - unused.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void fifo_drain_record(const uint8_t *data, uint32_t length, void *arg)
+{
+    (void)data;
+    (void)length;
+    (void)arg;
+    fifo_drained++;
+}
+
+/*******************************************************************************
+ * Function Name: bench_msgs_per_sec
+ *******************************************************************************
+ *
+ * Summary:
+ *  Converts a message count and a duration to messages per second.
+ *
+ * Parameters:
+ *  count - number of messages.
+ *  cycles - duration in CPU cycles.
+ *
+ * Return:
+ *  uint32_t - messages per second
+ *
+ ******************************************************************************/
+static uint32_t bench_msgs_per_sec(uint32_t count, uint32_t cycles)
+{
+    uint64_t usec = perf_counter_cycles_to_usec(cycles);
+
+    return (0U == usec) ? 0U :
+            (uint32_t)(((uint64_t)count * PERF_COUNTER_USEC_PER_SEC) / usec);
+}
+
+/*******************************************************************************
+ * Function Name: flash_bench_fifo
+ *******************************************************************************
+ *
+ * Summary:
+ *  Measures the enqueue and drain rate of the persistent FIFO. Messages are
+ *  committed with a flush every FIFO_BATCH_SIZE messages and drained in
+ *  batches of the same size. The partition is formatted first.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  region_addr - start of the partition, aligned to a sector.
+ *  region_size - size of the partition; at least two sectors.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bench_fifo(mtb_serial_memory_t *mem, uint32_t region_addr,
+                        uint32_t region_size)
+{
+    uint32_t start;
+    uint32_t enqueue_cycles;
+    uint32_t drain_cycles;
+    uint32_t count;
+    cy_rslt_t result;
+
+    result = flash_fifo_init(&bench_fifo, mem, region_addr, region_size);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = flash_fifo_format(&bench_fifo);
+    }
+
+    for (uint32_t index = 0U; index < FIFO_MESSAGE_SIZE; index++)
+    {
+        flash_bench_buf[index] = (uint8_t)index;
+    }
+
+    start = perf_counter_get();
+
+    for (uint32_t index = 0U; (index < FIFO_MESSAGE_COUNT) &&
+        (CY_RSLT_SUCCESS == result); index++)
+    {
+        result = flash_fifo_enqueue(&bench_fifo, flash_bench_buf,
+                                    FIFO_MESSAGE_SIZE);
+
+        if ((CY_RSLT_SUCCESS == result) &&
+            (0U == ((index + 1U) % FIFO_BATCH_SIZE)))
+        {
+            result = flash_fifo_flush(&bench_fifo);
+        }
+    }
+
+    enqueue_cycles = perf_counter_get() - start;
+    fifo_drained = 0U;
+    start = perf_counter_get();
+
+    do
+    {
+        result = (CY_RSLT_SUCCESS != result) ? result :
+                    flash_fifo_dequeue(&bench_fifo, &fifo_drain_record, NULL,
+                                        FIFO_BATCH_SIZE, &count);
+    } while ((CY_RSLT_SUCCESS == result) && (0U < count));
+
+    drain_cycles = perf_counter_get() - start;
+
+    printf("\r\nPersistent FIFO (%"PRIu32" x %"PRIu32" bytes, batches of "
+            "%"PRIu32"):\r\n", (uint32_t)FIFO_MESSAGE_COUNT,
+            (uint32_t)FIFO_MESSAGE_SIZE, (uint32_t)FIFO_BATCH_SIZE);
+    printf("-------------------------\r\n");
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed: 0x%08"PRIX32"\r\n", (uint32_t)result);
+        return;
+    }
+
+    printf("Enqueue %"PRIu32" msgs/s, drain %"PRIu32" msgs/s\r\n",
+            bench_msgs_per_sec(FIFO_MESSAGE_COUNT, enqueue_cycles),
+            bench_msgs_per_sec(fifo_drained, drain_cycles));
+    printf("Pages programmed: %"PRIu32", acks: %"PRIu32"\r\n",
+            bench_fifo.stats.pages_programmed, bench_fifo.stats.acks_written);
+}
+
+/* [] END OF FILE */
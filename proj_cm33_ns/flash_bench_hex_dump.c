@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * File Name        : flash_bench_hex_dump.c
+ *
+ * Description      : This file contains the benchmark of the hex dump. Results
+ *                    are printed to the UART console.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bench_hex_dump.h"
+#include "flash_bench.h"
+#include "perf_counter.h"
+#include "hex_dump.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* The scratch buffer is dumped: a header followed by erased flash, which is
+ * what a dump of a freshly written sector looks like.
+ */
+#define DUMP_BUF_SIZE                       (FLASH_BENCH_BUF_SIZE)
+#define DUMP_HEADER_SIZE                    (256U)
+#define DUMP_ERASED_VALUE                   (0xFFU)
+#define DUMP_ROUNDS                         (4U)
+#define DUMP_LEGACY_ITEM_SIZE               (8U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Characters the dump benchmarks would have sent to the console */
+static uint32_t dump_chars;
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: dump_discard
+ *******************************************************************************
+ *
+ * Summary:
+ *  Hex dump writer that only counts the characters, so that the benchmark
+ *  measures the formatting and not the UART.
+ *
+ * Parameters:
+ *  line - formatted line.
+ *  length - length of the line.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void dump_discard(const char *line, uint32_t length)
+{
+    (void)line;
+    dump_chars += length;
+}
+
+/*******************************************************************************
+ * Function Name: dump_legacy
+ *******************************************************************************
+ *
+ * Summary:
+ *  Formats a buffer the way print_array() used to: one formatted print per
+ *  byte and a line break after every 16 bytes. Each print goes to the
+ *  discarding writer.
+ *
+ * Parameters:
+ *  buf - buffer to format.
+ *  size - size of the buffer.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void dump_legacy(const uint8_t *buf, uint32_t size)
+{
+    char item[DUMP_LEGACY_ITEM_SIZE];
+    int length;
+
+    for (uint32_t index = 0U; index < size; index++)
+    {
+        length = snprintf(item, sizeof(item), "0x%02X ", buf[index]);
+        dump_discard(item, (uint32_t)length);
+
+        if (0U == ((index + 1U) % HEX_DUMP_BYTES_PER_LINE))
+        {
+            length = snprintf(item, sizeof(item), "\r\n");
+            dump_discard(item, (uint32_t)length);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: flash_bench_hex_dump
+ *******************************************************************************
+ *
+ * Summary:
+ *  Measures the formatting throughput of the per-byte print loop print_array()
+ *  used to have against the lookup table hex dump, with and without
+ *  collapsing of repeated lines. The output is counted and discarded.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bench_hex_dump(void)
+{
+    hex_dump_config_t config;
+    uint32_t state = FLASH_BENCH_SEED;
+    uint32_t start;
+    uint32_t cycles[3];
+    uint32_t chars[3];
+    static const char *const names[3] =
+    {
+        "printf per byte", "lookup table", "lookup table, collapsed"
+    };
+
+    for (uint32_t index = 0U; index < DUMP_BUF_SIZE; index++)
+    {
+        flash_bench_buf[index] = (index < DUMP_HEADER_SIZE) ?
+                                    (uint8_t)flash_bench_random(&state) :
+                                    DUMP_ERASED_VALUE;
+    }
+
+    hex_dump_get_default_config(&config);
+    config.write = &dump_discard;
+
+    for (uint32_t method = 0U; method < 3U; method++)
+    {
+        config.collapse = (2U == method);
+        dump_chars = 0U;
+        start = perf_counter_get();
+
+        for (uint32_t round = 0U; round < DUMP_ROUNDS; round++)
+        {
+            if (0U == method)
+            {
+                dump_legacy(flash_bench_buf, DUMP_BUF_SIZE);
+            }
+            else
+            {
+                (void)hex_dump(&config, flash_bench_buf, DUMP_BUF_SIZE);
+            }
+        }
+
+        cycles[method] = perf_counter_get() - start;
+        chars[method] = dump_chars / DUMP_ROUNDS;
+    }
+
+    printf("\r\nHex dump of %"PRIu32" bytes:\r\n", (uint32_t)DUMP_BUF_SIZE);
+    printf("-------------------------\r\n");
+
+    for (uint32_t method = 0U; method < 3U; method++)
+    {
+        printf("%s: %"PRIu32" bytes/s, %"PRIu32" characters\r\n",
+                names[method],
+                (uint32_t)(((uint64_t)DUMP_BUF_SIZE * DUMP_ROUNDS *
+                            SystemCoreClock) / (cycles[method] + 1U)),
+                chars[method]);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,190 @@
+/*******************************************************************************
+ * File Name        : flash_bench_lazy_verify.c
+ *
+ * Description      : This file contains the benchmark of lazy write
+ *                    verification. Results are printed to the UART console.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bench_lazy_verify.h"
+#include "perf_counter.h"
+#include "flash_lazy_verify.h"
+#include "mem_compare.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Pages written with an immediate read-back compare, then as many written with
+ * lazy verification
+ */
+#define LAZY_PAGE_SIZE                      (256U)
+#define LAZY_PAGE_COUNT                     (8U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static flash_lazy_verify_t bench_lazy_verify;
+static uint8_t lazy_data[LAZY_PAGE_SIZE];
+static uint8_t lazy_readback[LAZY_PAGE_SIZE];
+static uint32_t lazy_failures;
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: lazy_verify_failed
+ *******************************************************************************
+ *
+ * Summary:
+ *  Counts the failures reported by lazy verification.
+ *
+ * Parameters:
+ *  failure - failed write.
+ *  arg - unused.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void lazy_verify_failed(const flash_lazy_verify_failure_t *failure,
+                                void *arg)
+{
+    (void)failure;
+    (void)arg;
+
+    lazy_failures++;
+}
+
+/*******************************************************************************
+ * Function Name: flash_bench_lazy_verify
+ *******************************************************************************
+ *
+ * Summary:
+ *  Compares the write latency of pages verified by an immediate read-back
+ *  against pages queued for lazy verification, and measures the deferred
+ *  verification of the queue. The sector is erased first.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  region_addr - start of a sector that may be erased.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bench_lazy_verify(mtb_serial_memory_t *mem, uint32_t region_addr)
+{
+    uint32_t address = region_addr;
+    uint64_t sync_cycles = 0U;
+    uint64_t lazy_cycles = 0U;
+    uint32_t flush_cycles;
+    uint32_t mismatches = 0U;
+    mem_compare_t diff;
+    uint32_t start;
+    cy_rslt_t result;
+
+    for (uint32_t index = 0U; index < LAZY_PAGE_SIZE; index++)
+    {
+        lazy_data[index] = (uint8_t)(index ^ LAZY_PAGE_COUNT);
+    }
+
+    lazy_failures = 0U;
+    flash_lazy_verify_init(&bench_lazy_verify, mem, &lazy_verify_failed,
+                            NULL);
+    result = mtb_serial_memory_erase(mem, region_addr,
+                        mtb_serial_memory_get_erase_size(mem, region_addr));
+
+    for (uint32_t page = 0U; (page < LAZY_PAGE_COUNT) &&
+        (CY_RSLT_SUCCESS == result); page++)
+    {
+        start = perf_counter_get();
+        result = mtb_serial_memory_write(mem, address, LAZY_PAGE_SIZE,
+                                            lazy_data);
+
+        if (CY_RSLT_SUCCESS == result)
+        {
+            result = mtb_serial_memory_read(mem, address, LAZY_PAGE_SIZE,
+                                            lazy_readback);
+            mem_compare(&diff, lazy_readback, lazy_data, LAZY_PAGE_SIZE);
+            mismatches += (MEM_COMPARE_MATCH != diff.first) ? 1U : 0U;
+        }
+
+        sync_cycles += perf_counter_get() - start;
+        address += LAZY_PAGE_SIZE;
+    }
+
+    /* Even pages are compared against lazy_data, odd pages against a CRC */
+    for (uint32_t page = 0U; (page < LAZY_PAGE_COUNT) &&
+        (CY_RSLT_SUCCESS == result); page++)
+    {
+        start = perf_counter_get();
+        result = flash_lazy_verify_write(&bench_lazy_verify, address,
+                                        LAZY_PAGE_SIZE, lazy_data,
+                                        (0U == (page & 1U)) ?
+                                        FLASH_LAZY_VERIFY_COMPARE :
+                                        FLASH_LAZY_VERIFY_CRC);
+        lazy_cycles += perf_counter_get() - start;
+        address += LAZY_PAGE_SIZE;
+    }
+
+    start = perf_counter_get();
+    result = (CY_RSLT_SUCCESS != result) ? result :
+                flash_lazy_verify_flush(&bench_lazy_verify);
+    flush_cycles = perf_counter_get() - start;
+
+    printf("\r\nLazy verification (%"PRIu32" pages of %"PRIu32" bytes):\r\n",
+            (uint32_t)LAZY_PAGE_COUNT, (uint32_t)LAZY_PAGE_SIZE);
+    printf("-------------------------\r\n");
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed: 0x%08"PRIX32"\r\n", (uint32_t)result);
+        return;
+    }
+
+    printf("Write latency: verified at once %"PRIu32" ns, lazy %"PRIu32
+            " ns\r\n",
+            (uint32_t)(perf_counter_cycles_to_nsec(sync_cycles) /
+                        LAZY_PAGE_COUNT),
+            (uint32_t)(perf_counter_cycles_to_nsec(lazy_cycles) /
+                        LAZY_PAGE_COUNT));
+    printf("Deferred verification: %"PRIu32" ns per page\r\n",
+            (uint32_t)(perf_counter_cycles_to_nsec(flush_cycles) /
+                        LAZY_PAGE_COUNT));
+    printf("Failures: at once %"PRIu32", lazy %"PRIu32" (%"PRIu32
+            " rewrites)\r\n", mismatches, lazy_failures,
+            bench_lazy_verify.stats.rewrites);
+}
+
+/* [] END OF FILE */
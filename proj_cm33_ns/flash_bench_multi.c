@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * File Name        : flash_bench_multi.c
+ *
+ * Description      : This file contains the benchmark of writes striped across
+ *                    several devices. Results are printed to the UART console.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bench_multi.h"
+#include "perf_counter.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Sectors are programmed page by page */
+#define MULTI_PAGE_SIZE                     (256U)
+#define NSEC_PER_SEC                        (1000000000ULL)
+#define BYTES_PER_KIB                       (1024U)
+#define PERCENT                             (100U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static flash_multi_t bench_multi;
+static uint8_t multi_page[MULTI_PAGE_SIZE];
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: multi_run
+ *******************************************************************************
+ *
+ * Summary:
+ *  Erases and programs sectors striped across devices and returns the time
+ *  taken, erases included.
+ *
+ * Parameters:
+ *  devices - devices in stripe order.
+ *  device_count - number of devices to stripe across.
+ *  sectors - number of sectors to write in total.
+ *  nsec - receives the duration in nanoseconds.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+static cy_rslt_t multi_run(const flash_multi_device_t *devices,
+                            uint32_t device_count, uint32_t sectors,
+                            uint64_t *nsec)
+{
+    uint64_t cycles = 0U;
+    uint32_t length;
+    uint32_t start = perf_counter_get();
+    cy_rslt_t result = flash_multi_init(&bench_multi, devices, device_count);
+
+    length = sectors * bench_multi.sector_size;
+    result = (CY_RSLT_SUCCESS != result) ? result :
+                flash_multi_begin(&bench_multi, 0U, length);
+
+    /* Sum the pages so the 32-bit counter cannot wrap over long erases */
+    for (uint32_t offset = 0U; (offset < length) &&
+        (CY_RSLT_SUCCESS == result); offset += MULTI_PAGE_SIZE)
+    {
+        result = flash_multi_write(&bench_multi, MULTI_PAGE_SIZE, multi_page);
+        cycles += perf_counter_get() - start;
+        start = perf_counter_get();
+    }
+
+    result = (CY_RSLT_SUCCESS != result) ? result :
+                flash_multi_end(&bench_multi);
+    cycles += perf_counter_get() - start;
+    *nsec = perf_counter_cycles_to_nsec(cycles);
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_bench_multi
+ *******************************************************************************
+ *
+ * Summary:
+ *  Compares the write throughput, erases included, of sectors written to the
+ *  first device only against the same sectors striped across all devices.
+ *  The sectors from the base of every device may be erased.
+ *
+ * Parameters:
+ *  devices - devices in stripe order.
+ *  device_count - number of devices.
+ *  sectors - number of sectors to write; the first device must have this
+ *  many from its base.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bench_multi(const flash_multi_device_t *devices,
+                        uint32_t device_count, uint32_t sectors)
+{
+    uint64_t single_nsec = 0U;
+    uint64_t striped_nsec = 0U;
+    uint64_t bytes;
+    uint32_t single_stalls;
+    cy_rslt_t result;
+
+    for (uint32_t index = 0U; index < MULTI_PAGE_SIZE; index++)
+    {
+        multi_page[index] = (uint8_t)~index;
+    }
+
+    result = multi_run(devices, 1U, sectors, &single_nsec);
+    single_stalls = bench_multi.stats.erase_stalls;
+    bytes = bench_multi.stats.bytes;
+    result = (CY_RSLT_SUCCESS != result) ? result :
+                multi_run(devices, device_count, sectors, &striped_nsec);
+
+    printf("\r\nMulti-device write (%"PRIu32" sectors of %"PRIu32
+            " bytes, erases included):\r\n", sectors,
+            bench_multi.sector_size);
+    printf("-------------------------\r\n");
+
+    if ((CY_RSLT_SUCCESS != result) || (0U == single_nsec) ||
+        (0U == striped_nsec))
+    {
+        printf("Failed: 0x%08"PRIX32"\r\n", (uint32_t)result);
+        return;
+    }
+
+    printf("1 device : %"PRIu32" KiB/s, %"PRIu32" programs waited for an "
+            "erase\r\n",
+            (uint32_t)((bytes * NSEC_PER_SEC) / (single_nsec * BYTES_PER_KIB)),
+            single_stalls);
+    printf("%"PRIu32" devices: %"PRIu32" KiB/s, %"PRIu32" programs waited for"
+            " an erase\r\n", device_count,
+            (uint32_t)((bytes * NSEC_PER_SEC) /
+                        (striped_nsec * BYTES_PER_KIB)),
+            bench_multi.stats.erase_stalls);
+    printf("Speed-up: %"PRIu32"%%\r\n",
+            (uint32_t)((single_nsec * PERCENT) / striped_nsec));
+}
+
+/* [] END OF FILE */
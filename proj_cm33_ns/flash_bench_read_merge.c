@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * File Name        : flash_bench_read_merge.c
+ *
+ * Description      : This file contains the benchmark of the read merge stage.
+ *                    Results are printed to the UART console.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bench_read_merge.h"
+#include "perf_counter.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Clients of the read merge benchmark read overlapping neighboring blocks */
+#define MERGE_CLIENT_COUNT                  (16U)
+#define MERGE_CLIENT_READ_SIZE              (32U)
+#define MERGE_CLIENT_STRIDE                 (24U)
+#define MERGE_ROUNDS                        (64U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static uint8_t merge_client_buf[MERGE_CLIENT_COUNT][MERGE_CLIENT_READ_SIZE];
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: flash_bench_read_merge
+ *******************************************************************************
+ *
+ * Summary:
+ *  Compares a round of reads of neighboring, overlapping blocks issued one by
+ *  one against the same round queued and served by the read merge stage.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  merge - read merge object of the same memory.
+ *  region_addr - start of the region to read from.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bench_read_merge(mtb_serial_memory_t *mem,
+                            flash_read_merge_t *merge, uint32_t region_addr)
+{
+    uint32_t start;
+    uint64_t single_cycles = 0U;
+    uint64_t merged_cycles = 0U;
+
+    for (uint32_t round = 0U; round < MERGE_ROUNDS; round++)
+    {
+        start = perf_counter_get();
+
+        for (uint32_t client = 0U; client < MERGE_CLIENT_COUNT; client++)
+        {
+            (void)mtb_serial_memory_read(mem,
+                                region_addr + (client * MERGE_CLIENT_STRIDE),
+                                MERGE_CLIENT_READ_SIZE,
+                                merge_client_buf[client]);
+        }
+
+        single_cycles += perf_counter_get() - start;
+        start = perf_counter_get();
+
+        for (uint32_t client = 0U; client < MERGE_CLIENT_COUNT; client++)
+        {
+            (void)flash_read_merge_submit(merge,
+                                region_addr + (client * MERGE_CLIENT_STRIDE),
+                                MERGE_CLIENT_READ_SIZE,
+                                merge_client_buf[client], NULL, NULL);
+        }
+
+        (void)flash_read_merge_process(merge);
+        merged_cycles += perf_counter_get() - start;
+    }
+
+    printf("\r\nRead merge (%"PRIu32" clients x %"PRIu32" bytes):\r\n",
+            (uint32_t)MERGE_CLIENT_COUNT, (uint32_t)MERGE_CLIENT_READ_SIZE);
+    printf("-------------------------\r\n");
+    printf("Requests: %"PRIu32", transactions: %"PRIu32", merged: %"PRIu32
+            "\r\n", merge->stats.requests, merge->stats.transactions,
+            merge->stats.merged_transactions);
+    printf("Round latency: separate %"PRIu32" ns, merged %"PRIu32" ns\r\n",
+            (uint32_t)(perf_counter_cycles_to_nsec(single_cycles) /
+                        MERGE_ROUNDS),
+            (uint32_t)(perf_counter_cycles_to_nsec(merged_cycles) /
+                        MERGE_ROUNDS));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * File Name        : flash_bench_resume.c
+ *
+ * Description      : This file contains the benchmark of the deep sleep
+ *                    callback of the serial memory. Results are printed to the
+ *                    UART console.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bench_resume.h"
+#include "perf_counter.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Wake-ups measured by the resume benchmark */
+#define RESUME_ROUNDS                       (16U)
+#define RESUME_READ_SIZE                    (16U)
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: flash_bench_resume
+ *******************************************************************************
+ *
+ * Summary:
+ *  Compares the wake-to-first-read latency of the deep sleep callback against
+ *  a full serial memory set-up followed by the same read. Each round puts the
+ *  CPU into deep sleep twice with the wake-up timer running; both latencies
+ *  are counted in cycles from the callback's wake time stamp. Rounds in which
+ *  the callback did not run on both wakes are not counted.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  syspm - deep sleep state of the same memory, registered with SysPm.
+ *  full_setup - function that sets the serial memory up from scratch.
+ *  wake_timer - starts or stops the deep sleep wake-up interrupt, or NULL.
+ *  region_addr - address of the first read.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bench_resume(mtb_serial_memory_t *mem, flash_syspm_t *syspm,
+                        flash_bench_setup_t full_setup,
+                        flash_bench_wake_timer_t wake_timer,
+                        uint32_t region_addr)
+{
+    uint32_t transitions;
+    uint32_t resume;
+    uint32_t restore;
+    uint32_t sleeps = 0U;
+    uint32_t failed = 0U;
+    uint64_t resume_cycles = 0U;
+    uint64_t restore_cycles = 0U;
+    uint64_t setup_cycles = 0U;
+
+    printf("\r\nWake-to-first-read latency:\r\n");
+    printf("-------------------------\r\n");
+
+    if (NULL == wake_timer)
+    {
+        printf("Skipped: no deep sleep wake-up timer\r\n");
+        return;
+    }
+
+    wake_timer(true);
+
+    for (uint32_t round = 0U; round < RESUME_ROUNDS; round++)
+    {
+        transitions = syspm->stats.transitions;
+
+        if (CY_SYSPM_SUCCESS !=
+            Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_INTERRUPT))
+        {
+            failed++;
+            continue;
+        }
+        (void)mtb_serial_memory_read(mem, region_addr, RESUME_READ_SIZE,
+                                    flash_bench_buf);
+        resume = flash_syspm_cycles_since_wake(syspm);
+        restore = syspm->stats.restore_cycles;
+
+        if (CY_SYSPM_SUCCESS !=
+            Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_INTERRUPT))
+        {
+            failed++;
+            continue;
+        }
+        (void)full_setup();
+        (void)mtb_serial_memory_read(mem, region_addr, RESUME_READ_SIZE,
+                                    flash_bench_buf);
+
+        if ((transitions + 2U) == syspm->stats.transitions)
+        {
+            setup_cycles += flash_syspm_cycles_since_wake(syspm);
+            resume_cycles += resume;
+            restore_cycles += restore;
+            sleeps++;
+        }
+    }
+
+    wake_timer(false);
+
+    if (0U == sleeps)
+    {
+        printf("Skipped: deep sleep did not run the SysPm callback "
+                "(%"PRIu32" failed entries)\r\n", failed);
+        return;
+    }
+
+    printf("Rounds: %"PRIu32", failed entries: %"PRIu32", restores: %"PRIu32
+            ", QE sets: %"PRIu32"\r\n", sleeps, failed,
+            syspm->stats.restores, syspm->stats.quad_enables);
+    printf("SysPm callback %"PRIu32" ns (restore %"PRIu32" ns), "
+            "full set-up %"PRIu32" ns\r\n",
+            (uint32_t)(perf_counter_cycles_to_nsec(resume_cycles) / sleeps),
+            (uint32_t)(perf_counter_cycles_to_nsec(restore_cycles) / sleeps),
+            (uint32_t)(perf_counter_cycles_to_nsec(setup_cycles) / sleeps));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,202 @@
+/*******************************************************************************
+ * File Name        : flash_bench_sparse.c
+ *
+ * Description      : This file contains the benchmark of sparse image
+ *                    programming. Results are printed to the UART console.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bench_sparse.h"
+#include "flash_bench.h"
+#include "perf_counter.h"
+#include "flash_sparse.h"
+#include "flash_verify.h"
+#include "mem_compare.h"
+#include <string.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Every block of the image, as large as the scratch buffer, starts with code of
+ * random length and is padded with 0xFF up to the next block, as the linker
+ * does for aligned sections.
+ */
+#define SPARSE_BLOCK_SIZE                   (FLASH_BENCH_BUF_SIZE)
+#define SPARSE_ERASED_VALUE                 (0xFFU)
+#define SPARSE_SEED                         (0x9E3779B9UL)
+#define PERCENT                             (100U)
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: sparse_fill
+ *******************************************************************************
+ *
+ * Summary:
+ *  Fills the scratch buffer with the next block of the synthetic firmware
+ *  image.
+ *
+ * Parameters:
+ *  seed - state of the sequence giving the code length of each block.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void sparse_fill(uint32_t *seed)
+{
+    uint32_t code = flash_bench_random(seed) % SPARSE_BLOCK_SIZE;
+
+    for (uint32_t index = 0U; index < code; index++)
+    {
+        flash_bench_buf[index] = (uint8_t)flash_bench_random(seed);
+    }
+
+    memset(&flash_bench_buf[code], SPARSE_ERASED_VALUE,
+            SPARSE_BLOCK_SIZE - code);
+}
+
+/*******************************************************************************
+ * Function Name: sparse_run
+ *******************************************************************************
+ *
+ * Summary:
+ *  Erases a region and programs the synthetic firmware image over it, with
+ *  plain writes or with blank pages skipped, and returns the program time.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  region_addr - start of a range of sectors that may be erased.
+ *  region_size - size of the range, a multiple of SPARSE_BLOCK_SIZE.
+ *  stats - page counts of the sparse writes, or NULL for plain writes.
+ *  cycles - receives the program time in cycles, erase excluded.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+static cy_rslt_t sparse_run(mtb_serial_memory_t *mem, uint32_t region_addr,
+                            uint32_t region_size, flash_sparse_stats_t *stats,
+                            uint64_t *cycles)
+{
+    uint32_t seed = SPARSE_SEED;
+    uint32_t start;
+    cy_rslt_t result = mtb_serial_memory_erase(mem, region_addr,
+                                                region_size);
+
+    *cycles = 0U;
+
+    for (uint32_t offset = 0U; (offset < region_size) &&
+        (CY_RSLT_SUCCESS == result); offset += SPARSE_BLOCK_SIZE)
+    {
+        sparse_fill(&seed);
+        start = perf_counter_get();
+        result = (NULL == stats) ?
+                    mtb_serial_memory_write(mem, region_addr + offset,
+                                            SPARSE_BLOCK_SIZE,
+                                            flash_bench_buf) :
+                    flash_sparse_write(mem, region_addr + offset,
+                                        SPARSE_BLOCK_SIZE, flash_bench_buf,
+                                        stats);
+        *cycles += perf_counter_get() - start;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_bench_sparse
+ *******************************************************************************
+ *
+ * Summary:
+ *  Programs a synthetic firmware image with 0xFF padding over a region with
+ *  plain writes and with blank pages skipped, checks the result and reports
+ *  the program times and the number of pages skipped.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  region_addr - start of a range of sectors that may be erased.
+ *  region_size - size of the range, a multiple of 4 KiB.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_bench_sparse(mtb_serial_memory_t *mem, uint32_t region_addr,
+                        uint32_t region_size)
+{
+    flash_sparse_stats_t stats = { 0U };
+    uint32_t seed = SPARSE_SEED;
+    uint32_t mismatch = MEM_COMPARE_MATCH;
+    uint64_t plain_cycles;
+    uint64_t sparse_cycles;
+    cy_rslt_t result;
+
+    result = sparse_run(mem, region_addr, region_size, NULL, &plain_cycles);
+    result = (CY_RSLT_SUCCESS != result) ? result :
+                sparse_run(mem, region_addr, region_size, &stats,
+                            &sparse_cycles);
+
+    for (uint32_t offset = 0U; (offset < region_size) &&
+        (CY_RSLT_SUCCESS == result) && (MEM_COMPARE_MATCH == mismatch);
+        offset += SPARSE_BLOCK_SIZE)
+    {
+        sparse_fill(&seed);
+        result = flash_verify_first(mem, region_addr + offset, flash_bench_buf,
+                                    SPARSE_BLOCK_SIZE, &mismatch);
+    }
+
+    printf("\r\nSparse image programming (%"PRIu32" bytes):\r\n",
+            region_size);
+    printf("-------------------------\r\n");
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed: 0x%08"PRIX32"\r\n", (uint32_t)result);
+        return;
+    }
+
+    printf("Pages: %"PRIu32" programmed, %"PRIu32" blank skipped in %"PRIu32
+            " writes\r\n", stats.pages_programmed, stats.pages_skipped,
+            stats.writes);
+    printf("Program time: plain %"PRIu32" us, skipping blank pages %"PRIu32
+            " us\r\n", (uint32_t)perf_counter_cycles_to_usec(plain_cycles),
+            (uint32_t)perf_counter_cycles_to_usec(sparse_cycles));
+    printf("Speed-up: %"PRIu32"%%, image %s\r\n",
+            (uint32_t)((plain_cycles * PERCENT) / sparse_cycles),
+            (MEM_COMPARE_MATCH == mismatch) ? "verified" : "MISMATCH");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,358 @@
+/*******************************************************************************
+ * File Name        : flash_bulk.c
+ *
+ * Description      : This file contains the factory bulk programming mode. The
+ *                    target range is erased with the largest erase available,
+ *                    the image stream is cut into pages and pages that are all
+ *                    0xFF are skipped. The next page is received and checked
+ *                    while the previous one programs, and the status register
+ *                    is first polled after the datasheet tPP.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_bulk.h"
+#include "flash_sparse.h"
+#include "perf_counter.h"
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define PERCENT                             (100U)
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: account
+ *******************************************************************************
+ *
+ * Summary:
+ *  Adds the time since the last call to a total. Called at least once per
+ *  page or poll interval, so the 32-bit counter cannot wrap in between.
+ *
+ * Parameters:
+ *  obj - bulk programming object.
+ *  total - time total to add to, in nanoseconds.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void account(flash_bulk_t *obj, uint64_t *total)
+{
+    uint32_t now = perf_counter_get();
+
+    *total += perf_counter_cycles_to_nsec(now - obj->mark);
+    obj->mark = now;
+}
+
+/*******************************************************************************
+ * Function Name: wait_erase
+ *******************************************************************************
+ *
+ * Summary:
+ *  Polls the status register at FLASH_BULK_ERASE_POLL_US intervals until
+ *  the erase in progress completes.
+ *
+ * Parameters:
+ *  obj - bulk programming object.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void wait_erase(flash_bulk_t *obj)
+{
+    while (flash_cmd_is_busy(obj->cmd))
+    {
+        flash_cmd_delay_us(obj->cmd, FLASH_BULK_ERASE_POLL_US);
+        account(obj, &obj->stats.erase_nsec);
+    }
+
+    account(obj, &obj->stats.erase_nsec);
+}
+
+/*******************************************************************************
+ * Function Name: wait_program
+ *******************************************************************************
+ *
+ * Summary:
+ *  Waits for the page program in progress, if any. Nothing is polled until
+ *  tPP has passed since the program started; after that the status
+ *  register is polled back to back, as the program is due.
+ *
+ * Parameters:
+ *  obj - bulk programming object.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void wait_program(flash_bulk_t *obj)
+{
+    uint64_t elapsed;
+
+    if (!obj->programming)
+    {
+        return;
+    }
+
+    elapsed = perf_counter_cycles_to_nsec(perf_counter_get() -
+                                            obj->program_start);
+
+    if (elapsed < (FLASH_BULK_PAGE_PROGRAM_US * PERF_COUNTER_NSEC_PER_USEC))
+    {
+        flash_cmd_delay_us(obj->cmd, FLASH_BULK_PAGE_PROGRAM_US -
+                            (uint32_t)(elapsed / PERF_COUNTER_NSEC_PER_USEC));
+    }
+
+    do
+    {
+        obj->stats.polls++;
+    }
+    while (flash_cmd_is_busy(obj->cmd));
+
+    obj->programming = false;
+}
+
+/*******************************************************************************
+ * Function Name: submit_page
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts the program of the full page buffer, unless it is blank. The
+ *  buffer can be refilled as soon as this returns.
+ *
+ * Parameters:
+ *  obj - bulk programming object.
+ *
+ * Return:
+ *  cy_rslt_t - CY_RSLT_SUCCESS, or the status of the program command
+ *
+ ******************************************************************************/
+static cy_rslt_t submit_page(flash_bulk_t *obj)
+{
+    cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+
+    if (flash_sparse_is_blank(obj->page, obj->page_size))
+    {
+        obj->stats.pages_skipped++;
+    }
+    else
+    {
+        wait_program(obj);
+        status = flash_cmd_program_start(obj->cmd, obj->base + obj->cursor,
+                                            obj->page, obj->page_size);
+        obj->programming = (CY_SMIF_SUCCESS == status);
+        obj->program_start = perf_counter_get();
+        obj->stats.pages_programmed++;
+    }
+
+    obj->cursor += obj->page_size;
+    obj->fill = 0U;
+    account(obj, &obj->stats.program_nsec);
+
+    return (CY_SMIF_SUCCESS == status) ? CY_RSLT_SUCCESS : (cy_rslt_t)status;
+}
+
+/*******************************************************************************
+ * Function Name: flash_bulk_begin
+ *******************************************************************************
+ *
+ * Summary:
+ *  Erases the target range and prepares to receive its image. A range that
+ *  covers the whole memory is erased with a single chip erase, others
+ *  sector by sector.
+ *
+ * Parameters:
+ *  obj - bulk programming object.
+ *  mem - serial memory object.
+ *  cmd - raw command interface of the same memory.
+ *  base - start of the range, aligned to a sector.
+ *  size - size of the range, a multiple of the sector size.
+ *
+ * Return:
+ *  cy_rslt_t - result of the erase, or CY_SMIF_BAD_PARAM for an unaligned
+ *  range, an unsupported page size or a memory-mapped memory, which the
+ *  running image may execute from and a chip erase would wipe
+ *
+ ******************************************************************************/
+cy_rslt_t flash_bulk_begin(flash_bulk_t *obj, mtb_serial_memory_t *mem,
+                            flash_cmd_t *cmd, uint32_t base, uint32_t size)
+{
+    uint32_t sector_size = (uint32_t)mtb_serial_memory_get_erase_size(mem,
+                                                                    base);
+    cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+
+    memset(obj, 0, sizeof(*obj));
+    obj->mem = mem;
+    obj->cmd = cmd;
+    obj->base = base;
+    obj->size = size;
+    obj->page_size = (uint32_t)mtb_serial_memory_get_prog_size(mem, base);
+
+    if ((0U == size) || (0U == sector_size) ||
+        (0U != (base % sector_size)) || (0U != (size % sector_size)) ||
+        (FLASH_BULK_MAX_PAGE_SIZE < obj->page_size) ||
+        (0U != (obj->page_size % sizeof(uint32_t))) ||
+        ((uint64_t)base + size > mtb_serial_memory_get_size(mem)) ||
+        (0U != (cmd->mem_config->flags & CY_SMIF_FLAG_MEMORY_MAPPED)))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    perf_counter_init();
+    obj->mark = perf_counter_get();
+    obj->stats.chip_erase = ((0U == base) &&
+                                (size == mtb_serial_memory_get_size(mem)));
+
+    if (obj->stats.chip_erase)
+    {
+        status = flash_cmd_chip_erase_start(cmd);
+        wait_erase(obj);
+    }
+
+    for (uint32_t offset = 0U; !obj->stats.chip_erase && (offset < size) &&
+        (CY_SMIF_SUCCESS == status); offset += sector_size)
+    {
+        status = flash_cmd_erase_start(cmd, base + offset);
+        wait_erase(obj);
+    }
+
+    return (CY_SMIF_SUCCESS == status) ? CY_RSLT_SUCCESS : (cy_rslt_t)status;
+}
+
+/*******************************************************************************
+ * Function Name: flash_bulk_write
+ *******************************************************************************
+ *
+ * Summary:
+ *  Appends a piece of the image stream. Pieces can have any size; full
+ *  pages are submitted as they complete.
+ *
+ * Parameters:
+ *  obj - bulk programming object.
+ *  data - next bytes of the image.
+ *  length - number of bytes.
+ *
+ * Return:
+ *  cy_rslt_t - result of the program commands, or CY_SMIF_BAD_PARAM if the
+ *  image is larger than the range
+ *
+ ******************************************************************************/
+cy_rslt_t flash_bulk_write(flash_bulk_t *obj, const uint8_t *data,
+                            uint32_t length)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t piece;
+
+    if (length > (obj->size - obj->cursor - obj->fill))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    while ((0U < length) && (CY_RSLT_SUCCESS == result))
+    {
+        piece = obj->page_size - obj->fill;
+        piece = (piece > length) ? length : piece;
+        memcpy(&obj->page[obj->fill], data, piece);
+        obj->fill += piece;
+        data += piece;
+        length -= piece;
+
+        if (obj->fill == obj->page_size)
+        {
+            result = submit_page(obj);
+        }
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_bulk_end
+ *******************************************************************************
+ *
+ * Summary:
+ *  Programs the last partial page, padded with 0xFF, and waits for the last
+ *  program. The rest of the range stays erased.
+ *
+ * Parameters:
+ *  obj - bulk programming object.
+ *
+ * Return:
+ *  cy_rslt_t - result of the program command
+ *
+ ******************************************************************************/
+cy_rslt_t flash_bulk_end(flash_bulk_t *obj)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (0U < obj->fill)
+    {
+        memset(&obj->page[obj->fill], 0xFF, obj->page_size - obj->fill);
+        result = submit_page(obj);
+    }
+
+    wait_program(obj);
+    account(obj, &obj->stats.program_nsec);
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_bulk_get_efficiency
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the programming throughput as a share of the datasheet limit of
+ *  one page per tPP, for the pages that were programmed.
+ *
+ * Parameters:
+ *  obj - bulk programming object, after flash_bulk_end().
+ *
+ * Return:
+ *  uint32_t - throughput in percent of the limit
+ *
+ ******************************************************************************/
+uint32_t flash_bulk_get_efficiency(const flash_bulk_t *obj)
+{
+    uint64_t limit_nsec = (uint64_t)obj->stats.pages_programmed *
+                            FLASH_BULK_PAGE_PROGRAM_US *
+                            PERF_COUNTER_NSEC_PER_USEC;
+
+    return (0U == obj->stats.program_nsec) ? 0U :
+            (uint32_t)((limit_nsec * PERCENT) / obj->stats.program_nsec);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * File Name        : flash_bulk.h
+ *
+ * Description      : This file is the public interface of flash_bulk.c, which
+ *                    programs a full image stream at the speed the memory
+ *                    allows, for factory provisioning.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_BULK_H_
+#define _FLASH_BULK_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_cmd.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Typical page program time (tPP) from the datasheet. The status register
+ * is first polled after this time, and the throughput is reported against
+ * one page per tPP.
+ */
+#ifndef FLASH_BULK_PAGE_PROGRAM_US
+#define FLASH_BULK_PAGE_PROGRAM_US          (340U)
+#endif
+
+/* Interval between status polls while an erase is in progress */
+#ifndef FLASH_BULK_ERASE_POLL_US
+#define FLASH_BULK_ERASE_POLL_US            (1000U)
+#endif
+
+/* Largest program page supported */
+#define FLASH_BULK_MAX_PAGE_SIZE            (512U)
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t    pages_programmed;
+    uint32_t    pages_skipped;      /* All 0xFF, left erased */
+    uint32_t    polls;              /* Status polls after page programs */
+    bool        chip_erase;
+    uint64_t    erase_nsec;
+    uint64_t    program_nsec;       /* From the end of the erase */
+} flash_bulk_stats_t;
+
+typedef struct
+{
+    mtb_serial_memory_t *mem;
+    flash_cmd_t         *cmd;
+    uint32_t            base;
+    uint32_t            size;
+    uint32_t            page_size;
+    uint32_t            cursor;         /* Offset of the page being filled */
+    uint32_t            fill;           /* Bytes of page received */
+    bool                programming;    /* A page program is in progress */
+    uint32_t            program_start;  /* perf_counter_get() at its start */
+    uint32_t            mark;           /* End of the last time accounted */
+    uint8_t             page[FLASH_BULK_MAX_PAGE_SIZE];
+    flash_bulk_stats_t  stats;
+} flash_bulk_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+cy_rslt_t flash_bulk_begin(flash_bulk_t *obj, mtb_serial_memory_t *mem,
+                            flash_cmd_t *cmd, uint32_t base, uint32_t size);
+cy_rslt_t flash_bulk_write(flash_bulk_t *obj, const uint8_t *data,
+                            uint32_t length);
+cy_rslt_t flash_bulk_end(flash_bulk_t *obj);
+uint32_t flash_bulk_get_efficiency(const flash_bulk_t *obj);
+
+#endif /* _FLASH_BULK_H_ */
+
+/* [] END OF FILE */
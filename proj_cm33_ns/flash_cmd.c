@@ -0,0 +1,493 @@
+/*******************************************************************************
+ * File Name        : flash_cmd.c
+ *
+ * Description      : This file issues raw SMIF commands to the serial memory.
+ *                    The functions run from RAM because the SMIF is switched
+ *                    out of memory mode while a command is in progress.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_cmd.h"
+#include "cybsp.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define BITS_PER_BYTE                       (8U)
+#define SINGLE_BYTE_CMD                     (false)
+#define USEC_PER_MSEC                       (1000U)
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: addr_to_bytes
+ *******************************************************************************
+ *
+ * Summary:
+ *  Converts an address to the byte order sent on the bus, MSB first.
+ *
+ * Parameters:
+ *  cmd - raw command interface.
+ *  address - memory address.
+ *  bytes - destination, at least FLASH_CMD_MAX_ADDR_BYTES long.
+ *
+ * Return:
+ *  uint32_t - number of address bytes of the memory
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+static uint32_t addr_to_bytes(flash_cmd_t *cmd, uint32_t address,
+                                uint8_t *bytes)
+{
+    uint32_t addr_size = cmd->mem_config->deviceCfg->numOfAddrBytes;
+
+    for (uint32_t index = 0U; index < addr_size; index++)
+    {
+        bytes[index] = (uint8_t)(address >>
+                        (BITS_PER_BYTE * (addr_size - index - 1U)));
+    }
+
+    return addr_size;
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: flash_cmd_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Initializes the raw command interface of a memory that has already been set
+ *  up by mtb_serial_memory_setup().
+ *
+ * Parameters:
+ *  cmd - raw command interface to initialize.
+ *  base - SMIF block the memory is connected to.
+ *  context - SMIF context used by the serial memory object.
+ *  mem_config - memory configuration generated by the QSPI Configurator.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_cmd_init(flash_cmd_t *cmd, SMIF_Type *base,
+                    cy_stc_smif_context_t *context,
+                    cy_stc_smif_mem_config_t *mem_config)
+{
+    cmd->base = base;
+    cmd->context = context;
+    cmd->mem_config = mem_config;
+    cmd->saved_intr = 0U;
+    cmd->restore_memory_mode = false;
+}
+
+/*******************************************************************************
+ * Function Name: flash_cmd_begin
+ *******************************************************************************
+ *
+ * Summary:
+ *  Enters a critical section and switches the SMIF to normal mode so that raw
+ *  commands can be sent. Must be paired with flash_cmd_end().
+ *
+ * Parameters:
+ *  cmd - raw command interface.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+void flash_cmd_begin(flash_cmd_t *cmd)
+{
+    cmd->saved_intr = Cy_SysLib_EnterCriticalSection();
+    cmd->restore_memory_mode = (CY_SMIF_MEMORY == Cy_SMIF_GetMode(cmd->base));
+
+    if (cmd->restore_memory_mode)
+    {
+        Cy_SMIF_SetMode(cmd->base, CY_SMIF_NORMAL);
+    }
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: flash_cmd_end
+ *******************************************************************************
+ *
+ * Summary:
+ *  Waits for the SMIF to become idle, restores memory mode if it was active
+ *  and leaves the critical section entered by flash_cmd_begin().
+ *
+ * Parameters:
+ *  cmd - raw command interface.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+void flash_cmd_end(flash_cmd_t *cmd)
+{
+    while (Cy_SMIF_BusyCheck(cmd->base))
+    {
+        /* Wait for the last transfer to leave the FIFO */
+    }
+
+    if (cmd->restore_memory_mode)
+    {
+        Cy_SMIF_SetMode(cmd->base, CY_SMIF_MEMORY);
+    }
+
+    Cy_SysLib_ExitCriticalSection(cmd->saved_intr);
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: flash_cmd_send
+ *******************************************************************************
+ *
+ * Summary:
+ *  Sends a command that consists of the opcode only, e.g. write enable or
+ *  deep power-down. Must be called between flash_cmd_begin() and
+ *  flash_cmd_end().
+ *
+ * Parameters:
+ *  cmd - raw command interface.
+ *  opcode - command opcode.
+ *
+ * Return:
+ *  cy_en_smif_status_t - status of the operation
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+cy_en_smif_status_t flash_cmd_send(flash_cmd_t *cmd, uint8_t opcode)
+{
+    cy_stc_smif_mem_cmd_t *we_cmd = cmd->mem_config->deviceCfg->writeEnCmd;
+
+    /* Opcode-only commands use the same bus width as write enable */
+    return Cy_SMIF_TransmitCommand(cmd->base, opcode, SINGLE_BYTE_CMD,
+                                    we_cmd->cmdWidth, we_cmd->cmdRate,
+                                    NULL, 0U,
+                                    we_cmd->cmdWidth, we_cmd->cmdRate,
+                                    cmd->mem_config->slaveSelect,
+                                    CY_SMIF_TX_LAST_BYTE, cmd->context);
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: flash_cmd_read
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads data with the read command of the memory configuration. The mode
+ *  byte is sent on the address lines right after the address. When
+ *  skip_opcode is set, the opcode phase is omitted, which the memory accepts
+ *  only while it is in continuous read mode. Must be called between
+ *  flash_cmd_begin() and flash_cmd_end().
+ *
+ * Parameters:
+ *  cmd - raw command interface.
+ *  address - memory address to read from.
+ *  length - number of bytes to read.
+ *  buf - destination buffer.
+ *  mode - mode bits, or FLASH_CMD_NO_MODE to omit the mode byte.
+ *  skip_opcode - true to omit the opcode phase.
+ *
+ * Return:
+ *  cy_en_smif_status_t - status of the operation
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+cy_en_smif_status_t flash_cmd_read(flash_cmd_t *cmd, uint32_t address,
+                                    uint32_t length, uint8_t *buf,
+                                    uint32_t mode, bool skip_opcode)
+{
+    cy_en_smif_status_t status;
+    cy_stc_smif_mem_cmd_t *read_cmd = cmd->mem_config->deviceCfg->readCmd;
+    uint8_t param[FLASH_CMD_MAX_ADDR_BYTES + 1U];
+    uint32_t param_size = addr_to_bytes(cmd, address, param);
+
+    if (FLASH_CMD_NO_MODE != mode)
+    {
+        param[param_size++] = (uint8_t)mode;
+    }
+
+    if (skip_opcode)
+    {
+        /* The first address byte takes the place of the opcode */
+        status = Cy_SMIF_TransmitCommand(cmd->base, param[0], SINGLE_BYTE_CMD,
+                                        read_cmd->addrWidth, read_cmd->addrRate,
+                                        &param[1], param_size - 1U,
+                                        read_cmd->addrWidth, read_cmd->addrRate,
+                                        cmd->mem_config->slaveSelect,
+                                        CY_SMIF_TX_NOT_LAST_BYTE, cmd->context);
+    }
+    else
+    {
+        status = Cy_SMIF_TransmitCommand(cmd->base, (uint16_t)read_cmd->command,
+                                        SINGLE_BYTE_CMD,
+                                        read_cmd->cmdWidth, read_cmd->cmdRate,
+                                        param, param_size,
+                                        read_cmd->addrWidth, read_cmd->addrRate,
+                                        cmd->mem_config->slaveSelect,
+                                        CY_SMIF_TX_NOT_LAST_BYTE, cmd->context);
+    }
+
+    if ((CY_SMIF_SUCCESS == status) && (0U < read_cmd->dummyCycles))
+    {
+        status = Cy_SMIF_SendDummyCycles(cmd->base, read_cmd->dummyCycles);
+    }
+
+    if (CY_SMIF_SUCCESS == status)
+    {
+        status = Cy_SMIF_ReceiveDataBlocking(cmd->base, buf, length,
+                                            read_cmd->dataWidth,
+                                            read_cmd->dataRate, cmd->context);
+    }
+
+    return status;
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: flash_cmd_erase_start
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts the erase of the sector that contains the address and returns
+ *  without waiting for the erase to complete. Use flash_cmd_is_busy() to
+ *  poll for completion. Must not be called between flash_cmd_begin() and
+ *  flash_cmd_end().
+ *
+ *  The memory must not be memory-mapped: code cannot be fetched from it
+ *  while it is busy, so the caller could not run until the operation ends.
+ *
+ * Parameters:
+ *  cmd - raw command interface.
+ *  address - address within the sector to erase.
+ *
+ * Return:
+ *  cy_en_smif_status_t - status of the operation, CY_SMIF_BAD_PARAM for a
+ *  memory-mapped memory
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+cy_en_smif_status_t flash_cmd_erase_start(flash_cmd_t *cmd, uint32_t address)
+{
+    cy_en_smif_status_t status;
+    uint8_t addr[FLASH_CMD_MAX_ADDR_BYTES];
+
+    if (0U != (cmd->mem_config->flags & CY_SMIF_FLAG_MEMORY_MAPPED))
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+
+    (void)addr_to_bytes(cmd, address, addr);
+
+    flash_cmd_begin(cmd);
+    status = Cy_SMIF_MemCmdWriteEnable(cmd->base, cmd->mem_config,
+                                        cmd->context);
+
+    if (CY_SMIF_SUCCESS == status)
+    {
+        status = Cy_SMIF_MemCmdSectorErase(cmd->base, cmd->mem_config, addr,
+                                            cmd->context);
+    }
+
+    flash_cmd_end(cmd);
+
+    return status;
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: flash_cmd_chip_erase_start
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts the erase of the whole memory and returns without waiting for it
+ *  to complete. Use flash_cmd_is_busy() to poll for completion. Must not be
+ *  called between flash_cmd_begin() and flash_cmd_end().
+ *
+ *  The memory must not be memory-mapped: code cannot be fetched from it
+ *  while it is busy, so the caller could not run until the operation ends.
+ *
+ * Parameters:
+ *  cmd - raw command interface.
+ *
+ * Return:
+ *  cy_en_smif_status_t - status of the operation, CY_SMIF_BAD_PARAM for a
+ *  memory-mapped memory
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+cy_en_smif_status_t flash_cmd_chip_erase_start(flash_cmd_t *cmd)
+{
+    cy_en_smif_status_t status;
+
+    if (0U != (cmd->mem_config->flags & CY_SMIF_FLAG_MEMORY_MAPPED))
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+
+    flash_cmd_begin(cmd);
+    status = Cy_SMIF_MemCmdWriteEnable(cmd->base, cmd->mem_config,
+                                        cmd->context);
+
+    if (CY_SMIF_SUCCESS == status)
+    {
+        status = Cy_SMIF_MemCmdChipErase(cmd->base, cmd->mem_config,
+                                            cmd->context);
+    }
+
+    flash_cmd_end(cmd);
+
+    return status;
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: flash_cmd_program_start
+ *******************************************************************************
+ *
+ * Summary:
+ *  Sends a page program command with its data and returns without waiting
+ *  for the program to complete, so the caller can prepare the next page
+ *  during tPP. Use flash_cmd_is_busy() to poll for completion. The data
+ *  must not cross a page boundary. Must not be called between
+ *  flash_cmd_begin() and flash_cmd_end().
+ *
+ *  The memory must not be memory-mapped: code cannot be fetched from it
+ *  while it is busy, so the caller could not run until the operation ends.
+ *
+ * Parameters:
+ *  cmd - raw command interface.
+ *  address - address of the first byte to program.
+ *  data - data to program; may be reused once the function returns.
+ *  length - number of bytes to program.
+ *
+ * Return:
+ *  cy_en_smif_status_t - status of the operation, CY_SMIF_BAD_PARAM for a
+ *  memory-mapped memory
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+cy_en_smif_status_t flash_cmd_program_start(flash_cmd_t *cmd,
+                                            uint32_t address,
+                                            const uint8_t *data,
+                                            uint32_t length)
+{
+    cy_en_smif_status_t status;
+    uint8_t addr[FLASH_CMD_MAX_ADDR_BYTES];
+
+    if (0U != (cmd->mem_config->flags & CY_SMIF_FLAG_MEMORY_MAPPED))
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+
+    (void)addr_to_bytes(cmd, address, addr);
+
+    flash_cmd_begin(cmd);
+    status = Cy_SMIF_MemCmdWriteEnable(cmd->base, cmd->mem_config,
+                                        cmd->context);
+
+    if (CY_SMIF_SUCCESS == status)
+    {
+        status = Cy_SMIF_MemCmdProgram(cmd->base, cmd->mem_config, addr,
+                                        data, length, NULL, cmd->context);
+    }
+
+    flash_cmd_end(cmd);
+
+    return status;
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: flash_cmd_is_busy
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads the status register of the memory to check whether a program or
+ *  erase operation is in progress. Must not be called between
+ *  flash_cmd_begin() and flash_cmd_end().
+ *
+ * Parameters:
+ *  cmd - raw command interface.
+ *
+ * Return:
+ *  bool - true if the memory is busy
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+bool flash_cmd_is_busy(flash_cmd_t *cmd)
+{
+    bool busy;
+
+    flash_cmd_begin(cmd);
+    busy = Cy_SMIF_MemIsBusy(cmd->base, cmd->mem_config, cmd->context);
+    flash_cmd_end(cmd);
+
+    return busy;
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: flash_cmd_delay_us
+ *******************************************************************************
+ *
+ * Summary:
+ *  Waits for a timing parameter of the memory, e.g. the time to release it
+ *  from deep power-down. Cy_SysLib_DelayUs() takes 16 bits, so whole
+ *  milliseconds are waited with Cy_SysLib_Delay() and only the rest in
+ *  microseconds.
+ *
+ * Parameters:
+ *  cmd - raw command interface.
+ *  usec - time to wait in microseconds.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_cmd_delay_us(flash_cmd_t *cmd, uint32_t usec)
+{
+    (void)cmd;
+
+    if (usec >= USEC_PER_MSEC)
+    {
+        Cy_SysLib_Delay(usec / USEC_PER_MSEC);
+    }
+
+    Cy_SysLib_DelayUs((uint16_t)(usec % USEC_PER_MSEC));
+}
+
+/* [] END OF FILE */
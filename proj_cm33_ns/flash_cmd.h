@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * File Name        : flash_cmd.h
+ *
+ * Description      : This file is the public interface of flash_cmd.c which
+ *                    issues raw SMIF commands to the serial memory for the
+ *                    operations not covered by the serial-memory library.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_CMD_H_
+#define _FLASH_CMD_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "mtb_serial_memory.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Largest address supported by the SMIF is 4 bytes */
+#define FLASH_CMD_MAX_ADDR_BYTES            (4U)
+
+/* Deep power-down opcodes common to serial NOR flash parts */
+#define FLASH_CMD_DEEP_POWER_DOWN           (0xB9U)
+#define FLASH_CMD_RELEASE_POWER_DOWN        (0xABU)
+
+/* Used for the mode field of a read when no mode bits must be sent */
+#define FLASH_CMD_NO_MODE                   (CY_SMIF_NO_COMMAND_OR_MODE)
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+/* Raw command interface of one serial memory device */
+typedef struct
+{
+    SMIF_Type                   *base;
+    cy_stc_smif_context_t       *context;
+    cy_stc_smif_mem_config_t    *mem_config;
+    uint32_t                    saved_intr;
+    bool                        restore_memory_mode;
+} flash_cmd_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void flash_cmd_init(flash_cmd_t *cmd, SMIF_Type *base,
+                    cy_stc_smif_context_t *context,
+                    cy_stc_smif_mem_config_t *mem_config);
+void flash_cmd_begin(flash_cmd_t *cmd);
+void flash_cmd_end(flash_cmd_t *cmd);
+cy_en_smif_status_t flash_cmd_send(flash_cmd_t *cmd, uint8_t opcode);
+cy_en_smif_status_t flash_cmd_read(flash_cmd_t *cmd, uint32_t address,
+                                    uint32_t length, uint8_t *buf,
+                                    uint32_t mode, bool skip_opcode);
+cy_en_smif_status_t flash_cmd_erase_start(flash_cmd_t *cmd, uint32_t address);
+cy_en_smif_status_t flash_cmd_chip_erase_start(flash_cmd_t *cmd);
+cy_en_smif_status_t flash_cmd_program_start(flash_cmd_t *cmd,
+                                            uint32_t address,
+                                            const uint8_t *data,
+                                            uint32_t length);
+bool flash_cmd_is_busy(flash_cmd_t *cmd);
+void flash_cmd_delay_us(flash_cmd_t *cmd, uint32_t usec);
+
+#endif /* _FLASH_CMD_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,584 @@
+/*******************************************************************************
+ * File Name        : flash_config.c
+ *
+ * Description      : This file keeps configuration values in a RAM shadow,
+ *                    so reads never touch the flash, and writes the changed
+ *                    values in batches. A change starts a coalescing delay;
+ *                    when it expires, all values changed meanwhile are appended
+ *                    to the active sector as one record with a sequence number
+ *                    and a CRC. When the sector is full, a record with every
+ *                    value is written to the other sector, which then takes
+ *                    over. A record only counts once its CRC matches, so a
+ *                    reset during a write falls back to the previous version.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_config.h"
+#include "flash_verify.h"
+#include "crc32.h"
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define CONFIG_MAGIC                        (0x47464E43UL)  /* "CNFG" */
+#define ERASED_WORD                         (0xFFFFFFFFUL)
+#define HEADER_SIZE                         (sizeof(flash_config_header_t))
+#define ENTRY_SIZE                          (sizeof(flash_config_entry_t))
+
+/* Fields of the header covered by its check: sequence and count */
+#define HEADER_CHECKED_SIZE                 (2U * sizeof(uint32_t))
+
+#if (FLASH_CONFIG_MAX_ENTRIES > 32U)
+#error "FLASH_CONFIG_MAX_ENTRIES must fit the 32-bit dirty mask"
+#endif
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: record_size
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the size a record takes in flash.
+ *
+ * Parameters:
+ *  count - number of entries of the record.
+ *
+ * Return:
+ *  uint32_t - size in bytes
+ *
+ ******************************************************************************/
+static uint32_t record_size(uint32_t count)
+{
+    return (uint32_t)(HEADER_SIZE + (count * ENTRY_SIZE));
+}
+
+/*******************************************************************************
+ * Function Name: record_check
+ *******************************************************************************
+ *
+ * Summary:
+ *  Computes the check of a record from its sequence, count and entries.
+ *
+ * Parameters:
+ *  record - record with a valid count.
+ *
+ * Return:
+ *  uint32_t - CRC-32 of the checked fields
+ *
+ ******************************************************************************/
+static uint32_t record_check(const flash_config_record_t *record)
+{
+    uint32_t crc = crc32_update(CRC32_INIT,
+                                (const uint8_t *)&record->header.sequence,
+                                HEADER_CHECKED_SIZE);
+
+    crc = crc32_update(crc, (const uint8_t *)record->entries,
+                        record->header.count * ENTRY_SIZE);
+
+    return crc32_final(crc);
+}
+
+/*******************************************************************************
+ * Function Name: sector_address
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the address of one of the two sectors of the store.
+ *
+ * Parameters:
+ *  obj - config store.
+ *  sector - 0 or 1.
+ *
+ * Return:
+ *  uint32_t - address of the sector
+ *
+ ******************************************************************************/
+static uint32_t sector_address(const flash_config_t *obj, uint32_t sector)
+{
+    return obj->region_addr + (sector * obj->sector_size);
+}
+
+/*******************************************************************************
+ * Function Name: read_record
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads the record at an offset of a sector into obj->record and checks
+ *  it.
+ *
+ * Parameters:
+ *  obj - config store.
+ *  sector - sector to read from.
+ *  offset - offset of the record in the sector.
+ *  valid - receives whether a complete, intact record is there.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash reads
+ *
+ ******************************************************************************/
+static cy_rslt_t read_record(flash_config_t *obj, uint32_t sector,
+                                uint32_t offset, bool *valid)
+{
+    flash_config_record_t *record = &obj->record;
+    uint32_t address = sector_address(obj, sector) + offset;
+    cy_rslt_t result;
+
+    *valid = false;
+
+    if ((offset + HEADER_SIZE) > obj->sector_size)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    result = mtb_serial_memory_read(obj->mem, address, HEADER_SIZE,
+                                    (uint8_t *)&record->header);
+
+    if ((CY_RSLT_SUCCESS != result) || (CONFIG_MAGIC != record->header.magic) ||
+        (FLASH_CONFIG_MAX_ENTRIES < record->header.count) ||
+        ((offset + record_size(record->header.count)) > obj->sector_size))
+    {
+        return result;
+    }
+
+    result = mtb_serial_memory_read(obj->mem, address + HEADER_SIZE,
+                                    record->header.count * ENTRY_SIZE,
+                                    (uint8_t *)record->entries);
+
+    if ((CY_RSLT_SUCCESS != result) ||
+        (record_check(record) != record->header.check))
+    {
+        return result;
+    }
+
+    for (uint32_t index = 0U; index < record->header.count; index++)
+    {
+        if (FLASH_CONFIG_MAX_ENTRIES <= record->entries[index].key)
+        {
+            return result;
+        }
+    }
+
+    *valid = true;
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: apply_record
+ *******************************************************************************
+ *
+ * Summary:
+ *  Copies the values of a checked record into the RAM shadow.
+ *
+ * Parameters:
+ *  obj - config store; obj->record holds the record.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void apply_record(flash_config_t *obj)
+{
+    const flash_config_record_t *record = &obj->record;
+
+    for (uint32_t index = 0U; index < record->header.count; index++)
+    {
+        obj->values[record->entries[index].key] =
+                                                record->entries[index].value;
+    }
+
+    obj->sequence = record->header.sequence;
+}
+
+/*******************************************************************************
+ * Function Name: write_record
+ *******************************************************************************
+ *
+ * Summary:
+ *  Seals the entries in obj->record with the next sequence number and a
+ *  check, programs the record and reads it back.
+ *
+ * Parameters:
+ *  obj - config store.
+ *  sector - sector to write to.
+ *  offset - offset of the record in the sector, erased.
+ *  count - number of entries in obj->record.
+ *  written - receives whether the record reads back as written.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+static cy_rslt_t write_record(flash_config_t *obj, uint32_t sector,
+                                uint32_t offset, uint32_t count,
+                                bool *written)
+{
+    flash_config_record_t *record = &obj->record;
+    uint32_t address = sector_address(obj, sector) + offset;
+    uint32_t size = record_size(count);
+    uint32_t mismatch;
+    cy_rslt_t result;
+
+    record->header.magic = CONFIG_MAGIC;
+    record->header.sequence = obj->sequence + 1U;
+    record->header.count = count;
+    record->header.check = record_check(record);
+
+    *written = false;
+    result = mtb_serial_memory_write(obj->mem, address, size,
+                                        (const uint8_t *)record);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = flash_verify_first(obj->mem, address,
+                                    (const uint8_t *)record, size, &mismatch);
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    obj->stats.records++;
+    obj->stats.entries_written += count;
+
+    if (MEM_COMPARE_MATCH != mismatch)
+    {
+        obj->stats.verify_failures++;
+        return result;
+    }
+
+    *written = true;
+    obj->sequence = record->header.sequence;
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: compact
+ *******************************************************************************
+ *
+ * Summary:
+ *  Erases the other sector and writes every value to it as one record,
+ *  which makes it the active sector. The active sector is left as it is,
+ *  so its records stay valid until the new one is complete.
+ *
+ * Parameters:
+ *  obj - config store.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+static cy_rslt_t compact(flash_config_t *obj)
+{
+    uint32_t other = (obj->active + 1U) % FLASH_CONFIG_SECTORS;
+    bool written;
+    cy_rslt_t result;
+
+    result = mtb_serial_memory_erase(obj->mem, sector_address(obj, other),
+                                        obj->sector_size);
+
+    for (uint32_t key = 0U; key < FLASH_CONFIG_MAX_ENTRIES; key++)
+    {
+        obj->record.entries[key].key = key;
+        obj->record.entries[key].value = obj->values[key];
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = write_record(obj, other, 0U, FLASH_CONFIG_MAX_ENTRIES,
+                                &written);
+    }
+
+    if ((CY_RSLT_SUCCESS == result) && written)
+    {
+        obj->stats.compactions++;
+        obj->active = other;
+        obj->cursor = record_size(FLASH_CONFIG_MAX_ENTRIES);
+        obj->dirty = 0U;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_config_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Loads the newest version of the values. The sector whose first record
+ *  has the higher sequence number is active; its records are applied in
+ *  order up to the first one that is missing or fails its check. Without
+ *  a valid sector the defaults are used. If anything but erased flash
+ *  follows the last record, the next flush compacts into the other sector
+ *  instead of appending.
+ *
+ * Parameters:
+ *  obj - config store.
+ *  mem - serial memory object.
+ *  region_addr - start of FLASH_CONFIG_SECTORS sectors owned by the store.
+ *  defaults - FLASH_CONFIG_MAX_ENTRIES values used when the store is empty.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash reads
+ *
+ ******************************************************************************/
+cy_rslt_t flash_config_init(flash_config_t *obj, mtb_serial_memory_t *mem,
+                            uint32_t region_addr, const uint32_t *defaults)
+{
+    uint32_t sequence[FLASH_CONFIG_SECTORS];
+    bool valid[FLASH_CONFIG_SECTORS];
+    bool intact;
+    uint32_t erased;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if ((NULL == obj) || (NULL == mem) || (NULL == defaults))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    memset(obj, 0, sizeof(*obj));
+    obj->mem = mem;
+    obj->region_addr = region_addr;
+    obj->sector_size = (uint32_t)mtb_serial_memory_get_erase_size(mem,
+                                                                region_addr);
+
+    if (obj->sector_size < record_size(FLASH_CONFIG_MAX_ENTRIES))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    memcpy(obj->values, defaults, sizeof(obj->values));
+
+    /* Nothing to append to until a sector has a full record */
+    obj->cursor = obj->sector_size;
+
+    for (uint32_t sector = 0U; (sector < FLASH_CONFIG_SECTORS) &&
+        (CY_RSLT_SUCCESS == result); sector++)
+    {
+        result = read_record(obj, sector, 0U, &valid[sector]);
+        sequence[sector] = obj->record.header.sequence;
+    }
+
+    if ((CY_RSLT_SUCCESS != result) || (!valid[0] && !valid[1]))
+    {
+        return result;
+    }
+
+    /* Sequence numbers are compared across a wrap */
+    obj->active = (!valid[0] || (valid[1] &&
+                    (0 < (int32_t)(sequence[1] - sequence[0])))) ? 1U : 0U;
+    result = read_record(obj, obj->active, 0U, &intact);
+    obj->cursor = 0U;
+
+    while ((CY_RSLT_SUCCESS == result) && intact &&
+            ((0U == obj->cursor) ||
+            ((obj->sequence + 1U) == obj->record.header.sequence)))
+    {
+        apply_record(obj);
+        obj->cursor += record_size(obj->record.header.count);
+        result = read_record(obj, obj->active, obj->cursor, &intact);
+    }
+
+    if ((CY_RSLT_SUCCESS == result) &&
+        ((obj->cursor + HEADER_SIZE) <= obj->sector_size))
+    {
+        result = mtb_serial_memory_read(mem,
+                                sector_address(obj, obj->active) + obj->cursor,
+                                sizeof(erased), (uint8_t *)&erased);
+
+        if (ERASED_WORD != erased)
+        {
+            obj->cursor = obj->sector_size;
+        }
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_config_get
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns a value from the RAM shadow, including changes not yet written.
+ *
+ * Parameters:
+ *  obj - config store.
+ *  key - key of the value.
+ *
+ * Return:
+ *  uint32_t - the value, or 0 for an unknown key
+ *
+ ******************************************************************************/
+uint32_t flash_config_get(const flash_config_t *obj, uint32_t key)
+{
+    return (key < FLASH_CONFIG_MAX_ENTRIES) ? obj->values[key] : 0U;
+}
+
+/*******************************************************************************
+ * Function Name: flash_config_set
+ *******************************************************************************
+ *
+ * Summary:
+ *  Changes a value in the RAM shadow. The first change after a flush
+ *  starts the coalescing delay. Setting a value it already has costs no
+ *  write.
+ *
+ * Parameters:
+ *  obj - config store.
+ *  key - key of the value.
+ *  value - new value.
+ *  now_ms - current time in milliseconds.
+ *
+ * Return:
+ *  cy_rslt_t - CY_SMIF_BAD_PARAM for an unknown key
+ *
+ ******************************************************************************/
+cy_rslt_t flash_config_set(flash_config_t *obj, uint32_t key, uint32_t value,
+                            uint32_t now_ms)
+{
+    if (FLASH_CONFIG_MAX_ENTRIES <= key)
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    if (obj->values[key] == value)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    if (0U == obj->dirty)
+    {
+        obj->dirty_since_ms = now_ms;
+    }
+
+    obj->values[key] = value;
+    obj->dirty |= 1UL << key;
+    obj->stats.changes++;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: flash_config_poll
+ *******************************************************************************
+ *
+ * Summary:
+ *  Flushes the changed values once FLASH_CONFIG_FLUSH_DELAY_MS has passed
+ *  since the first of them. Call it periodically.
+ *
+ * Parameters:
+ *  obj - config store.
+ *  now_ms - current time in milliseconds.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+cy_rslt_t flash_config_poll(flash_config_t *obj, uint32_t now_ms)
+{
+    if ((0U == obj->dirty) ||
+        ((now_ms - obj->dirty_since_ms) < FLASH_CONFIG_FLUSH_DELAY_MS))
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    return flash_config_flush(obj);
+}
+
+/*******************************************************************************
+ * Function Name: flash_config_flush
+ *******************************************************************************
+ *
+ * Summary:
+ *  Writes the changed values now, for instance before power is removed.
+ *  They are appended as one record, or compacted into the other sector
+ *  when the active one has no room or the appended record does not read
+ *  back. If the compaction fails too, the values stay changed and the next
+ *  flush retries.
+ *
+ * Parameters:
+ *  obj - config store.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+cy_rslt_t flash_config_flush(flash_config_t *obj)
+{
+    uint32_t count = 0U;
+    bool written = false;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (0U == obj->dirty)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    for (uint32_t key = 0U; key < FLASH_CONFIG_MAX_ENTRIES; key++)
+    {
+        if (0U != (obj->dirty & (1UL << key)))
+        {
+            obj->record.entries[count].key = key;
+            obj->record.entries[count].value = obj->values[key];
+            count++;
+        }
+    }
+
+    if ((obj->cursor + record_size(count)) <= obj->sector_size)
+    {
+        result = write_record(obj, obj->active, obj->cursor, count,
+                                &written);
+
+        /* A record that did not read back may hold any data; skip it */
+        obj->cursor += record_size(count);
+    }
+
+    if ((CY_RSLT_SUCCESS == result) && written)
+    {
+        obj->dirty = 0U;
+    }
+    else if (CY_RSLT_SUCCESS == result)
+    {
+        result = compact(obj);
+    }
+
+    return result;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * File Name        : flash_config.h
+ *
+ * Description      : This file is the public interface of flash_config.c,
+ *                    a configuration store that serves reads from a RAM shadow
+ *                    and writes changes to flash in batched, versioned records.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_CONFIG_H_
+#define _FLASH_CONFIG_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "mtb_serial_memory.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Number of values; keys run from 0 to FLASH_CONFIG_MAX_ENTRIES - 1 */
+#ifndef FLASH_CONFIG_MAX_ENTRIES
+#define FLASH_CONFIG_MAX_ENTRIES            (32U)
+#endif
+
+/* Time a change may stay in RAM only; later changes within it are written
+ * with it in the same record.
+ */
+#ifndef FLASH_CONFIG_FLUSH_DELAY_MS
+#define FLASH_CONFIG_FLUSH_DELAY_MS         (1000U)
+#endif
+
+/* The store alternates between two sectors starting at the region address */
+#define FLASH_CONFIG_SECTORS                (2U)
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+/* Stored as is in flash; check covers sequence, count and the entries */
+typedef struct
+{
+    uint32_t    magic;
+    uint32_t    sequence;           /* Version, one more than the last one */
+    uint32_t    count;              /* Entries that follow */
+    uint32_t    check;
+} flash_config_header_t;
+
+typedef struct
+{
+    uint32_t    key;
+    uint32_t    value;
+} flash_config_entry_t;
+
+typedef struct
+{
+    flash_config_header_t   header;
+    flash_config_entry_t    entries[FLASH_CONFIG_MAX_ENTRIES];
+} flash_config_record_t;
+
+typedef struct
+{
+    uint32_t    changes;            /* Sets that changed a value */
+    uint32_t    records;            /* Records written, compactions too */
+    uint32_t    entries_written;
+    uint32_t    compactions;        /* Full records written to a new sector */
+    uint32_t    verify_failures;    /* Records that did not read back */
+} flash_config_stats_t;
+
+typedef struct
+{
+    mtb_serial_memory_t     *mem;
+    uint32_t                region_addr;
+    uint32_t                sector_size;
+    uint32_t                active;         /* Sector holding the records */
+    uint32_t                cursor;         /* Next record, sector offset */
+    uint32_t                sequence;       /* Of the last record */
+    uint32_t                values[FLASH_CONFIG_MAX_ENTRIES];
+    uint32_t                dirty;          /* One bit per key */
+    uint32_t                dirty_since_ms;
+    flash_config_record_t   record;
+    flash_config_stats_t    stats;
+} flash_config_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+cy_rslt_t flash_config_init(flash_config_t *obj, mtb_serial_memory_t *mem,
+                            uint32_t region_addr, const uint32_t *defaults);
+uint32_t flash_config_get(const flash_config_t *obj, uint32_t key);
+cy_rslt_t flash_config_set(flash_config_t *obj, uint32_t key, uint32_t value,
+                            uint32_t now_ms);
+cy_rslt_t flash_config_poll(flash_config_t *obj, uint32_t now_ms);
+cy_rslt_t flash_config_flush(flash_config_t *obj);
+
+#endif /* _FLASH_CONFIG_H_ */
+
+/* [] END OF FILE */
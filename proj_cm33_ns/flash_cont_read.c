@@ -0,0 +1,189 @@
+/*******************************************************************************
+ * File Name        : flash_cont_read.c
+ *
+ * Description      : This file implements read bursts in continuous read mode.
+ *                    The first read of a burst sends the opcode with the mode
+ *                    bits that keep the memory in continuous read mode; the
+ *                    following reads send the address only. The burst is closed
+ *                    with a read that clears the mode, so writes and erases
+ *                    issued after flash_cont_read_end() see a memory in the
+ *                    normal command state.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_cont_read.h"
+#include "cybsp.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Size of the read that takes the memory out of continuous read mode */
+#define EXIT_READ_SIZE                      (1U)
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: flash_cont_read_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Initializes the continuous read object. The read command of the memory
+ *  configuration must have a mode phase, and the memory must not be
+ *  memory-mapped: between flash_cont_read_begin() and flash_cont_read_end()
+ *  the SMIF is out of XIP mode and the memory answers only continuous
+ *  reads, so no code can be fetched from it.
+ *
+ * Parameters:
+ *  obj - continuous read object to initialize.
+ *  cmd - raw command interface of the memory.
+ *
+ * Return:
+ *  cy_en_smif_status_t - CY_SMIF_BAD_PARAM if the read command has no mode
+ *  phase or the memory is memory-mapped, CY_SMIF_SUCCESS otherwise
+ *
+ ******************************************************************************/
+cy_en_smif_status_t flash_cont_read_init(flash_cont_read_t *obj,
+                                        flash_cmd_t *cmd)
+{
+    obj->cmd = cmd;
+    obj->in_burst = false;
+    obj->mode_active = false;
+    obj->last_address = 0U;
+    obj->reads = 0U;
+    obj->opcodes_skipped = 0U;
+
+    return ((CY_SMIF_NO_COMMAND_OR_MODE ==
+            cmd->mem_config->deviceCfg->readCmd->mode) ||
+            (0U != (cmd->mem_config->flags & CY_SMIF_FLAG_MEMORY_MAPPED))) ?
+            CY_SMIF_BAD_PARAM : CY_SMIF_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: flash_cont_read_begin
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts a burst of reads. Interrupts are disabled until
+ *  flash_cont_read_end() is called, so keep bursts short.
+ *
+ * Parameters:
+ *  obj - continuous read object.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_cont_read_begin(flash_cont_read_t *obj)
+{
+    flash_cmd_begin(obj->cmd);
+    obj->in_burst = true;
+}
+
+/*******************************************************************************
+ * Function Name: flash_cont_read
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads data within a burst. The opcode is sent only when the memory is not
+ *  yet in continuous read mode.
+ *
+ * Parameters:
+ *  obj - continuous read object.
+ *  address - memory address to read from.
+ *  length - number of bytes to read.
+ *  buf - destination buffer.
+ *
+ * Return:
+ *  cy_en_smif_status_t - status of the operation
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+cy_en_smif_status_t flash_cont_read(flash_cont_read_t *obj, uint32_t address,
+                                    uint32_t length, uint8_t *buf)
+{
+    cy_en_smif_status_t status;
+
+    CY_ASSERT(obj->in_burst);
+
+    status = flash_cmd_read(obj->cmd, address, length, buf,
+                            FLASH_CONT_READ_MODE_ENTER, obj->mode_active);
+
+    if (CY_SMIF_SUCCESS == status)
+    {
+        if (obj->mode_active)
+        {
+            obj->opcodes_skipped++;
+        }
+
+        obj->mode_active = true;
+        obj->last_address = address;
+        obj->reads++;
+    }
+
+    return status;
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: flash_cont_read_end
+ *******************************************************************************
+ *
+ * Summary:
+ *  Takes the memory out of continuous read mode and ends the burst.
+ *
+ * Parameters:
+ *  obj - continuous read object.
+ *
+ * Return:
+ *  cy_en_smif_status_t - status of the exit read
+ *
+ ******************************************************************************/
+cy_en_smif_status_t flash_cont_read_end(flash_cont_read_t *obj)
+{
+    cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+    uint8_t dummy_buf[EXIT_READ_SIZE];
+
+    if (obj->mode_active)
+    {
+        status = flash_cmd_read(obj->cmd, obj->last_address, EXIT_READ_SIZE,
+                                dummy_buf, FLASH_CONT_READ_MODE_EXIT, true);
+        obj->mode_active = false;
+    }
+
+    flash_cmd_end(obj->cmd);
+    obj->in_burst = false;
+
+    return status;
+}
+
+/* [] END OF FILE */
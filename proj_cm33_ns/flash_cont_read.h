@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * File Name        : flash_cont_read.h
+ *
+ * Description      : This file is the public interface of flash_cont_read.c
+ *                    which keeps the memory in continuous read mode during a
+ *                    burst of reads so that only the first read sends the
+ *                    opcode.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_CONT_READ_H_
+#define _FLASH_CONT_READ_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_cmd.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Mode bits that keep the memory in continuous read mode after a read.
+ * Infineon quad SPI NOR parts expect 0xAx; check the datasheet of the part.
+ */
+#ifndef FLASH_CONT_READ_MODE_ENTER
+#define FLASH_CONT_READ_MODE_ENTER          (0xA0U)
+#endif
+
+/* Mode bits that make the memory leave continuous read mode after a read */
+#ifndef FLASH_CONT_READ_MODE_EXIT
+#define FLASH_CONT_READ_MODE_EXIT           (0x00U)
+#endif
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    flash_cmd_t     *cmd;
+    bool            in_burst;
+    bool            mode_active;
+    uint32_t        last_address;
+    uint32_t        reads;
+    uint32_t        opcodes_skipped;
+} flash_cont_read_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+cy_en_smif_status_t flash_cont_read_init(flash_cont_read_t *obj,
+                                        flash_cmd_t *cmd);
+void flash_cont_read_begin(flash_cont_read_t *obj);
+cy_en_smif_status_t flash_cont_read(flash_cont_read_t *obj, uint32_t address,
+                                    uint32_t length, uint8_t *buf);
+cy_en_smif_status_t flash_cont_read_end(flash_cont_read_t *obj);
+
+#endif /* _FLASH_CONT_READ_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,563 @@
+/*******************************************************************************
+ * File Name        : flash_crc_table.c
+ *
+ * Description      : This file contains a side table of CRC-32 values, one per
+ *                    granule of a flash region, kept in a sector of its own.
+ *                    Reads through the table check every granule they touch,
+ *                    so corruption is found without a reference copy. Writes
+ *                    through the table append the new CRCs to its sector.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_crc_table.h"
+#include "crc32.h"
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define TABLE_MAGIC                         (0x54435243UL)  /* "CRCT" */
+#define UPDATE_MAGIC                        (0x55435243UL)  /* "CRCU" */
+#define ERASED_WORD                         (0xFFFFFFFFUL)
+
+/* Update records follow the image, each in its own aligned slot so that no
+ * slot is programmed twice.
+ */
+#define UPDATE_SIZE                         \
+    ((uint32_t)sizeof(flash_crc_table_update_t))
+#define UPDATE_START                        \
+    ((((uint32_t)sizeof(flash_crc_table_image_t) + UPDATE_SIZE - 1U) / \
+    UPDATE_SIZE) * UPDATE_SIZE)
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: image_check
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the CRC that protects the entries of the table image.
+ *
+ * Parameters:
+ *  obj - table object.
+ *
+ * Return:
+ *  uint32_t - CRC-32 of the used entries
+ *
+ ******************************************************************************/
+static uint32_t image_check(const flash_crc_table_t *obj)
+{
+    return crc32((const uint8_t *)obj->image.crc,
+                    obj->image.entry_count * (uint32_t)sizeof(uint32_t));
+}
+
+/*******************************************************************************
+ * Function Name: update_check
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the CRC that protects an update record.
+ *
+ * Parameters:
+ *  update - update record.
+ *
+ * Return:
+ *  uint32_t - CRC-32 of the index and the CRC of the record
+ *
+ ******************************************************************************/
+static uint32_t update_check(const flash_crc_table_update_t *update)
+{
+    return crc32((const uint8_t *)&update->index,
+                    (uint32_t)(sizeof(update->index) + sizeof(update->crc)));
+}
+
+/*******************************************************************************
+ * Function Name: load_updates
+ *******************************************************************************
+ *
+ * Summary:
+ *  Applies the update records that follow a valid image, in the order they
+ *  were written, and finds the first free record. A record cut short by a
+ *  reset fails its check and is skipped; the granule it describes then
+ *  keeps its previous CRC and reads back as bad.
+ *
+ * Parameters:
+ *  obj - table object with a valid image.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash reads
+ *
+ ******************************************************************************/
+static cy_rslt_t load_updates(flash_crc_table_t *obj)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    flash_crc_table_update_t update;
+
+    obj->next_update = UPDATE_START;
+
+    while ((CY_RSLT_SUCCESS == result) &&
+            ((obj->next_update + UPDATE_SIZE) <= obj->sector_size))
+    {
+        result = mtb_serial_memory_read(obj->mem,
+                                        obj->table_addr + obj->next_update,
+                                        UPDATE_SIZE, (uint8_t *)&update);
+
+        if ((CY_RSLT_SUCCESS != result) || ((ERASED_WORD == update.magic) &&
+            (ERASED_WORD == update.index) && (ERASED_WORD == update.crc) &&
+            (ERASED_WORD == update.check)))
+        {
+            break;
+        }
+
+        if ((UPDATE_MAGIC == update.magic) &&
+            (update.index < obj->image.entry_count) &&
+            (update_check(&update) == update.check))
+        {
+            obj->image.crc[update.index] = update.crc;
+        }
+
+        obj->next_update += UPDATE_SIZE;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: store_image
+ *******************************************************************************
+ *
+ * Summary:
+ *  Erases the table sector and programs the image with the current CRCs,
+ *  which drops the update records.
+ *
+ * Parameters:
+ *  obj - table object.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+static cy_rslt_t store_image(flash_crc_table_t *obj)
+{
+    cy_rslt_t result;
+
+    obj->image.magic = TABLE_MAGIC;
+    obj->image.granule_size = obj->granule_size;
+    obj->image.entry_count = obj->size / obj->granule_size;
+    obj->image.check = image_check(obj);
+    obj->next_update = UPDATE_START;
+
+    result = mtb_serial_memory_erase(obj->mem, obj->table_addr,
+                                    obj->sector_size);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = mtb_serial_memory_write(obj->mem, obj->table_addr,
+                                        sizeof(obj->image),
+                                        (const uint8_t *)&obj->image);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: append_update
+ *******************************************************************************
+ *
+ * Summary:
+ *  Stores the new CRC of a granule as an update record. When the sector has
+ *  no free record left, the image is rewritten with all CRCs instead; a
+ *  reset during the rewrite leaves no valid table, which
+ *  flash_crc_table_init() reports so that the table is built again.
+ *
+ * Parameters:
+ *  obj - table object.
+ *  index - granule index.
+ *  crc - new CRC-32 of the granule.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+static cy_rslt_t append_update(flash_crc_table_t *obj, uint32_t index,
+                                uint32_t crc)
+{
+    flash_crc_table_update_t update;
+    cy_rslt_t result;
+
+    obj->image.crc[index] = crc;
+
+    if ((obj->next_update + UPDATE_SIZE) > obj->sector_size)
+    {
+        obj->stats.compactions++;
+
+        return store_image(obj);
+    }
+
+    update.magic = UPDATE_MAGIC;
+    update.index = index;
+    update.crc = crc;
+    update.check = update_check(&update);
+
+    result = mtb_serial_memory_write(obj->mem,
+                                    obj->table_addr + obj->next_update,
+                                    UPDATE_SIZE, (const uint8_t *)&update);
+    obj->next_update += UPDATE_SIZE;
+    obj->stats.updates++;
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: read_granule
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads one granule and returns its CRC, computed as each part arrives.
+ *  The part within [req_start, req_end) is read straight into the caller's
+ *  buffer; the rest only feeds the CRC and goes through the chunk buffer.
+ *
+ * Parameters:
+ *  obj - table object.
+ *  index - granule index.
+ *  req_start - first requested address.
+ *  req_end - end of the requested range.
+ *  buf - caller's buffer, holding the data of req_start at offset 0; NULL
+ *        to only compute the CRC.
+ *  crc - receives the CRC-32 of the granule.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash reads
+ *
+ ******************************************************************************/
+static cy_rslt_t read_granule(flash_crc_table_t *obj, uint32_t index,
+                                uint32_t req_start, uint32_t req_end,
+                                uint8_t *buf, uint32_t *crc)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t address = obj->base + (index * obj->granule_size);
+    uint32_t end = address + obj->granule_size;
+    uint32_t value = CRC32_INIT;
+
+    while ((address < end) && (CY_RSLT_SUCCESS == result))
+    {
+        uint32_t limit = end;
+        uint8_t *dst = obj->chunk;
+        uint32_t length;
+
+        if ((NULL != buf) && (address >= req_start) && (address < req_end))
+        {
+            limit = (req_end < end) ? req_end : end;
+            dst = &buf[address - req_start];
+            length = limit - address;
+        }
+        else
+        {
+            if ((NULL != buf) && (address < req_start) && (req_start < end))
+            {
+                limit = req_start;
+            }
+
+            length = ((limit - address) < FLASH_CRC_TABLE_CHUNK_SIZE) ?
+                        (limit - address) : FLASH_CRC_TABLE_CHUNK_SIZE;
+            obj->stats.extra_bytes += (NULL != buf) ? length : 0U;
+        }
+
+        result = mtb_serial_memory_read(obj->mem, address, length, dst);
+        value = crc32_update(value, dst, length);
+        address += length;
+    }
+
+    *crc = crc32_final(value);
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_crc_table_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Sets up the table of a region and loads it from its sector, together
+ *  with the updates written after it. If the stored table does not
+ *  describe the region, flash_crc_table_build() must be called before
+ *  reading.
+ *
+ * Parameters:
+ *  obj - table object.
+ *  mem - serial memory object.
+ *  base - start of the protected region.
+ *  size - size of the region, a multiple of granule_size.
+ *  granule_size - bytes per CRC, typically one page or a few.
+ *  table_addr - start of the sector holding the table, outside the region.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash read, or CY_SMIF_BAD_PARAM if the
+ *  geometry is not supported
+ *
+ ******************************************************************************/
+cy_rslt_t flash_crc_table_init(flash_crc_table_t *obj, mtb_serial_memory_t *mem,
+                                uint32_t base, uint32_t size,
+                                uint32_t granule_size, uint32_t table_addr)
+{
+    uint32_t sector_size =
+        (uint32_t)mtb_serial_memory_get_erase_size(mem, table_addr);
+    cy_rslt_t result;
+
+    if ((0U == granule_size) || (0U == size) || (0U != (size % granule_size)) ||
+        ((size / granule_size) > FLASH_CRC_TABLE_MAX_ENTRIES) ||
+        (0U == sector_size) || (0U != (table_addr % sector_size)) ||
+        (sector_size < (UPDATE_START + UPDATE_SIZE)) ||
+        ((table_addr < (base + size)) && ((table_addr + sector_size) > base)))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    memset(obj, 0, sizeof(*obj));
+    obj->mem = mem;
+    obj->base = base;
+    obj->size = size;
+    obj->granule_size = granule_size;
+    obj->table_addr = table_addr;
+    obj->sector_size = sector_size;
+
+    result = mtb_serial_memory_read(mem, table_addr, sizeof(obj->image),
+                                    (uint8_t *)&obj->image);
+
+    obj->valid = (CY_RSLT_SUCCESS == result) &&
+                    (TABLE_MAGIC == obj->image.magic) &&
+                    (granule_size == obj->image.granule_size) &&
+                    ((size / granule_size) == obj->image.entry_count) &&
+                    (image_check(obj) == obj->image.check);
+
+    if (obj->valid)
+    {
+        result = load_updates(obj);
+        obj->valid = (CY_RSLT_SUCCESS == result);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_crc_table_build
+ *******************************************************************************
+ *
+ * Summary:
+ *  Computes the CRC of every granule from the current content of the region
+ *  and stores the table. Call it once for a region programmed by other
+ *  means; later writes go through flash_crc_table_write(), which keeps the
+ *  table up to date without reading the region again.
+ *
+ * Parameters:
+ *  obj - table object.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+cy_rslt_t flash_crc_table_build(flash_crc_table_t *obj)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t count = obj->size / obj->granule_size;
+
+    obj->valid = false;
+
+    for (uint32_t index = 0U; (index < count) &&
+        (CY_RSLT_SUCCESS == result); index++)
+    {
+        result = read_granule(obj, index, 0U, 0U, NULL,
+                                &obj->image.crc[index]);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = store_image(obj);
+    }
+
+    obj->valid = (CY_RSLT_SUCCESS == result);
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_crc_table_read
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads from the region and checks every granule the range touches. A
+ *  granule at either end of the range is read whole so that its CRC can be
+ *  checked.
+ *
+ * Parameters:
+ *  obj - table object.
+ *  address - start of the range, within the region.
+ *  size - size of the range.
+ *  buf - receives the data.
+ *  bad_granules - receives the number of granules whose CRC did not match.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash reads, or CY_SMIF_BAD_PARAM if the range
+ *  is outside the region or the table is not valid
+ *
+ ******************************************************************************/
+cy_rslt_t flash_crc_table_read(flash_crc_table_t *obj, uint32_t address,
+                                uint32_t size, uint8_t *buf,
+                                uint32_t *bad_granules)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t end = address + size;
+    uint32_t index;
+    uint32_t last;
+
+    *bad_granules = 0U;
+
+    if (!obj->valid || (0U == size) || (address < obj->base) ||
+        (size > (obj->base + obj->size - address)))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    index = (address - obj->base) / obj->granule_size;
+    last = (end - 1U - obj->base) / obj->granule_size;
+
+    for (; (index <= last) && (CY_RSLT_SUCCESS == result); index++)
+    {
+        uint32_t crc;
+
+        result = read_granule(obj, index, address, end, buf, &crc);
+        obj->stats.granules_checked++;
+
+        if (crc != obj->image.crc[index])
+        {
+            obj->stats.crc_errors++;
+            (*bad_granules)++;
+        }
+    }
+
+    obj->stats.reads++;
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_crc_table_write
+ *******************************************************************************
+ *
+ * Summary:
+ *  Programs a range of the region and stores the new CRC of every granule
+ *  it touches as an update record. The CRC of a granule the range covers
+ *  whole is computed from the data; a granule covered in part is read back
+ *  after programming. The data is programmed before its CRC is stored, so
+ *  a reset in between leaves the granule reading back as bad rather than
+ *  silently wrong. As for any program operation, the range must be erased.
+ *
+ * Parameters:
+ *  obj - table object.
+ *  address - start of the range, within the region.
+ *  size - size of the range.
+ *  data - data to program.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations, or CY_SMIF_BAD_PARAM if the
+ *  range is outside the region or the table is not valid
+ *
+ ******************************************************************************/
+cy_rslt_t flash_crc_table_write(flash_crc_table_t *obj, uint32_t address,
+                                uint32_t size, const uint8_t *data)
+{
+    cy_rslt_t result;
+    uint32_t end = address + size;
+    uint32_t index;
+    uint32_t last;
+
+    if (!obj->valid || (0U == size) || (address < obj->base) ||
+        (size > (obj->base + obj->size - address)))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    result = mtb_serial_memory_write(obj->mem, address, size, data);
+    index = (address - obj->base) / obj->granule_size;
+    last = (end - 1U - obj->base) / obj->granule_size;
+
+    for (; (index <= last) && (CY_RSLT_SUCCESS == result); index++)
+    {
+        uint32_t start = obj->base + (index * obj->granule_size);
+        uint32_t crc;
+
+        if ((start >= address) && ((start + obj->granule_size) <= end))
+        {
+            crc = crc32(&data[start - address], obj->granule_size);
+        }
+        else
+        {
+            result = read_granule(obj, index, 0U, 0U, NULL, &crc);
+        }
+
+        if ((CY_RSLT_SUCCESS == result) && (crc != obj->image.crc[index]))
+        {
+            result = append_update(obj, index, crc);
+        }
+    }
+
+    obj->stats.writes++;
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        obj->valid = false;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_crc_table_is_valid
+ *******************************************************************************
+ *
+ * Summary:
+ *  Checks whether the table describes the region and reads can be checked.
+ *
+ * Parameters:
+ *  obj - table object.
+ *
+ * Return:
+ *  bool - true if the table was loaded or built, and no write to it failed
+ *
+ ******************************************************************************/
+bool flash_crc_table_is_valid(const flash_crc_table_t *obj)
+{
+    return obj->valid;
+}
+
+/* [] END OF FILE */
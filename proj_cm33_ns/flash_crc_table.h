@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * File Name        : flash_crc_table.h
+ *
+ * Description      : This file is the public interface of flash_crc_table.c,
+ *                    a side table of per-granule CRCs checked on every read.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_CRC_TABLE_H_
+#define _FLASH_CRC_TABLE_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "mtb_serial_memory.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Granules protected by one table; one 32-bit CRC each */
+#ifndef FLASH_CRC_TABLE_MAX_ENTRIES
+#define FLASH_CRC_TABLE_MAX_ENTRIES         (64U)
+#endif
+
+/* The unrequested part of a granule is read through a buffer of this size
+ * to check its CRC.
+ */
+#ifndef FLASH_CRC_TABLE_CHUNK_SIZE
+#define FLASH_CRC_TABLE_CHUNK_SIZE          (64U)
+#endif
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+/* Image of the table at the start of its flash sector */
+typedef struct
+{
+    uint32_t    magic;
+    uint32_t    granule_size;
+    uint32_t    entry_count;
+    uint32_t    check;              /* CRC-32 of the entries */
+    uint32_t    crc[FLASH_CRC_TABLE_MAX_ENTRIES];
+} flash_crc_table_image_t;
+
+/* New CRC of one granule, appended after the image by
+ * flash_crc_table_write(). Records are applied in order when the table is
+ * loaded; an erased record ends the list.
+ */
+typedef struct
+{
+    uint32_t    magic;
+    uint32_t    index;              /* Granule */
+    uint32_t    crc;
+    uint32_t    check;              /* CRC-32 of index and crc */
+} flash_crc_table_update_t;
+
+typedef struct
+{
+    uint32_t    reads;
+    uint32_t    granules_checked;
+    uint32_t    crc_errors;
+    uint32_t    extra_bytes;        /* Read only to complete a granule */
+    uint32_t    writes;
+    uint32_t    updates;            /* Update records appended */
+    uint32_t    compactions;        /* Table rewritten, sector full */
+} flash_crc_table_stats_t;
+
+typedef struct
+{
+    mtb_serial_memory_t     *mem;
+    uint32_t                base;
+    uint32_t                size;
+    uint32_t                granule_size;
+    uint32_t                table_addr;
+    uint32_t                sector_size;
+    uint32_t                next_update;    /* Sector offset of a free record */
+    bool                    valid;      /* Image matches the region */
+    flash_crc_table_image_t image;
+    uint8_t                 chunk[FLASH_CRC_TABLE_CHUNK_SIZE];
+    flash_crc_table_stats_t stats;
+} flash_crc_table_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+cy_rslt_t flash_crc_table_init(flash_crc_table_t *obj, mtb_serial_memory_t *mem,
+                                uint32_t base, uint32_t size,
+                                uint32_t granule_size, uint32_t table_addr);
+cy_rslt_t flash_crc_table_build(flash_crc_table_t *obj);
+cy_rslt_t flash_crc_table_read(flash_crc_table_t *obj, uint32_t address,
+                                uint32_t size, uint8_t *buf,
+                                uint32_t *bad_granules);
+cy_rslt_t flash_crc_table_write(flash_crc_table_t *obj, uint32_t address,
+                                uint32_t size, const uint8_t *data);
+bool flash_crc_table_is_valid(const flash_crc_table_t *obj);
+
+#endif /* _FLASH_CRC_TABLE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,371 @@
+/*******************************************************************************
+ * File Name        : flash_dpd.c
+ *
+ * Description      : This file manages deep power-down of the memory. The
+ *                    memory is powered down once it has been idle for the
+ *                    current timeout and released before the next access. To
+ *                    avoid thrashing, the timeout doubles after each
+ *                    deep power-down that was shorter than the break-even time
+ *                    and shrinks slowly after each one that was longer.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_dpd.h"
+#include "perf_counter.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* The timeout shrinks by a quarter after a deep power-down that paid off */
+#define TIMEOUT_DECREASE_SHIFT              (2U)
+
+#define USEC_PER_MSEC                       (1000U)
+#define MSEC_PER_SEC                        (1000U)
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: send_command
+ *******************************************************************************
+ *
+ * Summary:
+ *  Sends an opcode-only command and waits for the memory to settle.
+ *
+ * Parameters:
+ *  obj - deep power-down object.
+ *  opcode - command opcode.
+ *  settle_us - time the memory needs to complete the command.
+ *
+ * Return:
+ *  cy_en_smif_status_t - status of the operation
+ *
+ ******************************************************************************/
+static cy_en_smif_status_t send_command(flash_dpd_t *obj, uint8_t opcode,
+                                        uint32_t settle_us)
+{
+    cy_en_smif_status_t status;
+
+    flash_cmd_begin(obj->cmd);
+    status = flash_cmd_send(obj->cmd, opcode);
+    flash_cmd_end(obj->cmd);
+
+    flash_cmd_delay_us(obj->cmd, settle_us);
+
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: flash_dpd_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Initializes deep power-down management. A memory the CPU executes from
+ *  must not be powered down, so memory-mapped memories are refused.
+ *
+ * Parameters:
+ *  obj - deep power-down object to initialize.
+ *  cmd - raw command interface of the memory.
+ *  now_ms - current time in milliseconds.
+ *
+ * Return:
+ *  cy_en_smif_status_t - CY_SMIF_BAD_PARAM if the memory is memory-mapped
+ *
+ ******************************************************************************/
+cy_en_smif_status_t flash_dpd_init(flash_dpd_t *obj, flash_cmd_t *cmd,
+                                    uint32_t now_ms)
+{
+    obj->cmd = cmd;
+    obj->powered_down = false;
+    obj->timeout_ms = FLASH_DPD_IDLE_TIMEOUT_MS;
+    obj->last_access_ms = now_ms;
+    obj->entered_ms = now_ms;
+    memset(&obj->stats, 0, sizeof(obj->stats));
+
+    perf_counter_init();
+
+    return (0U != (cmd->mem_config->flags & CY_SMIF_FLAG_MEMORY_MAPPED)) ?
+            CY_SMIF_BAD_PARAM : CY_SMIF_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: flash_dpd_access
+ *******************************************************************************
+ *
+ * Summary:
+ *  Must be called before each access to the memory; the read, write and
+ *  erase wrappers do so. Releases the memory from deep power-down if
+ *  needed, records the wake latency and adapts the idle timeout.
+ *
+ * Parameters:
+ *  obj - deep power-down object.
+ *  now_ms - current time in milliseconds.
+ *
+ * Return:
+ *  cy_en_smif_status_t - status of the release command
+ *
+ ******************************************************************************/
+cy_en_smif_status_t flash_dpd_access(flash_dpd_t *obj, uint32_t now_ms)
+{
+    cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+    uint32_t start;
+    uint32_t wake_usec;
+    uint32_t dpd_ms;
+
+    if (obj->powered_down)
+    {
+        start = perf_counter_get();
+        status = send_command(obj, FLASH_CMD_RELEASE_POWER_DOWN,
+                                FLASH_DPD_RELEASE_US);
+        wake_usec = (uint32_t)perf_counter_cycles_to_usec(perf_counter_get() -
+                                                            start);
+
+        obj->powered_down = false;
+        dpd_ms = now_ms - obj->entered_ms;
+
+        obj->stats.wakes++;
+        obj->stats.wake_usec_total += wake_usec;
+        obj->stats.wake_usec_max = (wake_usec > obj->stats.wake_usec_max) ?
+                                    wake_usec : obj->stats.wake_usec_max;
+        obj->stats.dpd_ms_total += dpd_ms;
+
+        if (FLASH_DPD_BREAK_EVEN_MS > dpd_ms)
+        {
+            obj->stats.short_sleeps++;
+            obj->timeout_ms *= 2U;
+            obj->timeout_ms = (obj->timeout_ms > FLASH_DPD_MAX_TIMEOUT_MS) ?
+                                FLASH_DPD_MAX_TIMEOUT_MS : obj->timeout_ms;
+        }
+        else
+        {
+            obj->timeout_ms -= obj->timeout_ms >> TIMEOUT_DECREASE_SHIFT;
+            obj->timeout_ms = (obj->timeout_ms < FLASH_DPD_MIN_TIMEOUT_MS) ?
+                                FLASH_DPD_MIN_TIMEOUT_MS : obj->timeout_ms;
+        }
+    }
+
+    obj->last_access_ms = now_ms;
+
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: flash_dpd_read
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads from the memory through flash_dpd_access(), so that a powered-down
+ *  memory is released first. Flash paths that run while deep power-down is
+ *  managed use this and the write and erase wrappers below instead of the
+ *  serial-memory functions.
+ *
+ * Parameters:
+ *  obj - deep power-down object.
+ *  mem - serial memory object of the memory.
+ *  addr - address to read from.
+ *  length - number of bytes to read.
+ *  buf - receives the data.
+ *  now_ms - current time in milliseconds.
+ *
+ * Return:
+ *  cy_rslt_t - status of the release command or result of the read
+ *
+ ******************************************************************************/
+cy_rslt_t flash_dpd_read(flash_dpd_t *obj, mtb_serial_memory_t *mem,
+                        uint32_t addr, size_t length, uint8_t *buf,
+                        uint32_t now_ms)
+{
+    cy_en_smif_status_t status = flash_dpd_access(obj, now_ms);
+
+    if (CY_SMIF_SUCCESS != status)
+    {
+        return (cy_rslt_t)status;
+    }
+
+    return mtb_serial_memory_read(mem, addr, length, buf);
+}
+
+/*******************************************************************************
+ * Function Name: flash_dpd_write
+ *******************************************************************************
+ *
+ * Summary:
+ *  Programs the memory through flash_dpd_access().
+ *
+ * Parameters:
+ *  obj - deep power-down object.
+ *  mem - serial memory object of the memory.
+ *  addr - address to program.
+ *  length - number of bytes to program.
+ *  buf - data to program.
+ *  now_ms - current time in milliseconds.
+ *
+ * Return:
+ *  cy_rslt_t - status of the release command or result of the write
+ *
+ ******************************************************************************/
+cy_rslt_t flash_dpd_write(flash_dpd_t *obj, mtb_serial_memory_t *mem,
+                            uint32_t addr, size_t length, const uint8_t *buf,
+                            uint32_t now_ms)
+{
+    cy_en_smif_status_t status = flash_dpd_access(obj, now_ms);
+
+    if (CY_SMIF_SUCCESS != status)
+    {
+        return (cy_rslt_t)status;
+    }
+
+    return mtb_serial_memory_write(mem, addr, length, buf);
+}
+
+/*******************************************************************************
+ * Function Name: flash_dpd_erase
+ *******************************************************************************
+ *
+ * Summary:
+ *  Erases the memory through flash_dpd_access().
+ *
+ * Parameters:
+ *  obj - deep power-down object.
+ *  mem - serial memory object of the memory.
+ *  addr - start of the sectors to erase.
+ *  length - number of bytes to erase, whole sectors.
+ *  now_ms - current time in milliseconds.
+ *
+ * Return:
+ *  cy_rslt_t - status of the release command or result of the erase
+ *
+ ******************************************************************************/
+cy_rslt_t flash_dpd_erase(flash_dpd_t *obj, mtb_serial_memory_t *mem,
+                            uint32_t addr, size_t length, uint32_t now_ms)
+{
+    cy_en_smif_status_t status = flash_dpd_access(obj, now_ms);
+
+    if (CY_SMIF_SUCCESS != status)
+    {
+        return (cy_rslt_t)status;
+    }
+
+    return mtb_serial_memory_erase(mem, addr, length);
+}
+
+/*******************************************************************************
+ * Function Name: flash_dpd_poll
+ *******************************************************************************
+ *
+ * Summary:
+ *  Must be called periodically while the memory is idle. Puts the memory in
+ *  deep power-down once it has been idle for the current timeout.
+ *
+ * Parameters:
+ *  obj - deep power-down object.
+ *  now_ms - current time in milliseconds.
+ *
+ * Return:
+ *  cy_en_smif_status_t - status of the deep power-down command
+ *
+ ******************************************************************************/
+cy_en_smif_status_t flash_dpd_poll(flash_dpd_t *obj, uint32_t now_ms)
+{
+    cy_en_smif_status_t status = CY_SMIF_SUCCESS;
+
+    if (!obj->powered_down && (now_ms - obj->last_access_ms >= obj->timeout_ms))
+    {
+        status = send_command(obj, FLASH_CMD_DEEP_POWER_DOWN,
+                                FLASH_DPD_ENTER_US);
+
+        if (CY_SMIF_SUCCESS == status)
+        {
+            obj->powered_down = true;
+            obj->entered_ms = now_ms;
+            obj->stats.entries++;
+        }
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: flash_dpd_is_powered_down
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns whether the memory is in deep power-down.
+ *
+ * Parameters:
+ *  obj - deep power-down object.
+ *
+ * Return:
+ *  bool - true if the memory is in deep power-down
+ *
+ ******************************************************************************/
+bool flash_dpd_is_powered_down(const flash_dpd_t *obj)
+{
+    return obj->powered_down;
+}
+
+/*******************************************************************************
+ * Function Name: flash_dpd_print_stats
+ *******************************************************************************
+ *
+ * Summary:
+ *  Prints the wake latency against the time spent in deep power-down.
+ *
+ * Parameters:
+ *  obj - deep power-down object.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_dpd_print_stats(const flash_dpd_t *obj)
+{
+    const flash_dpd_stats_t *stats = &obj->stats;
+
+    printf("\r\nDeep power-down: %"PRIu32" entries, %"PRIu32" wakes, "
+            "%"PRIu32" below break-even (%"PRIu32" ms)\r\n",
+            stats->entries, stats->wakes, stats->short_sleeps,
+            (uint32_t)FLASH_DPD_BREAK_EVEN_MS);
+    /* newlib-nano's printf() has no 64-bit conversions: the totals are
+     * scaled to ms and s, which fit 32 bits for decades of uptime.
+     */
+    printf("Wake latency: total %"PRIu32" ms, max %"PRIu32" us; "
+            "time powered down %"PRIu32" s; timeout now %"PRIu32" ms\r\n",
+            (uint32_t)(stats->wake_usec_total / USEC_PER_MSEC),
+            stats->wake_usec_max,
+            (uint32_t)(stats->dpd_ms_total / MSEC_PER_SEC), obj->timeout_ms);
+}
+
+/* [] END OF FILE */
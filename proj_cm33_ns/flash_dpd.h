@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * File Name        : flash_dpd.h
+ *
+ * Description      : This file is the public interface of flash_dpd.c which
+ *                    puts the memory in deep power-down after an idle period
+ *                    and wakes it up transparently on the next access.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_DPD_H_
+#define _FLASH_DPD_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "mtb_serial_memory.h"
+#include "flash_cmd.h"
+#include "flash_energy.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Set to 1U to power down the memory while main() idles in the LED loop */
+#ifndef FLASH_DPD_ENABLE
+#define FLASH_DPD_ENABLE                    (0U)
+#endif
+
+/* Idle time before deep power-down; adapted at run time between the limits */
+#ifndef FLASH_DPD_IDLE_TIMEOUT_MS
+#define FLASH_DPD_IDLE_TIMEOUT_MS           (100U)
+#endif
+#define FLASH_DPD_MIN_TIMEOUT_MS            (10U)
+#define FLASH_DPD_MAX_TIMEOUT_MS            (10000U)
+
+/* tDP and tRES1 of the memory; check the datasheet of the part */
+#define FLASH_DPD_ENTER_US                  (3U)
+#define FLASH_DPD_RELEASE_US                (30U)
+
+/* Shortest deep power-down that saves energy: the charge drawn during
+ * release at read current, divided by the standby to deep power-down
+ * current difference.
+ */
+#define FLASH_DPD_BREAK_EVEN_MS             ((FLASH_DPD_RELEASE_US * \
+                                        FLASH_ENERGY_DEFAULT_READ_UA) / \
+                                        ((FLASH_ENERGY_DEFAULT_STANDBY_UA - \
+                                        FLASH_ENERGY_DEFAULT_DPD_UA) * 1000U))
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t    entries;
+    uint32_t    wakes;
+    uint32_t    short_sleeps;       /* Deep power-downs below break-even */
+    uint64_t    wake_usec_total;
+    uint32_t    wake_usec_max;
+    uint64_t    dpd_ms_total;
+} flash_dpd_stats_t;
+
+typedef struct
+{
+    flash_cmd_t         *cmd;
+    bool                powered_down;
+    uint32_t            timeout_ms;
+    uint32_t            last_access_ms;
+    uint32_t            entered_ms;
+    flash_dpd_stats_t   stats;
+} flash_dpd_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+cy_en_smif_status_t flash_dpd_init(flash_dpd_t *obj, flash_cmd_t *cmd,
+                                    uint32_t now_ms);
+cy_en_smif_status_t flash_dpd_access(flash_dpd_t *obj, uint32_t now_ms);
+cy_rslt_t flash_dpd_read(flash_dpd_t *obj, mtb_serial_memory_t *mem,
+                        uint32_t addr, size_t length, uint8_t *buf,
+                        uint32_t now_ms);
+cy_rslt_t flash_dpd_write(flash_dpd_t *obj, mtb_serial_memory_t *mem,
+                            uint32_t addr, size_t length, const uint8_t *buf,
+                            uint32_t now_ms);
+cy_rslt_t flash_dpd_erase(flash_dpd_t *obj, mtb_serial_memory_t *mem,
+                            uint32_t addr, size_t length, uint32_t now_ms);
+cy_en_smif_status_t flash_dpd_poll(flash_dpd_t *obj, uint32_t now_ms);
+bool flash_dpd_is_powered_down(const flash_dpd_t *obj);
+void flash_dpd_print_stats(const flash_dpd_t *obj);
+
+#endif /* _FLASH_DPD_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,452 @@
+/*******************************************************************************
+ * File Name        : flash_energy.c
+ *
+ * Description      : This file books the time spent in each flash operation
+ *                    against a power model of the flash and the CPU and reports
+ *                    energy per megabyte read, written and erased.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_energy.h"
+#include "perf_counter.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* mV x uA x ns gives attojoules; divide to get picojoules */
+#define AJ_PER_PJ                           (1000000U)
+#define PJ_PER_NJ                           (1000U)
+#define PJ_PER_UJ                           (1000000U)
+#define NJ_PER_UJ                           (1000U)
+#define BYTES_PER_MB                        (1048576U)
+#define NSEC_PER_USEC                       (1000U)
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+/* Operations of one type and the CPU cycles spent on them in each CPU state;
+ * the cycles are converted to time and energy only when a report is made.
+ */
+typedef struct
+{
+    uint32_t ops;
+    uint64_t bytes;
+    uint64_t cycles[FLASH_ENERGY_CPU_STATE_COUNT];
+} energy_totals_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static flash_energy_model_t energy_model =
+{
+    .vcc_mv         = FLASH_ENERGY_DEFAULT_VCC_MV,
+    .read_ua        = FLASH_ENERGY_DEFAULT_READ_UA,
+    .program_ua     = FLASH_ENERGY_DEFAULT_PROGRAM_UA,
+    .erase_ua       = FLASH_ENERGY_DEFAULT_ERASE_UA,
+    .standby_ua     = FLASH_ENERGY_DEFAULT_STANDBY_UA,
+    .dpd_ua         = FLASH_ENERGY_DEFAULT_DPD_UA,
+    .cpu_active_ua  = FLASH_ENERGY_DEFAULT_CPU_ACTIVE_UA,
+    .cpu_sleep_ua   = FLASH_ENERGY_DEFAULT_CPU_SLEEP_UA
+};
+
+static energy_totals_t energy_totals[FLASH_ENERGY_OP_COUNT];
+static uint64_t idle_energy_pj;
+static uint32_t op_start_cycles;
+
+static const char *const op_names[FLASH_ENERGY_OP_COUNT] =
+{
+    "Read", "Write", "Erase"
+};
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: energy_pj
+ *******************************************************************************
+ *
+ * Summary:
+ *  Computes the energy drawn by a load over a period of time.
+ *
+ * Parameters:
+ *  current_ua - current drawn by the load in microamperes.
+ *  nsec - duration in nanoseconds.
+ *
+ * Return:
+ *  uint64_t - energy in picojoules
+ *
+ ******************************************************************************/
+static uint64_t energy_pj(uint32_t current_ua, uint64_t nsec)
+{
+    uint64_t power = (uint64_t)energy_model.vcc_mv * current_ua;
+
+    /* Split the duration so the product cannot overflow for long runs */
+    return (power * (nsec / AJ_PER_PJ)) +
+            ((power * (nsec % AJ_PER_PJ)) / AJ_PER_PJ);
+}
+
+/*******************************************************************************
+ * Function Name: cpu_current_ua
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the CPU current for the given CPU state.
+ *
+ * Parameters:
+ *  cpu_state - state of the CPU.
+ *
+ * Return:
+ *  uint32_t - current in microamperes
+ *
+ ******************************************************************************/
+static uint32_t cpu_current_ua(flash_energy_cpu_state_t cpu_state)
+{
+    return (FLASH_ENERGY_CPU_SLEEP == cpu_state) ? energy_model.cpu_sleep_ua :
+                                                    energy_model.cpu_active_ua;
+}
+
+/*******************************************************************************
+ * Function Name: flash_current_ua
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the flash current for the given operation type.
+ *
+ * Parameters:
+ *  op - type of the flash operation.
+ *
+ * Return:
+ *  uint32_t - current in microamperes
+ *
+ ******************************************************************************/
+static uint32_t flash_current_ua(flash_energy_op_t op)
+{
+    uint32_t flash_ua;
+
+    switch (op)
+    {
+        case FLASH_ENERGY_OP_READ:
+            flash_ua = energy_model.read_ua;
+            break;
+        case FLASH_ENERGY_OP_WRITE:
+            flash_ua = energy_model.program_ua;
+            break;
+        default:
+            flash_ua = energy_model.erase_ua;
+            break;
+    }
+
+    return flash_ua;
+}
+
+/*******************************************************************************
+ * Function Name: to_u32
+ *******************************************************************************
+ *
+ * Summary:
+ *  Narrows a statistic for printing. The printf() of newlib-nano has no
+ *  64-bit conversions, so values are printed as 32 bits, saturated.
+ *
+ * Parameters:
+ *  value - value to narrow.
+ *
+ * Return:
+ *  uint32_t - value, or UINT32_MAX if it does not fit
+ *
+ ******************************************************************************/
+static uint32_t to_u32(uint64_t value)
+{
+    return (value > UINT32_MAX) ? UINT32_MAX : (uint32_t)value;
+}
+
+/*******************************************************************************
+ * Function Name: flash_energy_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts the cycle counter, loads the power model and clears the statistics.
+ *
+ * Parameters:
+ *  model - power model to use, or NULL to keep the default model.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_energy_init(const flash_energy_model_t *model)
+{
+    if (NULL != model)
+    {
+        energy_model = *model;
+    }
+
+    perf_counter_init();
+    flash_energy_reset();
+}
+
+/*******************************************************************************
+ * Function Name: flash_energy_reset
+ *******************************************************************************
+ *
+ * Summary:
+ *  Clears the accumulated statistics of all operations.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_energy_reset(void)
+{
+    memset(energy_totals, 0, sizeof(energy_totals));
+    idle_energy_pj = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: flash_energy_begin
+ *******************************************************************************
+ *
+ * Summary:
+ *  Marks the start of a flash operation.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_energy_begin(void)
+{
+    op_start_cycles = perf_counter_get();
+}
+
+/*******************************************************************************
+ * Function Name: flash_energy_end
+ *******************************************************************************
+ *
+ * Summary:
+ *  Marks the end of the flash operation started by flash_energy_begin() and
+ *  books its duration in CPU cycles against the operation type. The cycles
+ *  are only converted to time and energy when a report is made, so short
+ *  operations are not rounded one by one.
+ *
+ * Parameters:
+ *  op - type of the flash operation.
+ *  bytes - number of bytes read, written or erased.
+ *  cpu_state - state of the CPU while waiting for the operation.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_energy_end(flash_energy_op_t op, uint32_t bytes,
+                        flash_energy_cpu_state_t cpu_state)
+{
+    energy_totals_t *totals = &energy_totals[op];
+
+    totals->ops++;
+    totals->bytes += bytes;
+    totals->cycles[cpu_state] += perf_counter_get() - op_start_cycles;
+}
+
+/*******************************************************************************
+ * Function Name: flash_energy_add_idle
+ *******************************************************************************
+ *
+ * Summary:
+ *  Books a period in which no flash operation is in progress, e.g. the time
+ *  between two bursts of operations.
+ *
+ * Parameters:
+ *  usec - duration of the idle period in microseconds.
+ *  idle_state - state of the flash during the idle period.
+ *  cpu_state - state of the CPU during the idle period.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_energy_add_idle(uint32_t usec, flash_energy_idle_state_t idle_state,
+                            flash_energy_cpu_state_t cpu_state)
+{
+    uint32_t flash_ua = (FLASH_ENERGY_IDLE_DEEP_POWER_DOWN == idle_state) ?
+                            energy_model.dpd_ua : energy_model.standby_ua;
+
+    uint64_t nsec = (uint64_t)usec * NSEC_PER_USEC;
+
+    idle_energy_pj += energy_pj(flash_ua, nsec) +
+                        energy_pj(cpu_current_ua(cpu_state), nsec);
+}
+
+/*******************************************************************************
+ * Function Name: flash_energy_get_report
+ *******************************************************************************
+ *
+ * Summary:
+ *  Converts the cycles booked against one operation type to time and
+ *  energy.
+ *
+ * Parameters:
+ *  op - type of the flash operation.
+ *  report - destination of the statistics.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_energy_get_report(flash_energy_op_t op,
+                            flash_energy_report_t *report)
+{
+    const energy_totals_t *totals = &energy_totals[op];
+    uint64_t nsec;
+
+    report->ops = totals->ops;
+    report->bytes = totals->bytes;
+    report->flash_energy_pj = 0U;
+    report->cpu_energy_pj = 0U;
+
+    for (uint32_t state = 0U;
+        state < (uint32_t)FLASH_ENERGY_CPU_STATE_COUNT; state++)
+    {
+        nsec = perf_counter_cycles_to_nsec(totals->cycles[state]);
+        report->cpu_nsec[state] = nsec;
+        report->flash_energy_pj += energy_pj(flash_current_ua(op), nsec);
+        report->cpu_energy_pj +=
+            energy_pj(cpu_current_ua((flash_energy_cpu_state_t)state), nsec);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: flash_energy_get_idle_pj
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the energy booked through flash_energy_add_idle().
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint64_t - idle energy in picojoules
+ *
+ ******************************************************************************/
+uint64_t flash_energy_get_idle_pj(void)
+{
+    return idle_energy_pj;
+}
+
+/*******************************************************************************
+ * Function Name: flash_energy_per_mb_uj
+ *******************************************************************************
+ *
+ * Summary:
+ *  Computes the flash plus CPU energy per megabyte of a report.
+ *
+ * Parameters:
+ *  report - statistics of one operation type.
+ *
+ * Return:
+ *  uint64_t - energy in microjoules per megabyte, 0 if no bytes were booked
+ *
+ ******************************************************************************/
+uint64_t flash_energy_per_mb_uj(const flash_energy_report_t *report)
+{
+    uint64_t total_pj = report->flash_energy_pj + report->cpu_energy_pj;
+
+    if (0U == report->bytes)
+    {
+        return 0U;
+    }
+
+    return ((total_pj / report->bytes) * BYTES_PER_MB +
+            ((total_pj % report->bytes) * BYTES_PER_MB) / report->bytes) /
+            PJ_PER_UJ;
+}
+
+/*******************************************************************************
+ * Function Name: flash_energy_print_report
+ *******************************************************************************
+ *
+ * Summary:
+ *  Prints the statistics of all operation types to the UART console. Energy
+ *  is printed in microjoules with three decimals, so it stays exact to the
+ *  nanojoule in 32-bit printf() conversions.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_energy_print_report(void)
+{
+    flash_energy_report_t report;
+    uint64_t flash_nj;
+    uint64_t cpu_nj;
+
+    printf("\r\nFlash energy report (Vcc %"PRIu32" mV):\r\n",
+            energy_model.vcc_mv);
+    printf("-------------------------\r\n");
+
+    for (uint32_t op = 0U; op < (uint32_t)FLASH_ENERGY_OP_COUNT; op++)
+    {
+        flash_energy_get_report((flash_energy_op_t)op, &report);
+        flash_nj = report.flash_energy_pj / PJ_PER_NJ;
+        cpu_nj = report.cpu_energy_pj / PJ_PER_NJ;
+
+        printf("%-6s: %"PRIu32" ops, %"PRIu32" bytes, spin %"PRIu32" us, "
+                "sleep %"PRIu32" us, flash %"PRIu32".%03"PRIu32" uJ, "
+                "CPU %"PRIu32".%03"PRIu32" uJ, %"PRIu32" uJ/MB\r\n",
+                op_names[op], report.ops, to_u32(report.bytes),
+                to_u32(report.cpu_nsec[FLASH_ENERGY_CPU_ACTIVE] /
+                        NSEC_PER_USEC),
+                to_u32(report.cpu_nsec[FLASH_ENERGY_CPU_SLEEP] /
+                        NSEC_PER_USEC),
+                to_u32(flash_nj / NJ_PER_UJ),
+                (uint32_t)(flash_nj % NJ_PER_UJ),
+                to_u32(cpu_nj / NJ_PER_UJ), (uint32_t)(cpu_nj % NJ_PER_UJ),
+                to_u32(flash_energy_per_mb_uj(&report)));
+    }
+
+    printf("Idle  : %"PRIu32".%03"PRIu32" uJ\r\n",
+            to_u32(idle_energy_pj / PJ_PER_UJ),
+            (uint32_t)((idle_energy_pj / PJ_PER_NJ) % NJ_PER_UJ));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * File Name        : flash_energy.h
+ *
+ * Description      : This file is the public interface of flash_energy.c which
+ *                    correlates flash operations with a power model to report
+ *                    the energy spent per byte read, written and erased.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_ENERGY_H_
+#define _FLASH_ENERGY_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Set to 1U to instrument the flash operations in main() */
+#ifndef FLASH_ENERGY_MEASUREMENT_ENABLE
+#define FLASH_ENERGY_MEASUREMENT_ENABLE     (0U)
+#endif
+
+/* Default power model. Typical values for a 1.8 V quad SPI NOR flash and the
+ * CM33 running from the 200 MHz clock; update them from the datasheet of the
+ * part in use or from measurements taken on the board.
+ */
+#define FLASH_ENERGY_DEFAULT_VCC_MV         (1800U)
+#define FLASH_ENERGY_DEFAULT_READ_UA        (60000U)
+#define FLASH_ENERGY_DEFAULT_PROGRAM_UA     (60000U)
+#define FLASH_ENERGY_DEFAULT_ERASE_UA       (60000U)
+#define FLASH_ENERGY_DEFAULT_STANDBY_UA     (25U)
+#define FLASH_ENERGY_DEFAULT_DPD_UA         (2U)
+#define FLASH_ENERGY_DEFAULT_CPU_ACTIVE_UA  (18000U)
+#define FLASH_ENERGY_DEFAULT_CPU_SLEEP_UA   (3000U)
+
+#if (FLASH_ENERGY_MEASUREMENT_ENABLE)
+#define FLASH_ENERGY_BEGIN()                flash_energy_begin()
+#define FLASH_ENERGY_END(op, bytes)         flash_energy_end((op), (bytes), \
+                                                FLASH_ENERGY_CPU_ACTIVE)
+#else
+#define FLASH_ENERGY_BEGIN()                ((void)0)
+#define FLASH_ENERGY_END(op, bytes)         ((void)0)
+#endif /* (FLASH_ENERGY_MEASUREMENT_ENABLE) */
+
+/*******************************************************************************
+ * Enumerations
+ ******************************************************************************/
+/* Flash operation the energy is booked against */
+typedef enum
+{
+    FLASH_ENERGY_OP_READ,
+    FLASH_ENERGY_OP_WRITE,
+    FLASH_ENERGY_OP_ERASE,
+    FLASH_ENERGY_OP_COUNT
+} flash_energy_op_t;
+
+/* State of the CPU while the flash operation is in progress */
+typedef enum
+{
+    FLASH_ENERGY_CPU_ACTIVE,    /* Spin-waiting on the flash status */
+    FLASH_ENERGY_CPU_SLEEP,     /* Sleeping between status polls */
+    FLASH_ENERGY_CPU_STATE_COUNT
+} flash_energy_cpu_state_t;
+
+/* State of the flash while no operation is in progress */
+typedef enum
+{
+    FLASH_ENERGY_IDLE_STANDBY,
+    FLASH_ENERGY_IDLE_DEEP_POWER_DOWN
+} flash_energy_idle_state_t;
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+/* Supply voltage and currents of the flash and the CPU */
+typedef struct
+{
+    uint32_t vcc_mv;
+    uint32_t read_ua;
+    uint32_t program_ua;
+    uint32_t erase_ua;
+    uint32_t standby_ua;
+    uint32_t dpd_ua;
+    uint32_t cpu_active_ua;
+    uint32_t cpu_sleep_ua;
+} flash_energy_model_t;
+
+/* Accumulated cost of one type of flash operation */
+typedef struct
+{
+    uint32_t ops;
+    uint64_t bytes;
+    uint64_t cpu_nsec[FLASH_ENERGY_CPU_STATE_COUNT];
+    uint64_t flash_energy_pj;
+    uint64_t cpu_energy_pj;
+} flash_energy_report_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void flash_energy_init(const flash_energy_model_t *model);
+void flash_energy_reset(void);
+void flash_energy_begin(void);
+void flash_energy_end(flash_energy_op_t op, uint32_t bytes,
+                        flash_energy_cpu_state_t cpu_state);
+void flash_energy_add_idle(uint32_t usec, flash_energy_idle_state_t idle_state,
+                            flash_energy_cpu_state_t cpu_state);
+void flash_energy_get_report(flash_energy_op_t op,
+                            flash_energy_report_t *report);
+uint64_t flash_energy_get_idle_pj(void);
+uint64_t flash_energy_per_mb_uj(const flash_energy_report_t *report);
+void flash_energy_print_report(void);
+
+#endif /* _FLASH_ENERGY_H_ */
+
+/* [] END OF FILE */
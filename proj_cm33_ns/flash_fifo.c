@@ -0,0 +1,815 @@
+/*******************************************************************************
+ * File Name        : flash_fifo.c
+ *
+ * Description      : This file contains a persistent FIFO of variable-length
+ *                    records in a circular partition of whole sectors.
+ *                    Records are packed into RAM pages that are programmed
+ *                    once each; the read pointer advances with one small ack
+ *                    program per dequeued batch.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_fifo.h"
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Sector layout: header page, ack slots, data pages. The header and every ack
+ * slot take one 16-byte ECC unit so that each is programmed exactly once.
+ */
+#define SECTOR_MAGIC                        (0x30464946UL)  /* "FIF0" */
+#define UNIT_SIZE                           (16U)
+#define MAGIC_OFFSET                        (0U)
+#define SEQ_OFFSET                          (UNIT_SIZE)
+#define ACK_AREA_OFFSET                     (FLASH_FIFO_PAGE_SIZE)
+#define ACK_AREA_SIZE                       (((FLASH_FIFO_ACK_SLOTS * \
+                                            UNIT_SIZE) + \
+                                            FLASH_FIFO_PAGE_SIZE - 1U) / \
+                                            FLASH_FIFO_PAGE_SIZE * \
+                                            FLASH_FIFO_PAGE_SIZE)
+
+/* The last slot only marks a sector as fully consumed */
+#define DONE_SLOT                           (FLASH_FIFO_ACK_SLOTS - 1U)
+
+#define ERASED_WORD                         (0xFFFFFFFFUL)
+#define ERASED_BYTE                         (0xFFU)
+#define RECORD_LENGTH_MASK                  (0xFFFFUL)
+#define RECORD_CHECK_SHIFT                  (16U)
+#define RECORD_ALIGN                        (4U)
+#define BYTE_SHIFT                          (8U)
+#define BYTE_MASK                           (0xFFU)
+#define WORD_SIZE                           (4U)
+
+#if (FLASH_FIFO_ACK_SLOTS < 2U)
+#error "FLASH_FIFO_ACK_SLOTS must be at least 2"
+#endif
+
+/*******************************************************************************
+ * Enumerations
+ ******************************************************************************/
+typedef enum
+{
+    UNIT_ERASED,
+    UNIT_VALID,
+    UNIT_TORN       /* Programming was interrupted */
+} unit_state_t;
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: get_le32
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads a little-endian word from a byte buffer.
+ *
+ * Parameters:
+ *  buf - first byte of the word.
+ *
+ * Return:
+ *  uint32_t - the word
+ *
+ ******************************************************************************/
+static uint32_t get_le32(const uint8_t *buf)
+{
+    uint32_t value = 0U;
+
+    for (uint32_t index = WORD_SIZE; index > 0U; index--)
+    {
+        value = (value << BYTE_SHIFT) | buf[index - 1U];
+    }
+
+    return value;
+}
+
+/*******************************************************************************
+ * Function Name: put_le32
+ *******************************************************************************
+ *
+ * Summary:
+ *  Writes a word to a byte buffer in little-endian order.
+ *
+ * Parameters:
+ *  buf - first byte of the word.
+ *  value - the word.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void put_le32(uint8_t *buf, uint32_t value)
+{
+    for (uint32_t index = 0U; index < WORD_SIZE; index++)
+    {
+        buf[index] = (uint8_t)(value & BYTE_MASK);
+        value >>= BYTE_SHIFT;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: sector_addr
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the address of a sector of the partition.
+ *
+ * Parameters:
+ *  obj - FIFO object.
+ *  sector - index of the sector.
+ *
+ * Return:
+ *  uint32_t - address of the sector
+ *
+ ******************************************************************************/
+static uint32_t sector_addr(const flash_fifo_t *obj, uint32_t sector)
+{
+    return obj->base + (sector * obj->sector_size);
+}
+
+/*******************************************************************************
+ * Function Name: read_unit
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads a header or ack unit: a value followed by its complement.
+ *
+ * Parameters:
+ *  obj - FIFO object.
+ *  address - address of the unit.
+ *  value - receives the value of a valid unit.
+ *
+ * Return:
+ *  unit_state_t - state of the unit; UNIT_TORN also on read errors
+ *
+ ******************************************************************************/
+static unit_state_t read_unit(flash_fifo_t *obj, uint32_t address,
+                                uint32_t *value)
+{
+    uint8_t unit[2U * WORD_SIZE];
+    uint32_t word;
+    uint32_t check;
+
+    if (CY_RSLT_SUCCESS != mtb_serial_memory_read(obj->mem, address,
+                                                    sizeof(unit), unit))
+    {
+        return UNIT_TORN;
+    }
+
+    word = get_le32(&unit[0U]);
+    check = get_le32(&unit[WORD_SIZE]);
+
+    if ((ERASED_WORD == word) && (ERASED_WORD == check))
+    {
+        return UNIT_ERASED;
+    }
+
+    *value = word;
+
+    return (word == ~check) ? UNIT_VALID : UNIT_TORN;
+}
+
+/*******************************************************************************
+ * Function Name: write_unit
+ *******************************************************************************
+ *
+ * Summary:
+ *  Programs a header or ack unit.
+ *
+ * Parameters:
+ *  obj - FIFO object.
+ *  address - address of the unit.
+ *  value - value to store.
+ *
+ * Return:
+ *  cy_rslt_t - result of the program operation
+ *
+ ******************************************************************************/
+static cy_rslt_t write_unit(flash_fifo_t *obj, uint32_t address,
+                            uint32_t value)
+{
+    uint8_t unit[UNIT_SIZE];
+
+    memset(unit, ERASED_BYTE, sizeof(unit));
+    put_le32(&unit[0U], value);
+    put_le32(&unit[WORD_SIZE], ~value);
+
+    return mtb_serial_memory_write(obj->mem, address, sizeof(unit), unit);
+}
+
+/*******************************************************************************
+ * Function Name: read_header
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads the sequence number of a sector in use.
+ *
+ * Parameters:
+ *  obj - FIFO object.
+ *  sector - index of the sector.
+ *  seq - receives the sequence number.
+ *
+ * Return:
+ *  bool - true if the sector holds a valid header
+ *
+ ******************************************************************************/
+static bool read_header(flash_fifo_t *obj, uint32_t sector, uint32_t *seq)
+{
+    uint32_t magic = 0U;
+
+    return (UNIT_VALID == read_unit(obj, sector_addr(obj, sector) +
+                                    MAGIC_OFFSET, &magic)) &&
+            (SECTOR_MAGIC == magic) &&
+            (UNIT_VALID == read_unit(obj, sector_addr(obj, sector) +
+                                    SEQ_OFFSET, seq));
+}
+
+/*******************************************************************************
+ * Function Name: slot_addr
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the address of an ack slot.
+ *
+ * Parameters:
+ *  obj - FIFO object.
+ *  sector - index of the sector.
+ *  slot - index of the slot.
+ *
+ * Return:
+ *  uint32_t - address of the slot
+ *
+ ******************************************************************************/
+static uint32_t slot_addr(const flash_fifo_t *obj, uint32_t sector,
+                            uint32_t slot)
+{
+    return sector_addr(obj, sector) + ACK_AREA_OFFSET + (slot * UNIT_SIZE);
+}
+
+/*******************************************************************************
+ * Function Name: is_done
+ *******************************************************************************
+ *
+ * Summary:
+ *  Checks whether a sector was marked as fully consumed.
+ *
+ * Parameters:
+ *  obj - FIFO object.
+ *  sector - index of the sector.
+ *
+ * Return:
+ *  bool - true if the sector is consumed
+ *
+ ******************************************************************************/
+static bool is_done(flash_fifo_t *obj, uint32_t sector)
+{
+    uint32_t value;
+
+    return (UNIT_ERASED != read_unit(obj, slot_addr(obj, sector, DONE_SLOT),
+                                    &value));
+}
+
+/*******************************************************************************
+ * Function Name: recover_read_offset
+ *******************************************************************************
+ *
+ * Summary:
+ *  Restores the read pointer of the head sector. Slots are programmed in
+ *  order, so the first erased one is found by binary search and the read
+ *  pointer is the last valid slot before it.
+ *
+ * Parameters:
+ *  obj - FIFO object with head_sector set.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void recover_read_offset(flash_fifo_t *obj)
+{
+    uint32_t low = 0U;
+    uint32_t high = DONE_SLOT;
+    uint32_t middle;
+    uint32_t value = 0U;
+
+    while (low < high)
+    {
+        middle = low + ((high - low) / 2U);
+
+        if (UNIT_ERASED == read_unit(obj, slot_addr(obj, obj->head_sector,
+                                                    middle), &value))
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1U;
+        }
+    }
+
+    obj->ack_slot = low;
+    obj->read_offset = obj->data_start;
+
+    /* Skip slots torn by a reset */
+    for (uint32_t slot = low; slot > 0U; slot--)
+    {
+        if (UNIT_VALID == read_unit(obj, slot_addr(obj, obj->head_sector,
+                                                    slot - 1U), &value))
+        {
+            obj->read_offset = value;
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: recover_write_offset
+ *******************************************************************************
+ *
+ * Summary:
+ *  Restores the write pointer of the tail sector by a binary search for the
+ *  first data page that was never programmed. A programmed page never starts
+ *  with an erased word, as it starts with a record header.
+ *
+ * Parameters:
+ *  obj - FIFO object with tail_sector set.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void recover_write_offset(flash_fifo_t *obj)
+{
+    uint32_t low = 0U;
+    uint32_t high = (obj->sector_size - obj->data_start) /
+                    FLASH_FIFO_PAGE_SIZE;
+    uint32_t middle;
+    uint8_t word[WORD_SIZE];
+
+    while (low < high)
+    {
+        middle = low + ((high - low) / 2U);
+        (void)mtb_serial_memory_read(obj->mem,
+                                    sector_addr(obj, obj->tail_sector) +
+                                    obj->data_start +
+                                    (middle * FLASH_FIFO_PAGE_SIZE),
+                                    WORD_SIZE, word);
+
+        if (ERASED_WORD == get_le32(word))
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1U;
+        }
+    }
+
+    obj->write_offset = obj->data_start + (low * FLASH_FIFO_PAGE_SIZE);
+}
+
+/*******************************************************************************
+ * Function Name: start_sector
+ *******************************************************************************
+ *
+ * Summary:
+ *  Erases a sector and writes its header.
+ *
+ * Parameters:
+ *  obj - FIFO object.
+ *  sector - index of the sector.
+ *  seq - sequence number of the sector.
+ *
+ * Return:
+ *  cy_rslt_t - result of the erase or program operation
+ *
+ ******************************************************************************/
+static cy_rslt_t start_sector(flash_fifo_t *obj, uint32_t sector, uint32_t seq)
+{
+    cy_rslt_t result = mtb_serial_memory_erase(obj->mem,
+                                                sector_addr(obj, sector),
+                                                obj->sector_size);
+
+    obj->stats.sectors_erased++;
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = write_unit(obj, sector_addr(obj, sector) + MAGIC_OFFSET,
+                            SECTOR_MAGIC);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = write_unit(obj, sector_addr(obj, sector) + SEQ_OFFSET, seq);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_fifo_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Opens the FIFO in a partition and restores its read and write pointers.
+ *  The newest sector is the one with the highest sequence number; the head
+ *  is found by walking back through sectors with consecutive sequence
+ *  numbers that are not consumed yet. Both pointers are then restored by a
+ *  binary search within a single sector, so recovery never scans records.
+ *  A partition without a valid sector is formatted.
+ *
+ * Parameters:
+ *  obj - FIFO object.
+ *  mem - serial memory object.
+ *  base - start of the partition, aligned to a sector.
+ *  size - size of the partition; at least two sectors.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations, or CY_SMIF_BAD_PARAM for an
+ *  invalid partition
+ *
+ ******************************************************************************/
+cy_rslt_t flash_fifo_init(flash_fifo_t *obj, mtb_serial_memory_t *mem,
+                            uint32_t base, uint32_t size)
+{
+    uint32_t seq;
+    uint32_t head_seq;
+    uint32_t prev;
+    bool found = false;
+
+    memset(obj, 0, sizeof(*obj));
+    obj->mem = mem;
+    obj->base = base;
+    obj->sector_size = (uint32_t)mtb_serial_memory_get_erase_size(mem, base);
+    obj->sector_count = size / obj->sector_size;
+    obj->data_start = ACK_AREA_OFFSET + ACK_AREA_SIZE;
+    obj->cached_page = ERASED_WORD;
+    memset(obj->wr_buf, ERASED_BYTE, sizeof(obj->wr_buf));
+
+    if ((2U > obj->sector_count) || (0U != (size % obj->sector_size)) ||
+        (0U != (base % obj->sector_size)) ||
+        (0U != (obj->sector_size % FLASH_FIFO_PAGE_SIZE)) ||
+        (obj->data_start >= obj->sector_size))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    for (uint32_t sector = 0U; sector < obj->sector_count; sector++)
+    {
+        if (read_header(obj, sector, &seq) && (!found || (seq > obj->tail_seq)))
+        {
+            obj->tail_sector = sector;
+            obj->tail_seq = seq;
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        return flash_fifo_format(obj);
+    }
+
+    obj->head_sector = obj->tail_sector;
+    head_seq = obj->tail_seq;
+    prev = (obj->head_sector + obj->sector_count - 1U) % obj->sector_count;
+
+    while ((prev != obj->tail_sector) && read_header(obj, prev, &seq) &&
+            (seq == (head_seq - 1U)) && !is_done(obj, prev))
+    {
+        obj->head_sector = prev;
+        head_seq = seq;
+        prev = (prev + obj->sector_count - 1U) % obj->sector_count;
+    }
+
+    recover_write_offset(obj);
+    recover_read_offset(obj);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: flash_fifo_format
+ *******************************************************************************
+ *
+ * Summary:
+ *  Empties the FIFO. Sectors with a header are erased so that they are not
+ *  mistaken for queue content at the next recovery.
+ *
+ * Parameters:
+ *  obj - FIFO object opened with flash_fifo_init().
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+cy_rslt_t flash_fifo_format(flash_fifo_t *obj)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t seq;
+
+    for (uint32_t sector = 1U; (sector < obj->sector_count) &&
+        (CY_RSLT_SUCCESS == result); sector++)
+    {
+        if (read_header(obj, sector, &seq))
+        {
+            result = mtb_serial_memory_erase(obj->mem,
+                                            sector_addr(obj, sector),
+                                            obj->sector_size);
+            obj->stats.sectors_erased++;
+        }
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = start_sector(obj, 0U, 1U);
+    }
+
+    obj->head_sector = 0U;
+    obj->tail_sector = 0U;
+    obj->tail_seq = 1U;
+    obj->read_offset = obj->data_start;
+    obj->write_offset = obj->data_start;
+    obj->ack_slot = 0U;
+    obj->fill = 0U;
+    obj->cached_page = ERASED_WORD;
+    memset(obj->wr_buf, ERASED_BYTE, sizeof(obj->wr_buf));
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_fifo_enqueue
+ *******************************************************************************
+ *
+ * Summary:
+ *  Appends a record to the page being filled in RAM. The page is programmed
+ *  when the record does not fit in it any more, or by flash_fifo_flush();
+ *  records are persistent and visible to flash_fifo_dequeue() only then.
+ *
+ * Parameters:
+ *  obj - FIFO object.
+ *  data - record to append.
+ *  length - length of the record, 1 to FLASH_FIFO_MAX_RECORD_SIZE.
+ *
+ * Return:
+ *  cy_rslt_t - result of flash_fifo_flush() when a page is programmed, or
+ *  CY_SMIF_BAD_PARAM for an invalid length
+ *
+ ******************************************************************************/
+cy_rslt_t flash_fifo_enqueue(flash_fifo_t *obj, const uint8_t *data,
+                                uint32_t length)
+{
+    uint32_t padded = (length + RECORD_ALIGN - 1U) & ~(RECORD_ALIGN - 1U);
+    cy_rslt_t result;
+
+    if ((0U == length) || (FLASH_FIFO_MAX_RECORD_SIZE < length))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    if ((obj->fill + FLASH_FIFO_RECORD_HEADER_SIZE + padded) >
+        FLASH_FIFO_PAGE_SIZE)
+    {
+        result = flash_fifo_flush(obj);
+
+        if (CY_RSLT_SUCCESS != result)
+        {
+            return result;
+        }
+    }
+
+    put_le32(&obj->wr_buf[obj->fill],
+            length | ((~length & RECORD_LENGTH_MASK) << RECORD_CHECK_SHIFT));
+    memcpy(&obj->wr_buf[obj->fill + FLASH_FIFO_RECORD_HEADER_SIZE], data,
+            length);
+    obj->fill += FLASH_FIFO_RECORD_HEADER_SIZE + padded;
+    obj->stats.enqueued++;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: flash_fifo_flush
+ *******************************************************************************
+ *
+ * Summary:
+ *  Programs the records buffered in RAM as one page. The remainder of a
+ *  partially filled page stays erased and is skipped by the reader. When the
+ *  tail sector is full, the next sector is erased and started, unless it
+ *  still holds unread records.
+ *
+ * Parameters:
+ *  obj - FIFO object.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations, or CY_SMIF_BUSY if the FIFO
+ *  is full; the records then stay buffered
+ *
+ ******************************************************************************/
+cy_rslt_t flash_fifo_flush(flash_fifo_t *obj)
+{
+    uint32_t next;
+    cy_rslt_t result;
+
+    if (0U == obj->fill)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    if (obj->write_offset >= obj->sector_size)
+    {
+        next = (obj->tail_sector + 1U) % obj->sector_count;
+
+        if (next == obj->head_sector)
+        {
+            return (cy_rslt_t)CY_SMIF_BUSY;
+        }
+
+        result = start_sector(obj, next, obj->tail_seq + 1U);
+
+        if (CY_RSLT_SUCCESS != result)
+        {
+            return result;
+        }
+
+        obj->tail_sector = next;
+        obj->tail_seq++;
+        obj->write_offset = obj->data_start;
+    }
+
+    result = mtb_serial_memory_write(obj->mem,
+                                    sector_addr(obj, obj->tail_sector) +
+                                    obj->write_offset, FLASH_FIFO_PAGE_SIZE,
+                                    obj->wr_buf);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        obj->write_offset += FLASH_FIFO_PAGE_SIZE;
+        obj->fill = 0U;
+        obj->stats.pages_programmed++;
+        memset(obj->wr_buf, ERASED_BYTE, sizeof(obj->wr_buf));
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_fifo_dequeue
+ *******************************************************************************
+ *
+ * Summary:
+ *  Passes up to max_count records to the callback, oldest first, then
+ *  stores the new read pointer with a single ack program. Each data page is
+ *  read once. A sector whose records are all read is marked as consumed so
+ *  that the recovery skips it.
+ *
+ * Parameters:
+ *  obj - FIFO object.
+ *  cb - called for each record.
+ *  arg - passed to the callback.
+ *  max_count - maximum number of records of the batch.
+ *  count - receives the number of records passed to the callback.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+cy_rslt_t flash_fifo_dequeue(flash_fifo_t *obj, flash_fifo_record_cb_t cb,
+                                void *arg, uint32_t max_count,
+                                uint32_t *count)
+{
+    uint32_t page;
+    uint32_t in_page;
+    uint32_t header;
+    uint32_t length;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    *count = 0U;
+
+    while ((*count < max_count) && (CY_RSLT_SUCCESS == result) &&
+            ((obj->head_sector != obj->tail_sector) ||
+            (obj->read_offset < obj->write_offset)))
+    {
+        if (obj->read_offset >= obj->sector_size)
+        {
+            /* Only sectors before the tail are read to their end */
+            result = write_unit(obj, slot_addr(obj, obj->head_sector,
+                                                DONE_SLOT), obj->sector_size);
+            obj->head_sector = (obj->head_sector + 1U) % obj->sector_count;
+            obj->read_offset = obj->data_start;
+            obj->ack_slot = 0U;
+            continue;
+        }
+
+        page = obj->read_offset - (obj->read_offset % FLASH_FIFO_PAGE_SIZE);
+        in_page = obj->read_offset - page;
+        page += sector_addr(obj, obj->head_sector);
+
+        if (page != obj->cached_page)
+        {
+            result = mtb_serial_memory_read(obj->mem, page,
+                                            FLASH_FIFO_PAGE_SIZE, obj->rd_buf);
+            obj->cached_page = (CY_RSLT_SUCCESS == result) ?
+                                page : ERASED_WORD;
+            continue;
+        }
+
+        header = (in_page <= FLASH_FIFO_MAX_RECORD_SIZE) ?
+                    get_le32(&obj->rd_buf[in_page]) : ERASED_WORD;
+        length = header & RECORD_LENGTH_MASK;
+
+        if ((ERASED_WORD != header) &&
+            ((((header >> RECORD_CHECK_SHIFT) ^ length) != RECORD_LENGTH_MASK)
+            || ((in_page + FLASH_FIFO_RECORD_HEADER_SIZE + length) >
+                FLASH_FIFO_PAGE_SIZE)))
+        {
+            /* A reset interrupted the program of this page */
+            obj->stats.torn_records++;
+            header = ERASED_WORD;
+        }
+
+        if (ERASED_WORD == header)
+        {
+            /* The rest of the page is empty */
+            obj->read_offset += FLASH_FIFO_PAGE_SIZE - in_page;
+            continue;
+        }
+
+        cb(&obj->rd_buf[in_page + FLASH_FIFO_RECORD_HEADER_SIZE], length, arg);
+        obj->read_offset += FLASH_FIFO_RECORD_HEADER_SIZE +
+                            ((length + RECORD_ALIGN - 1U) &
+                            ~(RECORD_ALIGN - 1U));
+        obj->stats.dequeued++;
+        (*count)++;
+    }
+
+    if ((0U < *count) && (CY_RSLT_SUCCESS == result))
+    {
+        if (obj->ack_slot < DONE_SLOT)
+        {
+            result = write_unit(obj, slot_addr(obj, obj->head_sector,
+                                                obj->ack_slot),
+                                obj->read_offset);
+            obj->ack_slot++;
+            obj->stats.acks_written++;
+        }
+        else
+        {
+            obj->stats.acks_in_ram++;
+        }
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_fifo_is_empty
+ *******************************************************************************
+ *
+ * Summary:
+ *  Checks whether the FIFO holds no records, in flash or buffered in RAM.
+ *
+ * Parameters:
+ *  obj - FIFO object.
+ *
+ * Return:
+ *  bool - true if the FIFO is empty
+ *
+ ******************************************************************************/
+bool flash_fifo_is_empty(const flash_fifo_t *obj)
+{
+    return (0U == obj->fill) && (obj->head_sector == obj->tail_sector) &&
+            (obj->read_offset >= obj->write_offset);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * File Name        : flash_fifo.h
+ *
+ * Description      : This file is the public interface of flash_fifo.c, a
+ *                    persistent queue of variable-length records in a circular
+ *                    flash partition.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_FIFO_H_
+#define _FLASH_FIFO_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "mtb_serial_memory.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Unit of programming. Records are packed into pages and never span two.
+ * Must divide the sector size and be a multiple of the ECC unit of the
+ * memory, as every page is programmed once.
+ */
+#ifndef FLASH_FIFO_PAGE_SIZE
+#define FLASH_FIFO_PAGE_SIZE                (256U)
+#endif
+
+/* Read pointer updates that can be stored per sector. When a sector runs out
+ * of slots, later batches from it are only acknowledged in RAM and may be
+ * delivered again after a reset.
+ */
+#ifndef FLASH_FIFO_ACK_SLOTS
+#define FLASH_FIFO_ACK_SLOTS                (64U)
+#endif
+
+/* Length header of every record */
+#define FLASH_FIFO_RECORD_HEADER_SIZE       (4U)
+#define FLASH_FIFO_MAX_RECORD_SIZE          (FLASH_FIFO_PAGE_SIZE - \
+                                            FLASH_FIFO_RECORD_HEADER_SIZE)
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+/* Receives each dequeued record; data is valid during the call only */
+typedef void (*flash_fifo_record_cb_t)(const uint8_t *data, uint32_t length,
+                                        void *arg);
+
+typedef struct
+{
+    uint32_t    enqueued;
+    uint32_t    dequeued;
+    uint32_t    pages_programmed;
+    uint32_t    acks_written;
+    uint32_t    acks_in_ram;        /* Batches acknowledged in RAM only */
+    uint32_t    sectors_erased;
+    uint32_t    torn_records;       /* Records cut short by a reset */
+} flash_fifo_stats_t;
+
+typedef struct
+{
+    mtb_serial_memory_t *mem;
+    uint32_t            base;
+    uint32_t            sector_size;
+    uint32_t            sector_count;
+    uint32_t            data_start;     /* Offset of the first data page */
+
+    /* Read pointer */
+    uint32_t            head_sector;
+    uint32_t            read_offset;
+    uint32_t            ack_slot;       /* Next free slot of the head sector */
+    uint32_t            cached_page;    /* Address of rd_buf's page */
+
+    /* Write pointer */
+    uint32_t            tail_sector;
+    uint32_t            tail_seq;
+    uint32_t            write_offset;
+    uint32_t            fill;           /* Bytes of wr_buf in use */
+
+    uint8_t             wr_buf[FLASH_FIFO_PAGE_SIZE];
+    uint8_t             rd_buf[FLASH_FIFO_PAGE_SIZE];
+    flash_fifo_stats_t  stats;
+} flash_fifo_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+cy_rslt_t flash_fifo_init(flash_fifo_t *obj, mtb_serial_memory_t *mem,
+                            uint32_t base, uint32_t size);
+cy_rslt_t flash_fifo_format(flash_fifo_t *obj);
+cy_rslt_t flash_fifo_enqueue(flash_fifo_t *obj, const uint8_t *data,
+                                uint32_t length);
+cy_rslt_t flash_fifo_flush(flash_fifo_t *obj);
+cy_rslt_t flash_fifo_dequeue(flash_fifo_t *obj, flash_fifo_record_cb_t cb,
+                                void *arg, uint32_t max_count,
+                                uint32_t *count);
+bool flash_fifo_is_empty(const flash_fifo_t *obj);
+
+#endif /* _FLASH_FIFO_H_ */
+
+/* [] END OF FILE */
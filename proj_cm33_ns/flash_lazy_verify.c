@@ -0,0 +1,359 @@
+/*******************************************************************************
+ * File Name        : flash_lazy_verify.c
+ *
+ * Description      : This file contains lazy verification of programmed data.
+ *                    Writes return once the memory is programmed and are
+ *                    queued; the queue is read back and checked in batches
+ *                    when the caller has time, and failed writes are rewritten.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_lazy_verify.h"
+#include "crc32.h"
+#include <string.h>
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: queue_push
+ *******************************************************************************
+ *
+ * Summary:
+ *  Appends an entry to the queue, which must not be full.
+ *
+ * Parameters:
+ *  obj - lazy verify object.
+ *  entry - entry to append.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void queue_push(flash_lazy_verify_t *obj,
+                        const flash_lazy_verify_entry_t *entry)
+{
+    uint32_t tail = (obj->head + obj->count) % FLASH_LAZY_VERIFY_QUEUE_SIZE;
+
+    obj->queue[tail] = *entry;
+    obj->count++;
+
+    if (obj->count > obj->stats.max_pending)
+    {
+        obj->stats.max_pending = obj->count;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: queue_pop
+ *******************************************************************************
+ *
+ * Summary:
+ *  Removes the oldest entry from the queue, which must not be empty.
+ *
+ * Parameters:
+ *  obj - lazy verify object.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void queue_pop(flash_lazy_verify_t *obj)
+{
+    obj->head = (obj->head + 1U) % FLASH_LAZY_VERIFY_QUEUE_SIZE;
+    obj->count--;
+}
+
+/*******************************************************************************
+ * Function Name: verify_entry
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads a written range back and checks it against the retained data or
+ *  the CRC taken at write time. In compare mode the whole range is compared,
+ *  so a failure reports how many bytes and bits differ.
+ *
+ * Parameters:
+ *  obj - lazy verify object.
+ *  entry - write to verify.
+ *  diff - receives the differences; compare mode only.
+ *  match - receives whether the memory holds the written data.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash reads
+ *
+ ******************************************************************************/
+static cy_rslt_t verify_entry(flash_lazy_verify_t *obj,
+                                const flash_lazy_verify_entry_t *entry,
+                                mem_compare_t *diff, bool *match)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t crc = CRC32_INIT;
+    uint32_t offset = 0U;
+
+    mem_compare_init(diff);
+
+    while ((offset < entry->length) && (CY_RSLT_SUCCESS == result))
+    {
+        uint32_t length = entry->length - offset;
+
+        if (length > FLASH_LAZY_VERIFY_CHUNK_SIZE)
+        {
+            length = FLASH_LAZY_VERIFY_CHUNK_SIZE;
+        }
+
+        result = mtb_serial_memory_read(obj->mem, entry->address + offset,
+                                        length, obj->chunk);
+
+        if (FLASH_LAZY_VERIFY_COMPARE == entry->mode)
+        {
+            mem_compare_update(diff, offset, obj->chunk, &entry->data[offset],
+                                length);
+        }
+        else
+        {
+            crc = crc32_update(crc, obj->chunk, length);
+        }
+
+        offset += length;
+    }
+
+    *match = (FLASH_LAZY_VERIFY_COMPARE == entry->mode) ?
+                (MEM_COMPARE_MATCH == diff->first) :
+                (crc32_final(crc) == entry->crc);
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_lazy_verify_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Initializes an empty verification queue.
+ *
+ * Parameters:
+ *  obj - lazy verify object.
+ *  mem - serial memory object.
+ *  callback - called for each failed verification; may be NULL.
+ *  arg - argument of the callback.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_lazy_verify_init(flash_lazy_verify_t *obj, mtb_serial_memory_t *mem,
+                            flash_lazy_verify_cb_t callback, void *arg)
+{
+    memset(obj, 0, sizeof(*obj));
+    obj->mem = mem;
+    obj->callback = callback;
+    obj->arg = arg;
+}
+
+/*******************************************************************************
+ * Function Name: flash_lazy_verify_write
+ *******************************************************************************
+ *
+ * Summary:
+ *  Programs data and queues it for verification. If the queue is full, the
+ *  oldest write is verified first.
+ *
+ * Parameters:
+ *  obj - lazy verify object.
+ *  address - address to program; the range must be erased.
+ *  length - number of bytes to program.
+ *  data - data to program. In compare mode it must stay unchanged until the
+ *         write is verified.
+ *  mode - how the write is verified.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+cy_rslt_t flash_lazy_verify_write(flash_lazy_verify_t *obj, uint32_t address,
+                                    uint32_t length, const uint8_t *data,
+                                    flash_lazy_verify_mode_t mode)
+{
+    flash_lazy_verify_entry_t entry;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    /* A failed write goes back into the queue, so one pass may not free a
+     * slot
+     */
+    while ((FLASH_LAZY_VERIFY_QUEUE_SIZE == obj->count) &&
+            (CY_RSLT_SUCCESS == result))
+    {
+        obj->stats.forced++;
+        result = flash_lazy_verify_process(obj, 1U);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = mtb_serial_memory_write(obj->mem, address, length, data);
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        entry.address = address;
+        entry.length = length;
+        entry.mode = mode;
+        entry.data = (FLASH_LAZY_VERIFY_COMPARE == mode) ? data : NULL;
+        entry.crc = (FLASH_LAZY_VERIFY_CRC == mode) ? crc32(data, length) : 0U;
+        entry.rewrites = 0U;
+
+        queue_push(obj, &entry);
+        obj->stats.writes++;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_lazy_verify_process
+ *******************************************************************************
+ *
+ * Summary:
+ *  Verifies up to max_writes pending writes, oldest first. A failed write
+ *  in compare mode is programmed again from the retained data and queued
+ *  for another verification, which helps when the cells were only partly
+ *  programmed. It is given up after FLASH_LAZY_VERIFY_MAX_REWRITES.
+ *
+ * Parameters:
+ *  obj - lazy verify object.
+ *  max_writes - largest number of writes to verify in this call.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations; on error the write being
+ *  verified stays queued
+ *
+ ******************************************************************************/
+cy_rslt_t flash_lazy_verify_process(flash_lazy_verify_t *obj,
+                                    uint32_t max_writes)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    for (uint32_t done = 0U; (done < max_writes) && (0U < obj->count) &&
+        (CY_RSLT_SUCCESS == result); done++)
+    {
+        flash_lazy_verify_entry_t entry = obj->queue[obj->head];
+        flash_lazy_verify_failure_t failure;
+        bool match;
+
+        result = verify_entry(obj, &entry, &failure.diff, &match);
+
+        if (CY_RSLT_SUCCESS != result)
+        {
+            break;
+        }
+
+        queue_pop(obj);
+
+        if (match)
+        {
+            obj->stats.verified++;
+            continue;
+        }
+
+        obj->stats.failures++;
+
+        failure.address = entry.address;
+        failure.length = entry.length;
+        failure.mode = entry.mode;
+        failure.rewrites = entry.rewrites;
+        failure.final = (FLASH_LAZY_VERIFY_COMPARE != entry.mode) ||
+                        (FLASH_LAZY_VERIFY_MAX_REWRITES <= entry.rewrites);
+
+        if (NULL != obj->callback)
+        {
+            obj->callback(&failure, obj->arg);
+        }
+
+        if (!failure.final)
+        {
+            result = mtb_serial_memory_write(obj->mem, entry.address,
+                                            entry.length, entry.data);
+            entry.rewrites++;
+            obj->stats.rewrites++;
+            queue_push(obj, &entry);
+        }
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_lazy_verify_flush
+ *******************************************************************************
+ *
+ * Summary:
+ *  Verifies every pending write, including the rewrites this causes.
+ *
+ * Parameters:
+ *  obj - lazy verify object.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+cy_rslt_t flash_lazy_verify_flush(flash_lazy_verify_t *obj)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    while ((0U < obj->count) && (CY_RSLT_SUCCESS == result))
+    {
+        result = flash_lazy_verify_process(obj, obj->count);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_lazy_verify_pending
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the number of writes not verified yet.
+ *
+ * Parameters:
+ *  obj - lazy verify object.
+ *
+ * Return:
+ *  uint32_t - number of pending writes
+ *
+ ******************************************************************************/
+uint32_t flash_lazy_verify_pending(const flash_lazy_verify_t *obj)
+{
+    return obj->count;
+}
+
+/* [] END OF FILE */
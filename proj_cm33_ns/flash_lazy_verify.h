@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * File Name        : flash_lazy_verify.h
+ *
+ * Description      : This file is the public interface of flash_lazy_verify.c,
+ *                    which verifies programmed data in background batches
+ *                    instead of right after each write.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_LAZY_VERIFY_H_
+#define _FLASH_LAZY_VERIFY_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "mtb_serial_memory.h"
+#include "mem_compare.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Writes that can be pending verification; when the queue is full the
+ * oldest write is verified before a new one is accepted.
+ */
+#ifndef FLASH_LAZY_VERIFY_QUEUE_SIZE
+#define FLASH_LAZY_VERIFY_QUEUE_SIZE        (16U)
+#endif
+
+/* Rewrites of a write that failed verification before it is given up */
+#ifndef FLASH_LAZY_VERIFY_MAX_REWRITES
+#define FLASH_LAZY_VERIFY_MAX_REWRITES      (2U)
+#endif
+
+/* Read-back buffer; verification reads the memory in chunks of this size */
+#ifndef FLASH_LAZY_VERIFY_CHUNK_SIZE
+#define FLASH_LAZY_VERIFY_CHUNK_SIZE        (64U)
+#endif
+
+/*******************************************************************************
+ * Enumerations
+ ******************************************************************************/
+typedef enum
+{
+    /* Compare against the caller's data, which must stay unchanged until
+     * the write is verified. A failed write is rewritten from it.
+     */
+    FLASH_LAZY_VERIFY_COMPARE,
+
+    /* Compare a CRC-32 taken at write time; the data can be reused at once.
+     * A failed write is reported only, as there is nothing to rewrite from.
+     */
+    FLASH_LAZY_VERIFY_CRC
+} flash_lazy_verify_mode_t;
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t                    address;
+    uint32_t                    length;
+    flash_lazy_verify_mode_t    mode;
+    uint32_t                    rewrites;   /* Rewrites done so far */
+    bool                        final;      /* No rewrite will follow */
+    mem_compare_t               diff;       /* Compare mode only */
+} flash_lazy_verify_failure_t;
+
+/* Called for every failed verification, before the rewrite if any */
+typedef void (*flash_lazy_verify_cb_t)(
+                                const flash_lazy_verify_failure_t *failure,
+                                void *arg);
+
+typedef struct
+{
+    uint32_t                    address;
+    uint32_t                    length;
+    flash_lazy_verify_mode_t    mode;
+    const uint8_t               *data;      /* Compare mode only */
+    uint32_t                    crc;        /* CRC mode only */
+    uint32_t                    rewrites;
+} flash_lazy_verify_entry_t;
+
+typedef struct
+{
+    uint32_t    writes;
+    uint32_t    verified;
+    uint32_t    failures;
+    uint32_t    rewrites;
+    uint32_t    forced;             /* Verified early, queue was full */
+    uint32_t    max_pending;
+} flash_lazy_verify_stats_t;
+
+typedef struct
+{
+    mtb_serial_memory_t         *mem;
+    flash_lazy_verify_cb_t      callback;
+    void                        *arg;
+    flash_lazy_verify_entry_t   queue[FLASH_LAZY_VERIFY_QUEUE_SIZE];
+    uint32_t                    head;       /* Oldest pending write */
+    uint32_t                    count;
+    uint8_t                     chunk[FLASH_LAZY_VERIFY_CHUNK_SIZE];
+    flash_lazy_verify_stats_t   stats;
+} flash_lazy_verify_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void flash_lazy_verify_init(flash_lazy_verify_t *obj, mtb_serial_memory_t *mem,
+                            flash_lazy_verify_cb_t callback, void *arg);
+cy_rslt_t flash_lazy_verify_write(flash_lazy_verify_t *obj, uint32_t address,
+                                    uint32_t length, const uint8_t *data,
+                                    flash_lazy_verify_mode_t mode);
+cy_rslt_t flash_lazy_verify_process(flash_lazy_verify_t *obj,
+                                    uint32_t max_writes);
+cy_rslt_t flash_lazy_verify_flush(flash_lazy_verify_t *obj);
+uint32_t flash_lazy_verify_pending(const flash_lazy_verify_t *obj);
+
+#endif /* _FLASH_LAZY_VERIFY_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,328 @@
+/*******************************************************************************
+ * File Name        : flash_multi.c
+ *
+ * Description      : This file contains the striping of sequential writes
+ *                    across several flash devices. Consecutive sectors go to
+ *                    consecutive devices, so the erase of the next sector on
+ *                    one device runs while the current sector is programmed
+ *                    on another, and the erases of the devices overlap.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_multi.h"
+#include <string.h>
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: start_erase
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts the erase of a stripe sector without waiting for it.
+ *
+ * Parameters:
+ *  obj - multi-device object.
+ *  sector - stripe sector index.
+ *
+ * Return:
+ *  cy_rslt_t - CY_RSLT_SUCCESS, or the status of flash_cmd_erase_start()
+ *
+ ******************************************************************************/
+static cy_rslt_t start_erase(flash_multi_t *obj, uint32_t sector)
+{
+    uint32_t device;
+    uint32_t address = flash_multi_to_device(obj, sector * obj->sector_size,
+                                                &device);
+    cy_en_smif_status_t status =
+        flash_cmd_erase_start(obj->devices[device].cmd, address);
+
+    if (CY_SMIF_SUCCESS != status)
+    {
+        return (cy_rslt_t)status;
+    }
+
+    obj->erasing[device] = true;
+    obj->stats.erases++;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: wait_erase
+ *******************************************************************************
+ *
+ * Summary:
+ *  Waits for the erase started on a device, if any, to complete.
+ *
+ * Parameters:
+ *  obj - multi-device object.
+ *  device - device index.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void wait_erase(flash_multi_t *obj, uint32_t device)
+{
+    if (!obj->erasing[device])
+    {
+        return;
+    }
+
+    if (flash_cmd_is_busy(obj->devices[device].cmd))
+    {
+        obj->stats.erase_stalls++;
+
+        while (flash_cmd_is_busy(obj->devices[device].cmd))
+        {
+            /* Poll the status register until the erase completes */
+        }
+    }
+
+    obj->erasing[device] = false;
+}
+
+/*******************************************************************************
+ * Function Name: flash_multi_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Initializes a multi-device object. All devices must have the same sector
+ *  size at their base, which must be sector aligned.
+ *
+ * Parameters:
+ *  obj - multi-device object.
+ *  devices - devices in stripe order; copied.
+ *  device_count - number of devices, 1 to FLASH_MULTI_MAX_DEVICES.
+ *
+ * Return:
+ *  cy_rslt_t - CY_RSLT_SUCCESS, or CY_SMIF_BAD_PARAM for an unusable set of
+ *  devices
+ *
+ ******************************************************************************/
+cy_rslt_t flash_multi_init(flash_multi_t *obj,
+                            const flash_multi_device_t *devices,
+                            uint32_t device_count)
+{
+    if ((0U == device_count) || (device_count > FLASH_MULTI_MAX_DEVICES))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    memset(obj, 0, sizeof(*obj));
+    obj->device_count = device_count;
+    obj->sector_size = (uint32_t)mtb_serial_memory_get_erase_size(
+                                            devices[0].mem, devices[0].base);
+
+    for (uint32_t device = 0U; device < device_count; device++)
+    {
+        if ((obj->sector_size != (uint32_t)mtb_serial_memory_get_erase_size(
+                                devices[device].mem, devices[device].base)) ||
+            (0U != (devices[device].base % obj->sector_size)))
+        {
+            return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+        }
+
+        obj->devices[device] = devices[device];
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: flash_multi_begin
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts a sequential write of a stripe area and the erase of its first
+ *  sector on every device. The rest of the area is erased sector by sector
+ *  as the writes progress.
+ *
+ * Parameters:
+ *  obj - multi-device object.
+ *  address - sector-aligned start of the area in the stripe.
+ *  length - size of the area.
+ *
+ * Return:
+ *  cy_rslt_t - CY_RSLT_SUCCESS, CY_SMIF_BAD_PARAM for an unaligned or empty
+ *  area, or the status of the erase
+ *
+ ******************************************************************************/
+cy_rslt_t flash_multi_begin(flash_multi_t *obj, uint32_t address,
+                            uint32_t length)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t first = address / obj->sector_size;
+    uint32_t last;
+
+    if ((0U == length) || (0U != (address % obj->sector_size)))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    obj->cursor = address;
+    obj->end = address + length;
+    last = (obj->end - 1U) / obj->sector_size;
+
+    /* The first sector of every device is erased in parallel */
+    for (uint32_t sector = first; (sector <= last) &&
+        (sector < (first + obj->device_count)) &&
+        (CY_RSLT_SUCCESS == result); sector++)
+    {
+        result = start_erase(obj, sector);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_multi_write
+ *******************************************************************************
+ *
+ * Summary:
+ *  Appends data to the area opened by flash_multi_begin(). Once a sector is
+ *  full, the erase of the next sector of the same device is started, so it
+ *  runs while the other devices program.
+ *
+ * Parameters:
+ *  obj - multi-device object.
+ *  length - number of bytes to append.
+ *  data - data to append.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations, or CY_SMIF_BAD_PARAM if the
+ *  data does not fit in the area
+ *
+ ******************************************************************************/
+cy_rslt_t flash_multi_write(flash_multi_t *obj, uint32_t length,
+                            const uint8_t *data)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t last = (obj->end - 1U) / obj->sector_size;
+    uint32_t sector;
+    uint32_t device;
+    uint32_t address;
+    uint32_t piece;
+
+    if (length > (obj->end - obj->cursor))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    while ((0U < length) && (CY_RSLT_SUCCESS == result))
+    {
+        sector = obj->cursor / obj->sector_size;
+        address = flash_multi_to_device(obj, obj->cursor, &device);
+        piece = obj->sector_size - (obj->cursor % obj->sector_size);
+        piece = (piece > length) ? length : piece;
+
+        wait_erase(obj, device);
+        result = mtb_serial_memory_write(obj->devices[device].mem, address,
+                                            piece, data);
+
+        obj->cursor += piece;
+        obj->stats.bytes += piece;
+        data += piece;
+        length -= piece;
+
+        /* The device is done with this sector: erase its next one while the
+         * other devices program.
+         */
+        if ((CY_RSLT_SUCCESS == result) &&
+            (0U == (obj->cursor % obj->sector_size)) &&
+            ((sector + obj->device_count) <= last))
+        {
+            result = start_erase(obj, sector + obj->device_count);
+        }
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_multi_end
+ *******************************************************************************
+ *
+ * Summary:
+ *  Waits for the erases still in progress. Sectors of the area that were not
+ *  reached by the writes are left as they are.
+ *
+ * Parameters:
+ *  obj - multi-device object.
+ *
+ * Return:
+ *  cy_rslt_t - CY_RSLT_SUCCESS
+ *
+ ******************************************************************************/
+cy_rslt_t flash_multi_end(flash_multi_t *obj)
+{
+    for (uint32_t device = 0U; device < obj->device_count; device++)
+    {
+        wait_erase(obj, device);
+    }
+
+    obj->cursor = obj->end;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: flash_multi_to_device
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns where a stripe address is stored.
+ *
+ * Parameters:
+ *  obj - multi-device object.
+ *  address - stripe address.
+ *  device - receives the device index.
+ *
+ * Return:
+ *  uint32_t - address on that device
+ *
+ ******************************************************************************/
+uint32_t flash_multi_to_device(const flash_multi_t *obj, uint32_t address,
+                                uint32_t *device)
+{
+    uint32_t sector = address / obj->sector_size;
+
+    *device = sector % obj->device_count;
+
+    return obj->devices[*device].base +
+            ((sector / obj->device_count) * obj->sector_size) +
+            (address % obj->sector_size);
+}
+
+/* [] END OF FILE */
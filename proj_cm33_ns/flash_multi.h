@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * File Name        : flash_multi.h
+ *
+ * Description      : This file is the public interface of flash_multi.c,
+ *                    which stripes sequential writes across several flash
+ *                    devices and erases the next sector on one device while
+ *                    another one programs.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_MULTI_H_
+#define _FLASH_MULTI_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_cmd.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Set to 1U to compare striped writes with single-device writes in main() */
+#ifndef FLASH_MULTI_ENABLE
+#define FLASH_MULTI_ENABLE                  (0U)
+#endif
+
+/* Devices a write can be striped across, one per chip select */
+#ifndef FLASH_MULTI_MAX_DEVICES
+#define FLASH_MULTI_MAX_DEVICES             (2U)
+#endif
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+/* One device; base is the start of the area the stripe uses on it */
+typedef struct
+{
+    mtb_serial_memory_t     *mem;
+    flash_cmd_t             *cmd;
+    uint32_t                base;
+} flash_multi_device_t;
+
+typedef struct
+{
+    uint32_t    bytes;
+    uint32_t    erases;
+    uint32_t    erase_stalls;   /* Programs that waited for their erase */
+} flash_multi_stats_t;
+
+/* Sector s of a stripe is stored on device s % device_count at
+ * base + (s / device_count) * sector_size.
+ */
+typedef struct
+{
+    flash_multi_device_t    devices[FLASH_MULTI_MAX_DEVICES];
+    uint32_t                device_count;
+    uint32_t                sector_size;
+    bool                    erasing[FLASH_MULTI_MAX_DEVICES];
+    uint32_t                cursor;         /* Next stripe offset to write */
+    uint32_t                end;            /* End of the stripe area */
+    flash_multi_stats_t     stats;
+} flash_multi_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+cy_rslt_t flash_multi_init(flash_multi_t *obj,
+                            const flash_multi_device_t *devices,
+                            uint32_t device_count);
+cy_rslt_t flash_multi_begin(flash_multi_t *obj, uint32_t address,
+                            uint32_t length);
+cy_rslt_t flash_multi_write(flash_multi_t *obj, uint32_t length,
+                            const uint8_t *data);
+cy_rslt_t flash_multi_end(flash_multi_t *obj);
+uint32_t flash_multi_to_device(const flash_multi_t *obj, uint32_t address,
+                                uint32_t *device);
+
+#endif /* _FLASH_MULTI_H_ */
+
+/* [] END OF FILE */
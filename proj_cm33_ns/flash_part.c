@@ -0,0 +1,260 @@
+/*******************************************************************************
+ * File Name        : flash_part.c
+ *
+ * Description      : This file contains the partition table of the external
+ *                    memory. The table is stored with a CRC at the start of a
+ *                    sector; the firmware looks partitions up by name, and the
+ *                    host image builder uses the same code to lay out factory
+ *                    images.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_part.h"
+#include "crc32.h"
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define PART_MAGIC                          (0x54524150UL)  /* "PART" */
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: table_check
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the CRC that protects the table.
+ *
+ * Parameters:
+ *  table - partition table.
+ *
+ * Return:
+ *  uint32_t - CRC-32 of the fields before check
+ *
+ ******************************************************************************/
+static uint32_t table_check(const flash_part_table_t *table)
+{
+    return crc32((const uint8_t *)table, offsetof(flash_part_table_t, check));
+}
+
+/*******************************************************************************
+ * Function Name: flash_part_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Initializes an empty partition table.
+ *
+ * Parameters:
+ *  table - partition table.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_part_init(flash_part_table_t *table)
+{
+    memset(table, 0, sizeof(*table));
+    table->magic = PART_MAGIC;
+}
+
+/*******************************************************************************
+ * Function Name: flash_part_add
+ *******************************************************************************
+ *
+ * Summary:
+ *  Appends a partition. FIFO and DATA partitions must not overlap each
+ *  other; FILE entries lie inside a DATA partition. The fields specific to
+ *  a type are set by the caller through entry.
+ *
+ * Parameters:
+ *  table - partition table.
+ *  name - unique name of at most FLASH_PART_NAME_SIZE characters.
+ *  type - partition type.
+ *  offset - start of the partition.
+ *  size - size of the partition.
+ *  entry - receives the new entry, may be NULL.
+ *
+ * Return:
+ *  cy_rslt_t - CY_RSLT_SUCCESS, or CY_SMIF_BAD_PARAM if the table is full,
+ *  the name is unusable or the partition overlaps another one
+ *
+ ******************************************************************************/
+cy_rslt_t flash_part_add(flash_part_table_t *table, const char *name,
+                            flash_part_type_t type, uint32_t offset,
+                            uint32_t size, flash_part_entry_t **entry)
+{
+    flash_part_entry_t *new_entry;
+    const flash_part_entry_t *other;
+    size_t name_length = strlen(name);
+
+    if ((FLASH_PART_MAX_ENTRIES <= table->count) || (0U == name_length) ||
+        (FLASH_PART_NAME_SIZE < name_length) ||
+        (NULL != flash_part_find(table, name)) || (0U == size) ||
+        (offset > (UINT32_MAX - size)))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    for (uint32_t index = 0U; (FLASH_PART_TYPE_FILE != type) &&
+        (index < table->count); index++)
+    {
+        other = &table->entries[index];
+
+        if ((FLASH_PART_TYPE_FILE != other->type) &&
+            (offset < (other->offset + other->size)) &&
+            ((offset + size) > other->offset))
+        {
+            return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+        }
+    }
+
+    new_entry = &table->entries[table->count];
+    memset(new_entry, 0, sizeof(*new_entry));
+    memcpy(new_entry->name, name, name_length);
+    new_entry->type = (uint32_t)type;
+    new_entry->offset = offset;
+    new_entry->size = size;
+    table->count++;
+
+    if (NULL != entry)
+    {
+        *entry = new_entry;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: flash_part_find
+ *******************************************************************************
+ *
+ * Summary:
+ *  Looks a partition up by name.
+ *
+ * Parameters:
+ *  table - partition table.
+ *  name - partition name.
+ *
+ * Return:
+ *  const flash_part_entry_t * - the partition, or NULL if there is none
+ *
+ ******************************************************************************/
+const flash_part_entry_t *flash_part_find(const flash_part_table_t *table,
+                                            const char *name)
+{
+    size_t name_length = strlen(name);
+
+    for (uint32_t index = 0U; (name_length <= FLASH_PART_NAME_SIZE) &&
+        (index < table->count); index++)
+    {
+        if (0 == strncmp(table->entries[index].name, name,
+                            FLASH_PART_NAME_SIZE))
+        {
+            return &table->entries[index];
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+ * Function Name: flash_part_save
+ *******************************************************************************
+ *
+ * Summary:
+ *  Stores the table at the start of a sector, which is erased first.
+ *
+ * Parameters:
+ *  table - partition table.
+ *  mem - serial memory object.
+ *  address - start of the sector.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+cy_rslt_t flash_part_save(flash_part_table_t *table, mtb_serial_memory_t *mem,
+                            uint32_t address)
+{
+    cy_rslt_t result = mtb_serial_memory_erase(mem, address,
+                            mtb_serial_memory_get_erase_size(mem, address));
+
+    table->check = table_check(table);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = mtb_serial_memory_write(mem, address, sizeof(*table),
+                                            (const uint8_t *)table);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_part_load
+ *******************************************************************************
+ *
+ * Summary:
+ *  Loads a table stored by flash_part_save().
+ *
+ * Parameters:
+ *  table - receives the partition table.
+ *  mem - serial memory object.
+ *  address - start of the sector.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash read, or CY_SMIF_BAD_PARAM if no valid
+ *  table is stored
+ *
+ ******************************************************************************/
+cy_rslt_t flash_part_load(flash_part_table_t *table, mtb_serial_memory_t *mem,
+                            uint32_t address)
+{
+    cy_rslt_t result = mtb_serial_memory_read(mem, address, sizeof(*table),
+                                                (uint8_t *)table);
+
+    if ((CY_RSLT_SUCCESS == result) &&
+        ((PART_MAGIC != table->magic) ||
+        (FLASH_PART_MAX_ENTRIES < table->count) ||
+        (table_check(table) != table->check)))
+    {
+        result = (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    return result;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * File Name        : flash_part.h
+ *
+ * Description      : This file is the public interface of flash_part.c, which
+ *                    stores the partition table of the external memory.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_PART_H_
+#define _FLASH_PART_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "mtb_serial_memory.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#ifndef FLASH_PART_MAX_ENTRIES
+#define FLASH_PART_MAX_ENTRIES              (16U)
+#endif
+
+/* Names are NUL padded and need not be NUL terminated */
+#define FLASH_PART_NAME_SIZE                (16U)
+
+/*******************************************************************************
+ * Enumerations
+ ******************************************************************************/
+typedef enum
+{
+    /* Persistent FIFO of flash_fifo.h over offset and size */
+    FLASH_PART_TYPE_FIFO = 1,
+
+    /* Data protected by the CRC side table of flash_crc_table.h at
+     * table_addr, with the given granule
+     */
+    FLASH_PART_TYPE_DATA = 2,
+
+    /* File stored inside a DATA partition; crc is its CRC-32 */
+    FLASH_PART_TYPE_FILE = 3
+} flash_part_type_t;
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    char        name[FLASH_PART_NAME_SIZE];
+    uint32_t    type;               /* flash_part_type_t */
+    uint32_t    offset;
+    uint32_t    size;
+    uint32_t    table_addr;         /* DATA only */
+    uint32_t    granule;            /* DATA only */
+    uint32_t    crc;                /* FILE only */
+} flash_part_entry_t;
+
+/* Image of the table in its flash sector */
+typedef struct
+{
+    uint32_t            magic;
+    uint32_t            count;
+    flash_part_entry_t  entries[FLASH_PART_MAX_ENTRIES];
+    uint32_t            check;      /* CRC-32 of the fields above */
+} flash_part_table_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void flash_part_init(flash_part_table_t *table);
+cy_rslt_t flash_part_add(flash_part_table_t *table, const char *name,
+                            flash_part_type_t type, uint32_t offset,
+                            uint32_t size, flash_part_entry_t **entry);
+const flash_part_entry_t *flash_part_find(const flash_part_table_t *table,
+                                            const char *name);
+cy_rslt_t flash_part_save(flash_part_table_t *table, mtb_serial_memory_t *mem,
+                            uint32_t address);
+cy_rslt_t flash_part_load(flash_part_table_t *table, mtb_serial_memory_t *mem,
+                            uint32_t address);
+
+#endif /* _FLASH_PART_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,616 @@
+/*******************************************************************************
+ * File Name        : flash_qual.c
+ *
+ * Description      : This file contains the multi-region qualification
+ *                    engine. Regions are stepped round-robin so that the
+ *                    sector erase of one region overlaps the data generation,
+ *                    the programming and the verification of the others.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_qual.h"
+#include "perf_counter.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define WORD_SIZE                           (4U)
+#define BITS_PER_BYTE                       (8U)
+#define BYTE_MASK                           (0xFFU)
+#define ERASED_WORD                         (0xFFFFFFFFUL)
+#define BYTES_PER_KB                        (1024U)
+
+/* Constants of the lowbias32 integer hash */
+#define HASH_SHIFT_1                        (16U)
+#define HASH_SHIFT_2                        (15U)
+#define HASH_MUL_1                          (0x7FEB352DUL)
+#define HASH_MUL_2                          (0x846CA68BUL)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Read and expected data of the verify steps */
+static uint8_t qual_rx_buf[FLASH_QUAL_CHUNK_SIZE];
+static uint8_t qual_expected_buf[FLASH_QUAL_CHUNK_SIZE];
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: pattern_word
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the pattern word of an address. Each word depends on its address,
+ *  so misplaced data is detected, and the verify step regenerates the
+ *  pattern instead of keeping a copy.
+ *
+ * Parameters:
+ *  seed - seed of the region.
+ *  address - word-aligned address.
+ *
+ * Return:
+ *  uint32_t - pattern word
+ *
+ ******************************************************************************/
+static uint32_t pattern_word(uint32_t seed, uint32_t address)
+{
+    uint32_t value = address ^ seed;
+
+    value ^= value >> HASH_SHIFT_1;
+    value *= HASH_MUL_1;
+    value ^= value >> HASH_SHIFT_2;
+    value *= HASH_MUL_2;
+    value ^= value >> HASH_SHIFT_1;
+
+    return value;
+}
+
+/*******************************************************************************
+ * Function Name: put_word
+ *******************************************************************************
+ *
+ * Summary:
+ *  Stores a pattern word in a byte buffer, least significant byte first.
+ *
+ * Parameters:
+ *  dst - destination of the four bytes.
+ *  word - word to store.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void put_word(uint8_t *dst, uint32_t word)
+{
+    for (uint32_t byte = 0U; byte < WORD_SIZE; byte++)
+    {
+        dst[byte] = (uint8_t)((word >> (byte * BITS_PER_BYTE)) & BYTE_MASK);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: expected_word
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the word a region should hold at an address once its operations
+ *  are done: the pattern if it is programmed, erased flash otherwise.
+ *
+ * Parameters:
+ *  region - region of the address.
+ *  address - word-aligned address.
+ *
+ * Return:
+ *  uint32_t - expected word
+ *
+ ******************************************************************************/
+static uint32_t expected_word(const flash_qual_region_t *region,
+                                uint32_t address)
+{
+    return ((0U != (region->ops & FLASH_QUAL_OP_PROGRAM)) ||
+            (0U == (region->ops & FLASH_QUAL_OP_ERASE))) ?
+            pattern_word(region->seed, address) : ERASED_WORD;
+}
+
+/*******************************************************************************
+ * Function Name: erase_in_progress
+ *******************************************************************************
+ *
+ * Summary:
+ *  Checks whether a sector erase started by the engine is still running.
+ *
+ * Parameters:
+ *  obj - qualification engine.
+ *
+ * Return:
+ *  bool - true if an erase is running
+ *
+ ******************************************************************************/
+static bool erase_in_progress(flash_qual_t *obj)
+{
+    return (FLASH_BANK_NONE != obj->bank->busy_bank) &&
+            flash_bank_is_busy(obj->bank, obj->bank->busy_bank);
+}
+
+/*******************************************************************************
+ * Function Name: next_phase
+ *******************************************************************************
+ *
+ * Summary:
+ *  Moves a region to the next phase it has an operation for.
+ *
+ * Parameters:
+ *  region - region to advance.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void next_phase(flash_qual_region_t *region)
+{
+    static const uint32_t phase_ops[FLASH_QUAL_PHASE_DONE] =
+    {
+        FLASH_QUAL_OP_ERASE, FLASH_QUAL_OP_PROGRAM, FLASH_QUAL_OP_VERIFY
+    };
+
+    do
+    {
+        region->phase = (flash_qual_phase_t)((uint32_t)region->phase + 1U);
+    } while ((FLASH_QUAL_PHASE_DONE != region->phase) &&
+            (0U == (region->ops & phase_ops[region->phase])));
+
+    region->offset = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: finish_region
+ *******************************************************************************
+ *
+ * Summary:
+ *  Marks a region as done and records its duration.
+ *
+ * Parameters:
+ *  region - region that completed or failed.
+ *  result - result of the last flash access.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void finish_region(flash_qual_region_t *region, cy_rslt_t result)
+{
+    region->result = result;
+    region->phase = FLASH_QUAL_PHASE_DONE;
+    region->cycles = perf_counter_get() - region->start_cycles;
+}
+
+/*******************************************************************************
+ * Function Name: step_erase
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts the erase of the next sector of a region if no erase is running.
+ *  The erase proceeds in the background while other regions are stepped.
+ *
+ * Parameters:
+ *  obj - qualification engine.
+ *  region - region in the erase phase.
+ *
+ * Return:
+ *  bool - true if the region made progress
+ *
+ ******************************************************************************/
+static bool step_erase(flash_qual_t *obj, flash_qual_region_t *region)
+{
+    uint32_t address = region->address + region->offset;
+    cy_en_smif_status_t status;
+
+    if (erase_in_progress(obj))
+    {
+        return false;
+    }
+
+    status = flash_bank_erase_start(obj->bank, address);
+
+    if (CY_SMIF_SUCCESS != status)
+    {
+        finish_region(region, (cy_rslt_t)status);
+        return true;
+    }
+
+    region->sectors_erased++;
+    region->offset += mtb_serial_memory_get_erase_size(obj->mem, address);
+
+    if (region->offset >= region->size)
+    {
+        next_phase(region);
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: step_program
+ *******************************************************************************
+ *
+ * Summary:
+ *  Generates the pattern of the next page of a region, or programs it once
+ *  generated. The page is only programmed while no erase is running; the
+ *  pattern can be generated at any time.
+ *
+ * Parameters:
+ *  obj - qualification engine.
+ *  region - region in the program phase.
+ *
+ * Return:
+ *  bool - true if the region made progress
+ *
+ ******************************************************************************/
+static bool step_program(flash_qual_t *obj, flash_qual_region_t *region)
+{
+    uint32_t address = region->address + region->offset;
+    cy_rslt_t result;
+
+    if (!region->data_ready)
+    {
+        for (uint32_t index = 0U; index < FLASH_QUAL_CHUNK_SIZE;
+            index += WORD_SIZE)
+        {
+            put_word(&region->buf[index],
+                        pattern_word(region->seed, address + index));
+        }
+
+        region->data_ready = true;
+        return true;
+    }
+
+    if (erase_in_progress(obj))
+    {
+        return false;
+    }
+
+    result = mtb_serial_memory_write(obj->mem, address, FLASH_QUAL_CHUNK_SIZE,
+                                    region->buf);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        finish_region(region, result);
+        return true;
+    }
+
+    region->data_ready = false;
+    region->bytes_programmed += FLASH_QUAL_CHUNK_SIZE;
+    region->offset += FLASH_QUAL_CHUNK_SIZE;
+
+    if (region->offset >= region->size)
+    {
+        next_phase(region);
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: step_verify
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads and checks the next chunk of a region unless its bank is erasing.
+ *  Reads of other banks proceed during an erase.
+ *
+ * Parameters:
+ *  obj - qualification engine.
+ *  region - region in the verify phase.
+ *
+ * Return:
+ *  bool - true if the region made progress
+ *
+ ******************************************************************************/
+static bool step_verify(flash_qual_t *obj, flash_qual_region_t *region)
+{
+    uint32_t address = region->address + region->offset;
+    cy_en_smif_status_t status;
+
+    status = flash_bank_try_read(obj->bank, address, FLASH_QUAL_CHUNK_SIZE,
+                                qual_rx_buf);
+
+    if (CY_SMIF_BUSY == status)
+    {
+        return false;
+    }
+
+    if (CY_SMIF_SUCCESS != status)
+    {
+        finish_region(region, (cy_rslt_t)status);
+        return true;
+    }
+
+    for (uint32_t index = 0U; index < FLASH_QUAL_CHUNK_SIZE;
+        index += WORD_SIZE)
+    {
+        put_word(&qual_expected_buf[index],
+                    expected_word(region, address + index));
+    }
+
+    mem_compare_update(&region->diff, region->offset, qual_rx_buf,
+                        qual_expected_buf, FLASH_QUAL_CHUNK_SIZE);
+
+    region->bytes_verified += FLASH_QUAL_CHUNK_SIZE;
+    region->offset += FLASH_QUAL_CHUNK_SIZE;
+
+    if (region->offset >= region->size)
+    {
+        finish_region(region, CY_RSLT_SUCCESS);
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: flash_qual_region_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Describes a region of the qualification plan. A region that is verified
+ *  but not programmed is checked for erased flash if it is erased, and for
+ *  the pattern of the seed otherwise.
+ *
+ * Parameters:
+ *  region - region to initialize.
+ *  address - start of the region; aligned to a sector if it is erased.
+ *  size - size of the region; whole sectors if it is erased, whole chunks
+ *  otherwise.
+ *  ops - FLASH_QUAL_OP_* flags.
+ *  seed - seed of the pattern.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_qual_region_init(flash_qual_region_t *region, uint32_t address,
+                            uint32_t size, uint32_t ops, uint32_t seed)
+{
+    memset(region, 0, sizeof(*region));
+    mem_compare_init(&region->diff);
+    region->address = address;
+    region->size = size;
+    region->ops = ops;
+    region->seed = seed;
+}
+
+/*******************************************************************************
+ * Function Name: flash_qual_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Sets up the engine for a list of regions and checks their alignment.
+ *
+ * Parameters:
+ *  obj - qualification engine.
+ *  mem - serial memory object.
+ *  bank - bank tracking of the same memory.
+ *  regions - regions of the plan.
+ *  region_count - number of regions.
+ *
+ * Return:
+ *  cy_en_smif_status_t - CY_SMIF_BAD_PARAM if a region is misaligned
+ *
+ ******************************************************************************/
+cy_en_smif_status_t flash_qual_init(flash_qual_t *obj,
+                                    mtb_serial_memory_t *mem,
+                                    flash_bank_t *bank,
+                                    flash_qual_region_t *regions,
+                                    uint32_t region_count)
+{
+    flash_qual_region_t *region;
+    uint32_t align;
+
+    memset(obj, 0, sizeof(*obj));
+    obj->mem = mem;
+    obj->bank = bank;
+    obj->regions = regions;
+    obj->region_count = region_count;
+
+    for (uint32_t index = 0U; index < region_count; index++)
+    {
+        region = &regions[index];
+        align = (0U != (region->ops & FLASH_QUAL_OP_ERASE)) ?
+                (uint32_t)mtb_serial_memory_get_erase_size(mem,
+                                                        region->address) :
+                FLASH_QUAL_CHUNK_SIZE;
+
+        if ((0U == region->size) || (0U != (region->address % align)) ||
+            (0U != (region->size % align)) ||
+            (0U == (region->ops & FLASH_QUAL_OP_ALL)))
+        {
+            return CY_SMIF_BAD_PARAM;
+        }
+
+        region->phase = FLASH_QUAL_PHASE_ERASE;
+
+        if (0U == (region->ops & FLASH_QUAL_OP_ERASE))
+        {
+            next_phase(region);
+        }
+    }
+
+    return CY_SMIF_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: flash_qual_run
+ *******************************************************************************
+ *
+ * Summary:
+ *  Steps every unfinished region in turn until all are done. When no region
+ *  can progress, all of them wait for the running erase, and so does the
+ *  engine.
+ *
+ * Parameters:
+ *  obj - qualification engine.
+ *
+ * Return:
+ *  bool - true if every region completed without errors or mismatches
+ *
+ ******************************************************************************/
+bool flash_qual_run(flash_qual_t *obj)
+{
+    flash_qual_region_t *region;
+    uint32_t start = perf_counter_get();
+    bool active = true;
+    bool progress;
+    bool passed = true;
+
+    for (uint32_t index = 0U; index < obj->region_count; index++)
+    {
+        obj->regions[index].start_cycles = start;
+    }
+
+    while (active)
+    {
+        active = false;
+        progress = false;
+
+        for (uint32_t index = 0U; index < obj->region_count; index++)
+        {
+            region = &obj->regions[index];
+
+            switch (region->phase)
+            {
+                case FLASH_QUAL_PHASE_ERASE:
+                    progress = step_erase(obj, region) || progress;
+                    break;
+
+                case FLASH_QUAL_PHASE_PROGRAM:
+                    progress = step_program(obj, region) || progress;
+                    break;
+
+                case FLASH_QUAL_PHASE_VERIFY:
+                    progress = step_verify(obj, region) || progress;
+                    break;
+
+                default:
+                    break;
+            }
+
+            active = active || (FLASH_QUAL_PHASE_DONE != region->phase);
+        }
+
+        if (progress)
+        {
+            obj->steps++;
+        }
+        else if (active)
+        {
+            obj->stalls++;
+            flash_bank_wait(obj->bank);
+        }
+    }
+
+    /* The last erase of an erase-only region may still be running */
+    flash_bank_wait(obj->bank);
+    obj->cycles = perf_counter_get() - start;
+
+    for (uint32_t index = 0U; index < obj->region_count; index++)
+    {
+        region = &obj->regions[index];
+        passed = passed && (CY_RSLT_SUCCESS == region->result) &&
+                    (MEM_COMPARE_MATCH == region->diff.first);
+    }
+
+    return passed;
+}
+
+/*******************************************************************************
+ * Function Name: flash_qual_print_report
+ *******************************************************************************
+ *
+ * Summary:
+ *  Prints the results of every region and the aggregate throughput.
+ *
+ * Parameters:
+ *  obj - qualification engine after flash_qual_run().
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_qual_print_report(const flash_qual_t *obj)
+{
+    const flash_qual_region_t *region;
+    uint64_t bytes = 0U;
+    uint64_t usec = perf_counter_cycles_to_usec(obj->cycles);
+
+    printf("\r\nFlash qualification (%"PRIu32" regions):\r\n",
+            obj->region_count);
+    printf("-------------------------\r\n");
+
+    for (uint32_t index = 0U; index < obj->region_count; index++)
+    {
+        region = &obj->regions[index];
+        bytes += (uint64_t)region->bytes_programmed + region->bytes_verified;
+
+        printf("0x%08"PRIx32" +%"PRIu32": %s, erased %"PRIu32" sectors, "
+                "programmed %"PRIu32", verified %"PRIu32", %"PRIu32" us\r\n",
+                region->address, region->size,
+                (CY_RSLT_SUCCESS != region->result) ? "FAILED" :
+                ((MEM_COMPARE_MATCH != region->diff.first) ?
+                "MISMATCH" : "PASS"),
+                region->sectors_erased, region->bytes_programmed,
+                region->bytes_verified,
+                (uint32_t)perf_counter_cycles_to_usec(region->cycles));
+
+        if (CY_RSLT_SUCCESS != region->result)
+        {
+            printf("  error 0x%08"PRIX32"\r\n", (uint32_t)region->result);
+        }
+        else if (MEM_COMPARE_MATCH != region->diff.first)
+        {
+            printf("  %"PRIu32" bytes and %"PRIu32" bits differ, first at "
+                    "0x%08"PRIx32"\r\n", region->diff.bytes,
+                    region->diff.bits, region->address + region->diff.first);
+        }
+    }
+
+    printf("Total %"PRIu32" us, %"PRIu32" KB/s programmed and verified, "
+            "%"PRIu32" stalls\r\n", (uint32_t)usec,
+            (0U == usec) ? 0U :
+            (uint32_t)((bytes * PERF_COUNTER_USEC_PER_SEC) /
+                        (usec * BYTES_PER_KB)),
+            obj->stalls);
+}
+
+/* [] END OF FILE */
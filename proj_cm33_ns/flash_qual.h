@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * File Name        : flash_qual.h
+ *
+ * Description      : This file is the public interface of flash_qual.c which
+ *                    runs erase, program and verify passes over several flash
+ *                    regions at the same time.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_QUAL_H_
+#define _FLASH_QUAL_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "mtb_serial_memory.h"
+#include "flash_bank.h"
+#include "mem_compare.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Set to 1U to run the multi-region qualification plan in main() */
+#ifndef FLASH_QUAL_ENABLE
+#define FLASH_QUAL_ENABLE                   (0U)
+#endif
+
+/* Unit of programming and verification; one page of the memory */
+#ifndef FLASH_QUAL_CHUNK_SIZE
+#define FLASH_QUAL_CHUNK_SIZE               (256U)
+#endif
+
+/* Operations of a region, run in this order */
+#define FLASH_QUAL_OP_ERASE                 (1U << 0U)
+#define FLASH_QUAL_OP_PROGRAM               (1U << 1U)
+#define FLASH_QUAL_OP_VERIFY                (1U << 2U)
+#define FLASH_QUAL_OP_ALL                   (FLASH_QUAL_OP_ERASE | \
+                                            FLASH_QUAL_OP_PROGRAM | \
+                                            FLASH_QUAL_OP_VERIFY)
+
+/*******************************************************************************
+ * Enumerations
+ ******************************************************************************/
+typedef enum
+{
+    FLASH_QUAL_PHASE_ERASE,
+    FLASH_QUAL_PHASE_PROGRAM,
+    FLASH_QUAL_PHASE_VERIFY,
+    FLASH_QUAL_PHASE_DONE
+} flash_qual_phase_t;
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    /* Set by flash_qual_region_init() */
+    uint32_t            address;
+    uint32_t            size;
+    uint32_t            ops;
+    uint32_t            seed;           /* Seed of the programmed pattern */
+
+    /* Progress */
+    flash_qual_phase_t  phase;
+    uint32_t            offset;         /* Offset within the current phase */
+    bool                data_ready;     /* buf holds the next page */
+    uint32_t            start_cycles;
+    uint8_t             buf[FLASH_QUAL_CHUNK_SIZE];
+
+    /* Results */
+    cy_rslt_t           result;         /* First failed flash access */
+    uint32_t            sectors_erased;
+    uint32_t            bytes_programmed;
+    uint32_t            bytes_verified;
+    mem_compare_t       diff;           /* first is an offset in region */
+    uint64_t            cycles;
+} flash_qual_region_t;
+
+typedef struct
+{
+    mtb_serial_memory_t *mem;
+    flash_bank_t        *bank;
+    flash_qual_region_t *regions;
+    uint32_t            region_count;
+    uint32_t            steps;          /* Units of work done */
+    uint32_t            stalls;         /* Rounds where every region waited */
+    uint64_t            cycles;
+} flash_qual_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void flash_qual_region_init(flash_qual_region_t *region, uint32_t address,
+                            uint32_t size, uint32_t ops, uint32_t seed);
+cy_en_smif_status_t flash_qual_init(flash_qual_t *obj,
+                                    mtb_serial_memory_t *mem,
+                                    flash_bank_t *bank,
+                                    flash_qual_region_t *regions,
+                                    uint32_t region_count);
+bool flash_qual_run(flash_qual_t *obj);
+void flash_qual_print_report(const flash_qual_t *obj);
+
+#endif /* _FLASH_QUAL_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,268 @@
+/*******************************************************************************
+ * File Name        : flash_read_merge.c
+ *
+ * Description      : This file coalesces queued reads. Pending reads are
+ *                    sorted by address, reads that overlap or touch each
+ *                    other are read in one transaction into a staging buffer
+ *                    and the data is then copied to each requester's buffer.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_read_merge.h"
+#include <string.h>
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: sort_queue
+ *******************************************************************************
+ *
+ * Summary:
+ *  Sorts the pending reads by start address. Insertion sort is used as the
+ *  queue is short and usually almost sorted.
+ *
+ * Parameters:
+ *  obj - read merge object.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void sort_queue(flash_read_merge_t *obj)
+{
+    flash_read_merge_req_t req;
+    uint32_t pos;
+
+    for (uint32_t index = 1U; index < obj->count; index++)
+    {
+        req = obj->queue[index];
+        pos = index;
+
+        while ((0U < pos) && (obj->queue[pos - 1U].address > req.address))
+        {
+            obj->queue[pos] = obj->queue[pos - 1U];
+            pos--;
+        }
+
+        obj->queue[pos] = req;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: complete_request
+ *******************************************************************************
+ *
+ * Summary:
+ *  Calls the completion callback of a read, if any.
+ *
+ * Parameters:
+ *  req - read to complete.
+ *  result - result of the transaction that served the read.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void complete_request(const flash_read_merge_req_t *req,
+                            cy_rslt_t result)
+{
+    if (NULL != req->callback)
+    {
+        req->callback(result, req->arg);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: flash_read_merge_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Initializes the read merge object with an empty queue.
+ *
+ * Parameters:
+ *  obj - read merge object to initialize.
+ *  mem - serial memory object the reads are issued to.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_read_merge_init(flash_read_merge_t *obj, mtb_serial_memory_t *mem)
+{
+    obj->mem = mem;
+    obj->count = 0U;
+    memset(&obj->stats, 0, sizeof(obj->stats));
+}
+
+/*******************************************************************************
+ * Function Name: flash_read_merge_submit
+ *******************************************************************************
+ *
+ * Summary:
+ *  Queues a read. The data is available in buf once the callback has been
+ *  called from flash_read_merge_process().
+ *
+ * Parameters:
+ *  obj - read merge object.
+ *  address - memory address to read from.
+ *  length - number of bytes to read.
+ *  buf - destination buffer.
+ *  callback - completion callback, may be NULL.
+ *  arg - argument passed to the callback.
+ *
+ * Return:
+ *  bool - false if the queue is full
+ *
+ ******************************************************************************/
+bool flash_read_merge_submit(flash_read_merge_t *obj, uint32_t address,
+                            uint32_t length, uint8_t *buf,
+                            flash_read_merge_cb_t callback, void *arg)
+{
+    flash_read_merge_req_t *req;
+
+    if (FLASH_READ_MERGE_QUEUE_SIZE <= obj->count)
+    {
+        return false;
+    }
+
+    req = &obj->queue[obj->count++];
+    req->address = address;
+    req->length = length;
+    req->buf = buf;
+    req->callback = callback;
+    req->arg = arg;
+
+    obj->stats.requests++;
+    obj->stats.bytes_requested += length;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: flash_read_merge_process
+ *******************************************************************************
+ *
+ * Summary:
+ *  Serves all pending reads. Each group of reads that overlap, touch or are
+ *  separated by at most FLASH_READ_MERGE_MAX_GAP bytes and that fits in the
+ *  staging buffer is served by one transaction. A group with a single read
+ *  is read directly into the requester's buffer.
+ *
+ * Parameters:
+ *  obj - read merge object.
+ *
+ * Return:
+ *  cy_rslt_t - result of the first failed transaction, CY_RSLT_SUCCESS if all
+ *  transactions succeeded
+ *
+ ******************************************************************************/
+cy_rslt_t flash_read_merge_process(flash_read_merge_t *obj)
+{
+    cy_rslt_t result;
+    cy_rslt_t first_error = CY_RSLT_SUCCESS;
+    uint32_t first = 0U;
+    uint32_t last;
+    uint32_t start;
+    uint32_t end;
+    uint32_t req_end;
+    flash_read_merge_req_t *req;
+
+    sort_queue(obj);
+
+    while (first < obj->count)
+    {
+        start = obj->queue[first].address;
+        end = start + obj->queue[first].length;
+        last = first + 1U;
+
+        /* Grow the group while the next read is close enough and fits */
+        while (last < obj->count)
+        {
+            req = &obj->queue[last];
+            req_end = (req->address + req->length > end) ?
+                        (req->address + req->length) : end;
+
+            if ((req->address > end + FLASH_READ_MERGE_MAX_GAP) ||
+                (req_end - start > FLASH_READ_MERGE_MAX_SPAN))
+            {
+                break;
+            }
+
+            end = req_end;
+            last++;
+        }
+
+        if (1U == last - first)
+        {
+            req = &obj->queue[first];
+            result = mtb_serial_memory_read(obj->mem, req->address,
+                                            req->length, req->buf);
+            complete_request(req, result);
+        }
+        else
+        {
+            result = mtb_serial_memory_read(obj->mem, start, end - start,
+                                            obj->staging);
+
+            for (uint32_t index = first; index < last; index++)
+            {
+                req = &obj->queue[index];
+
+                if (CY_RSLT_SUCCESS == result)
+                {
+                    memcpy(req->buf, &obj->staging[req->address - start],
+                            req->length);
+                }
+
+                complete_request(req, result);
+            }
+
+            obj->stats.merged_transactions++;
+        }
+
+        if ((CY_RSLT_SUCCESS != result) && (CY_RSLT_SUCCESS == first_error))
+        {
+            first_error = result;
+        }
+
+        obj->stats.transactions++;
+        obj->stats.bytes_transferred += end - start;
+        first = last;
+    }
+
+    obj->count = 0U;
+
+    return first_error;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * File Name        : flash_read_merge.h
+ *
+ * Description      : This file is the public interface of flash_read_merge.c
+ *                    which coalesces queued reads of neighboring addresses
+ *                    into a single memory transaction.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_READ_MERGE_H_
+#define _FLASH_READ_MERGE_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "mtb_serial_memory.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Number of reads that can be pending at the same time */
+#ifndef FLASH_READ_MERGE_QUEUE_SIZE
+#define FLASH_READ_MERGE_QUEUE_SIZE         (16U)
+#endif
+
+/* Largest merged transaction; also the size of the staging buffer */
+#ifndef FLASH_READ_MERGE_MAX_SPAN
+#define FLASH_READ_MERGE_MAX_SPAN           (512U)
+#endif
+
+/* Reads separated by up to this many bytes are still merged. The gap is read
+ * and discarded, which is cheaper than a new opcode and address phase.
+ */
+#ifndef FLASH_READ_MERGE_MAX_GAP
+#define FLASH_READ_MERGE_MAX_GAP            (0U)
+#endif
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+/* Called once the data of a read has been copied to its buffer */
+typedef void (*flash_read_merge_cb_t)(cy_rslt_t result, void *arg);
+
+typedef struct
+{
+    uint32_t                address;
+    uint32_t                length;
+    uint8_t                 *buf;
+    flash_read_merge_cb_t   callback;
+    void                    *arg;
+} flash_read_merge_req_t;
+
+typedef struct
+{
+    uint32_t    requests;
+    uint32_t    transactions;
+    uint32_t    merged_transactions;
+    uint32_t    bytes_requested;
+    uint32_t    bytes_transferred;
+} flash_read_merge_stats_t;
+
+typedef struct
+{
+    mtb_serial_memory_t         *mem;
+    flash_read_merge_req_t      queue[FLASH_READ_MERGE_QUEUE_SIZE];
+    uint32_t                    count;
+    flash_read_merge_stats_t    stats;
+    uint8_t                     staging[FLASH_READ_MERGE_MAX_SPAN];
+} flash_read_merge_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void flash_read_merge_init(flash_read_merge_t *obj, mtb_serial_memory_t *mem);
+bool flash_read_merge_submit(flash_read_merge_t *obj, uint32_t address,
+                            uint32_t length, uint8_t *buf,
+                            flash_read_merge_cb_t callback, void *arg);
+cy_rslt_t flash_read_merge_process(flash_read_merge_t *obj);
+
+#endif /* _FLASH_READ_MERGE_H_ */
+
+/* [] END OF FILE */
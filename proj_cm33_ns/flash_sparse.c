@@ -0,0 +1,209 @@
+/*******************************************************************************
+ * File Name        : flash_sparse.c
+ *
+ * Description      : This file programs erased memory while leaving out the
+ *                    program pages of the data that are all 0xFF, which the
+ *                    program would leave unchanged. Padding in firmware images
+ *                    and unused table space is typically all 0xFF.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_sparse.h"
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define ERASED_BYTE                         (0xFFU)
+#define ERASED_WORD                         (0xFFFFFFFFUL)
+
+/* Words checked per iteration of the blank check */
+#define BLANK_BLOCK_WORDS                   (4U)
+#define BLANK_BLOCK_SIZE                    (BLANK_BLOCK_WORDS * \
+                                            sizeof(uint32_t))
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: flash_sparse_is_blank
+ *******************************************************************************
+ *
+ * Summary:
+ *  Checks whether a buffer holds erased bytes only. The buffer is checked
+ *  four words at a time: the AND of the words is all ones only if every
+ *  byte is 0xFF, so one compare and branch covers 16 bytes. The words are
+ *  loaded through memcpy(), which the compiler turns into plain loads on
+ *  cores that allow unaligned access and which, unlike a cast of the byte
+ *  pointer, does not break the aliasing rules.
+ *
+ * Parameters:
+ *  data - buffer to check, any alignment.
+ *  length - size of the buffer.
+ *
+ * Return:
+ *  bool - true if programming the buffer would leave the memory unchanged
+ *
+ ******************************************************************************/
+bool flash_sparse_is_blank(const uint8_t *data, uint32_t length)
+{
+    uint32_t words[BLANK_BLOCK_WORDS];
+    uint32_t index = 0U;
+
+    for (; (length - index) >= BLANK_BLOCK_SIZE; index += BLANK_BLOCK_SIZE)
+    {
+        memcpy(words, &data[index], BLANK_BLOCK_SIZE);
+
+        if (ERASED_WORD != (words[0] & words[1] & words[2] & words[3]))
+        {
+            return false;
+        }
+    }
+
+    for (; index < length; index++)
+    {
+        if (ERASED_BYTE != data[index])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: write_run
+ *******************************************************************************
+ *
+ * Summary:
+ *  Programs a run of consecutive non-blank pages with a single write.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  address - address of data[0].
+ *  data - data being programmed.
+ *  start - offset of the run in data.
+ *  end - offset just past the run.
+ *  stats - statistics to update.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash write
+ *
+ ******************************************************************************/
+static cy_rslt_t write_run(mtb_serial_memory_t *mem, uint32_t address,
+                            const uint8_t *data, uint32_t start, uint32_t end,
+                            flash_sparse_stats_t *stats)
+{
+    if (start == end)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    stats->writes++;
+
+    return mtb_serial_memory_write(mem, address + start, end - start,
+                                    &data[start]);
+}
+
+/*******************************************************************************
+ * Function Name: flash_sparse_write
+ *******************************************************************************
+ *
+ * Summary:
+ *  Programs a range of erased memory, page by page along the program page
+ *  boundaries of the memory. Pages of the data that are all 0xFF are not
+ *  programmed; the other pages are programmed in runs, one write per run,
+ *  so dense data costs no extra transfers.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  address - start of the range, which must be erased.
+ *  length - number of bytes to program.
+ *  data - data to program.
+ *  stats - page counts are added to it; may be NULL.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash writes
+ *
+ ******************************************************************************/
+cy_rslt_t flash_sparse_write(mtb_serial_memory_t *mem, uint32_t address,
+                                uint32_t length, const uint8_t *data,
+                                flash_sparse_stats_t *stats)
+{
+    flash_sparse_stats_t unused = { 0U };
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t page_size;
+    uint32_t run_start = 0U;
+    uint32_t offset = 0U;
+    uint32_t size;
+
+    if ((NULL == mem) || ((NULL == data) && (0U != length)))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    stats = (NULL != stats) ? stats : &unused;
+    page_size = (uint32_t)mtb_serial_memory_get_prog_size(mem, address);
+
+    if (0U == page_size)
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    while ((offset < length) && (CY_RSLT_SUCCESS == result))
+    {
+        size = page_size - ((address + offset) % page_size);
+        size = ((length - offset) < size) ? (length - offset) : size;
+
+        if (flash_sparse_is_blank(&data[offset], size))
+        {
+            result = write_run(mem, address, data, run_start, offset, stats);
+            run_start = offset + size;
+            stats->pages_skipped++;
+        }
+        else
+        {
+            stats->pages_programmed++;
+        }
+
+        offset += size;
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = write_run(mem, address, data, run_start, length, stats);
+    }
+
+    return result;
+}
+
+/* [] END OF FILE */
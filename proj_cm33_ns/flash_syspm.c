@@ -0,0 +1,323 @@
+/*******************************************************************************
+ * File Name        : flash_syspm.c
+ *
+ * Description      : This file contains the SysPm deep sleep callback of the
+ *                    serial memory. Before deep sleep it checks that no
+ *                    transfer or program/erase is in progress and saves the
+ *                    SMIF control register, mode and XIP read set-up. After
+ *                    wake-up it restores them from RAM only if the SMIF block
+ *                    was reset, takes the memory out of continuous read mode
+ *                    and re-enables quad mode if needed, so the memory is
+ *                    usable again without rerunning mtb_serial_memory_setup().
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_syspm.h"
+#include "flash_cont_read.h"
+#include "perf_counter.h"
+#include "retarget_io_init.h"
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Size of the read that takes the memory out of continuous read mode */
+#define EXIT_READ_SIZE                      (1U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Serial memory deepsleep callback parameters */
+#if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
+
+/* SysPm callback parameter structure for the serial memory */
+static cy_stc_syspm_callback_params_t flash_syspm_cb_params =
+{
+    .context            = NULL,
+    .base               = NULL
+};
+
+/* SysPm callback structure for the serial memory */
+static cy_stc_syspm_callback_t flash_syspm_cb =
+{
+    .callback           = &flash_syspm_deepsleep_callback,
+    .skipMode           = SYSPM_SKIP_MODE,
+    .type               = CY_SYSPM_DEEPSLEEP,
+    .callbackParams     = &flash_syspm_cb_params,
+    .prevItm            = NULL,
+    .nextItm            = NULL,
+    .order              = SYSPM_CALLBACK_ORDER
+};
+#endif /* (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP) */
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: save_state
+ *******************************************************************************
+ *
+ * Summary:
+ *  Saves the SMIF control register, the mode and the device registers that
+ *  hold the XIP read set-up of the memory.
+ *
+ * Parameters:
+ *  obj - state saved across deep sleep.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void save_state(flash_syspm_t *obj)
+{
+    SMIF_DEVICE_Type volatile *device = obj->device;
+    flash_syspm_device_regs_t *saved = &obj->saved_device;
+
+    obj->saved_ctl = SMIF_CTL(obj->cmd->base);
+    obj->saved_mode = Cy_SMIF_GetMode(obj->cmd->base);
+
+    saved->ctl = device->CTL;
+    saved->addr = device->ADDR;
+    saved->mask = device->MASK;
+    saved->addr_ctl = device->ADDR_CTL;
+    saved->rd_cmd_ctl = device->RD_CMD_CTL;
+    saved->rd_addr_ctl = device->RD_ADDR_CTL;
+    saved->rd_mode_ctl = device->RD_MODE_CTL;
+    saved->rd_dummy_ctl = device->RD_DUMMY_CTL;
+    saved->rd_data_ctl = device->RD_DATA_CTL;
+}
+
+/*******************************************************************************
+ * Function Name: restore_read_mode
+ *******************************************************************************
+ *
+ * Summary:
+ *  Brings a reset SMIF block back to the read mode selected before deep
+ *  sleep. Runs from RAM, as no code can be fetched from a memory-mapped
+ *  memory until it is done:
+ *  1. Restores the control register and the XIP read set-up of the slot.
+ *  2. If the read command has a mode phase, the memory may still be in
+ *     continuous read mode and would take the next opcode for an address;
+ *     a read without opcode and with the exit mode bits takes it out.
+ *  3. If the read command transfers data on four lines, re-enables quad
+ *     mode in case the memory lost its QE bit.
+ *  4. Switches the SMIF back to the saved mode, XIP for a memory-mapped
+ *     memory.
+ *
+ * Parameters:
+ *  obj - state saved across deep sleep.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+static void restore_read_mode(flash_syspm_t *obj)
+{
+    flash_cmd_t *cmd = obj->cmd;
+    cy_stc_smif_mem_cmd_t *read_cmd = cmd->mem_config->deviceCfg->readCmd;
+    SMIF_DEVICE_Type volatile *device = obj->device;
+    const flash_syspm_device_regs_t *saved = &obj->saved_device;
+    uint8_t exit_buf[EXIT_READ_SIZE];
+    bool quad_enabled = true;
+
+    SMIF_CTL(cmd->base) = obj->saved_ctl;
+    Cy_SMIF_SetMode(cmd->base, CY_SMIF_NORMAL);
+
+    device->ADDR = saved->addr;
+    device->MASK = saved->mask;
+    device->ADDR_CTL = saved->addr_ctl;
+    device->RD_CMD_CTL = saved->rd_cmd_ctl;
+    device->RD_ADDR_CTL = saved->rd_addr_ctl;
+    device->RD_MODE_CTL = saved->rd_mode_ctl;
+    device->RD_DUMMY_CTL = saved->rd_dummy_ctl;
+    device->RD_DATA_CTL = saved->rd_data_ctl;
+    device->CTL = saved->ctl;
+
+    flash_cmd_begin(cmd);
+
+    if (FLASH_CMD_NO_MODE != read_cmd->mode)
+    {
+        (void)flash_cmd_read(cmd, 0U, EXIT_READ_SIZE, exit_buf,
+                            FLASH_CONT_READ_MODE_EXIT, true);
+    }
+
+    if ((CY_SMIF_WIDTH_QUAD == read_cmd->dataWidth) &&
+        (CY_SMIF_SUCCESS == Cy_SMIF_MemIsQuadEnabled(cmd->base,
+                                                    cmd->mem_config,
+                                                    &quad_enabled,
+                                                    cmd->context)) &&
+        !quad_enabled &&
+        (CY_SMIF_SUCCESS == Cy_SMIF_MemQuadEnable(cmd->base, cmd->mem_config,
+                                                    cmd->context)))
+    {
+        while (Cy_SMIF_MemIsBusy(cmd->base, cmd->mem_config, cmd->context))
+        {
+            /* Wait for the status register write */
+        }
+
+        obj->stats.quad_enables++;
+    }
+
+    flash_cmd_end(cmd);
+    Cy_SMIF_SetMode(cmd->base, obj->saved_mode);
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: flash_syspm_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Initializes the saved state and registers the deep sleep callback of the
+ *  serial memory.
+ *
+ * Parameters:
+ *  obj - state saved across deep sleep.
+ *  cmd - raw command interface of the memory.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_syspm_init(flash_syspm_t *obj, flash_cmd_t *cmd)
+{
+    obj->cmd = cmd;
+    obj->device = Cy_SMIF_GetDeviceBySlot(cmd->base,
+                                            cmd->mem_config->slaveSelect);
+    obj->wake_cycles = 0U;
+    memset(&obj->stats, 0, sizeof(obj->stats));
+    save_state(obj);
+
+    perf_counter_init();
+
+#if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
+    flash_syspm_cb_params.context = obj;
+    flash_syspm_cb_params.base = cmd->base;
+
+    /* Serial memory SysPm callback registration */
+    Cy_SysPm_RegisterCallback(&flash_syspm_cb);
+#endif /* (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP) */
+}
+
+/*******************************************************************************
+ * Function Name: flash_syspm_deepsleep_callback
+ *******************************************************************************
+ *
+ * Summary:
+ *  SysPm deep sleep callback of the serial memory. Runs from RAM: after
+ *  wake-up it is called before the XIP read set-up has been checked.
+ *
+ * Parameters:
+ *  params - callback parameters; context points to the flash_syspm_t object.
+ *  mode - callback mode.
+ *
+ * Return:
+ *  cy_en_syspm_status_t - CY_SYSPM_FAIL if a transfer, or a program/erase
+ *  operation on a memory that is not memory-mapped, is in progress when
+ *  checked for readiness
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+cy_en_syspm_status_t flash_syspm_deepsleep_callback(
+                                    cy_stc_syspm_callback_params_t *params,
+                                    cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t status = CY_SYSPM_SUCCESS;
+    flash_syspm_t *obj = (flash_syspm_t *)params->context;
+    SMIF_Type *base = obj->cmd->base;
+
+    switch (mode)
+    {
+        case CY_SYSPM_CHECK_READY:
+            /* Polling the status register leaves memory mode, which would
+             * stall XIP fetches of the other core. A memory-mapped memory
+             * is never programmed or erased in the background, so only
+             * its transfers are checked.
+             */
+            if (Cy_SMIF_BusyCheck(base) || ((0U ==
+                (obj->cmd->mem_config->flags & CY_SMIF_FLAG_MEMORY_MAPPED))
+                && flash_cmd_is_busy(obj->cmd)))
+            {
+                obj->stats.check_fails++;
+                status = CY_SYSPM_FAIL;
+            }
+            break;
+
+        case CY_SYSPM_BEFORE_TRANSITION:
+            save_state(obj);
+            obj->stats.transitions++;
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            obj->wake_cycles = perf_counter_get();
+
+            /* Registers are normally retained; restore only after a reset */
+            if (SMIF_CTL(base) != obj->saved_ctl)
+            {
+                restore_read_mode(obj);
+                obj->stats.restores++;
+            }
+
+            obj->stats.restore_cycles = perf_counter_get() - obj->wake_cycles;
+            break;
+
+        default:
+            /* Nothing to undo on CY_SYSPM_CHECK_FAIL */
+            break;
+    }
+
+    return status;
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: flash_syspm_cycles_since_wake
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the time since the last wake-up from deep sleep. Called right
+ *  after the first read it gives the wake-to-first-read latency.
+ *
+ * Parameters:
+ *  obj - state saved across deep sleep.
+ *
+ * Return:
+ *  uint32_t - time since wake-up in CPU cycles
+ *
+ ******************************************************************************/
+uint32_t flash_syspm_cycles_since_wake(const flash_syspm_t *obj)
+{
+    return perf_counter_get() - obj->wake_cycles;
+}
+
+/* [] END OF FILE */
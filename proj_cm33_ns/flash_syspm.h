@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * File Name        : flash_syspm.h
+ *
+ * Description      : This file is the public interface of flash_syspm.c which
+ *                    registers the SysPm deep sleep callback of the serial
+ *                    memory.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_SYSPM_H_
+#define _FLASH_SYSPM_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "cybsp.h"
+#include "flash_cmd.h"
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t    transitions;
+    uint32_t    check_fails;
+    uint32_t    restores;       /* Wakes that found the SMIF reset */
+    uint32_t    quad_enables;   /* Restores that found QE cleared */
+    uint32_t    restore_cycles; /* Of the last wake-up */
+} flash_syspm_stats_t;
+
+/* Device registers of the memory's slot that hold its XIP read set-up */
+typedef struct
+{
+    uint32_t    ctl;
+    uint32_t    addr;
+    uint32_t    mask;
+    uint32_t    addr_ctl;
+    uint32_t    rd_cmd_ctl;
+    uint32_t    rd_addr_ctl;
+    uint32_t    rd_mode_ctl;
+    uint32_t    rd_dummy_ctl;
+    uint32_t    rd_data_ctl;
+} flash_syspm_device_regs_t;
+
+/* State saved across deep sleep */
+typedef struct
+{
+    flash_cmd_t                 *cmd;
+    SMIF_DEVICE_Type volatile   *device;
+    uint32_t                    saved_ctl;
+    cy_en_smif_mode_t           saved_mode;
+    flash_syspm_device_regs_t   saved_device;
+    uint32_t                    wake_cycles;
+    flash_syspm_stats_t         stats;
+} flash_syspm_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void flash_syspm_init(flash_syspm_t *obj, flash_cmd_t *cmd);
+cy_en_syspm_status_t flash_syspm_deepsleep_callback(
+                                    cy_stc_syspm_callback_params_t *params,
+                                    cy_en_syspm_callback_mode_t mode);
+uint32_t flash_syspm_cycles_since_wake(const flash_syspm_t *obj);
+
+#endif /* _FLASH_SYSPM_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,532 @@
+/*******************************************************************************
+ * File Name        : flash_tune.c
+ *
+ * Description      : This file contains the calibration of the transfer chunk
+ *                    size. Reads and writes of growing size are timed, a fixed
+ *                    plus per-byte cost model is fitted to them and the
+ *                    smallest chunk that reaches a target share of the peak
+ *                    bandwidth within a RAM budget is selected. The streaming
+ *                    helpers split transfers into chunks of the tuned size.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_tune.h"
+#include "crc32.h"
+#include "perf_counter.h"
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define TUNE_MAGIC                          (0x454E5554UL)  /* "TUNE" */
+
+/* Transfers timed per size; the average is used */
+#define TUNE_REPEATS                        (4U)
+
+#define PERCENT                             (100U)
+#define PSEC_PER_NSEC                       (1000U)
+#define PSEC_PER_SEC                        (1000000000000ULL)
+#define BYTES_PER_KIB                       (1024U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Chunk sizes used by the streaming helpers */
+static uint32_t active_chunk[FLASH_TUNE_OP_COUNT] =
+{
+    FLASH_TUNE_DEFAULT_CHUNK_SIZE,
+    FLASH_TUNE_DEFAULT_CHUNK_SIZE
+};
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: tune_check
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the CRC that protects the stored values.
+ *
+ * Parameters:
+ *  tune - tuned values.
+ *
+ * Return:
+ *  uint32_t - CRC-32 of the fields before check
+ *
+ ******************************************************************************/
+static uint32_t tune_check(const flash_tune_t *tune)
+{
+    return crc32((const uint8_t *)tune, offsetof(flash_tune_t, check));
+}
+
+/*******************************************************************************
+ * Function Name: measure
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the average duration of a transfer of the given size. Writes go
+ *  to consecutive addresses of the scratch sector, which is erased when it
+ *  is full; the erase is not timed.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  op - operation to time.
+ *  scratch_addr - start of the scratch sector.
+ *  offset - next free offset in the scratch sector, updated.
+ *  buf - transfer buffer.
+ *  size - transfer size.
+ *  nsec - receives the average duration in nanoseconds.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+static cy_rslt_t measure(mtb_serial_memory_t *mem, flash_tune_op_t op,
+                            uint32_t scratch_addr, uint32_t *offset,
+                            uint8_t *buf, uint32_t size, uint32_t *nsec)
+{
+    uint32_t sector_size =
+        (uint32_t)mtb_serial_memory_get_erase_size(mem, scratch_addr);
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint64_t cycles = 0U;
+    uint32_t start;
+
+    for (uint32_t repeat = 0U; (repeat < TUNE_REPEATS) &&
+        (CY_RSLT_SUCCESS == result); repeat++)
+    {
+        if (FLASH_TUNE_OP_READ == op)
+        {
+            start = perf_counter_get();
+            result = mtb_serial_memory_read(mem, scratch_addr, size, buf);
+            cycles += perf_counter_get() - start;
+            continue;
+        }
+
+        if ((*offset + size) > sector_size)
+        {
+            result = mtb_serial_memory_erase(mem, scratch_addr, sector_size);
+            *offset = 0U;
+        }
+
+        if (CY_RSLT_SUCCESS == result)
+        {
+            start = perf_counter_get();
+            result = mtb_serial_memory_write(mem, scratch_addr + *offset,
+                                                size, buf);
+            cycles += perf_counter_get() - start;
+            *offset += size;
+        }
+    }
+
+    *nsec = (uint32_t)(perf_counter_cycles_to_nsec(cycles) / TUNE_REPEATS);
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: fit_model
+ *******************************************************************************
+ *
+ * Summary:
+ *  Fits fixed and per-byte costs to the measurements by least squares and
+ *  selects the smallest power-of-two chunk that reaches the target share of
+ *  the peak bandwidth 1 / per_byte, capped by the budget.
+ *
+ * Parameters:
+ *  model - receives the costs and the selected chunk.
+ *  sizes - transfer sizes.
+ *  nsec - measured durations.
+ *  count - number of measurements; at least two.
+ *  budget - largest chunk allowed.
+ *  target_percent - share of the peak bandwidth to reach.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void fit_model(flash_tune_model_t *model, const uint32_t *sizes,
+                        const uint32_t *nsec, uint32_t count, uint32_t budget,
+                        uint32_t target_percent)
+{
+    int64_t sum_s = 0;
+    int64_t sum_t = 0;
+    int64_t sum_ss = 0;
+    int64_t sum_st = 0;
+    int64_t n = (int64_t)count;
+    int64_t per_byte;
+    int64_t fixed;
+    uint64_t needed;
+    uint32_t chunk = FLASH_TUNE_MIN_CHUNK_SIZE;
+
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        sum_s += sizes[index];
+        sum_t += nsec[index];
+        sum_ss += (int64_t)sizes[index] * sizes[index];
+        sum_st += (int64_t)sizes[index] * nsec[index];
+    }
+
+    per_byte = ((n * sum_st) - (sum_s * sum_t)) * PSEC_PER_NSEC /
+                ((n * sum_ss) - (sum_s * sum_s));
+    per_byte = (per_byte < 0) ? 0 : per_byte;
+    fixed = ((sum_t * PSEC_PER_NSEC) - (per_byte * sum_s)) /
+            (n * PSEC_PER_NSEC);
+    fixed = (fixed < 0) ? 0 : fixed;
+
+    model->fixed_nsec = (uint32_t)fixed;
+    model->per_byte_psec = (uint32_t)per_byte;
+
+    /* size * per_byte / (fixed + size * per_byte) >= target */
+    if (0 == per_byte)
+    {
+        chunk = budget;
+    }
+    else
+    {
+        needed = ((uint64_t)target_percent * (uint64_t)fixed *
+                    PSEC_PER_NSEC) /
+                    ((uint64_t)per_byte * (PERCENT - target_percent));
+
+        while ((chunk < needed) && (chunk < budget))
+        {
+            chunk *= 2U;
+        }
+    }
+
+    model->chunk_size = chunk;
+    model->efficiency = (0 == per_byte) ? PERCENT :
+        (uint32_t)(((uint64_t)chunk * (uint64_t)per_byte * PERCENT) /
+                    (((uint64_t)fixed * PSEC_PER_NSEC) +
+                    ((uint64_t)chunk * (uint64_t)per_byte)));
+}
+
+/*******************************************************************************
+ * Function Name: flash_tune_calibrate
+ *******************************************************************************
+ *
+ * Summary:
+ *  Times reads and writes from FLASH_TUNE_MIN_CHUNK_SIZE up to the RAM
+ *  budget in powers of two, fits a cost model per operation and selects
+ *  the chunk sizes. The values are not applied; see flash_tune_apply().
+ *
+ * Parameters:
+ *  tune - receives the tuned values.
+ *  mem - serial memory object.
+ *  scratch_addr - sector that is erased and written by the calibration.
+ *  buf - transfer buffer; its size is the RAM budget.
+ *  buf_size - size of buf; at least twice FLASH_TUNE_MIN_CHUNK_SIZE.
+ *  target_percent - share of the peak bandwidth to reach, 1 to 99.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations, or CY_SMIF_BAD_PARAM for an
+ *  unusable budget or target
+ *
+ ******************************************************************************/
+cy_rslt_t flash_tune_calibrate(flash_tune_t *tune, mtb_serial_memory_t *mem,
+                                uint32_t scratch_addr, uint8_t *buf,
+                                uint32_t buf_size, uint32_t target_percent)
+{
+    uint32_t sizes[32U];
+    uint32_t nsec[32U];
+    uint32_t budget = FLASH_TUNE_MIN_CHUNK_SIZE;
+    uint32_t offset = 0U;
+    cy_rslt_t result;
+
+    if ((buf_size < (2U * FLASH_TUNE_MIN_CHUNK_SIZE)) ||
+        (0U == target_percent) || (target_percent >= PERCENT))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    while ((budget * 2U) <= buf_size)
+    {
+        budget *= 2U;
+    }
+
+    perf_counter_init();
+    memset(tune, 0, sizeof(*tune));
+
+    for (uint32_t index = 0U; index < budget; index++)
+    {
+        buf[index] = (uint8_t)index;
+    }
+
+    result = mtb_serial_memory_erase(mem, scratch_addr,
+                        mtb_serial_memory_get_erase_size(mem, scratch_addr));
+
+    for (uint32_t op = 0U; (op < FLASH_TUNE_OP_COUNT) &&
+        (CY_RSLT_SUCCESS == result); op++)
+    {
+        uint32_t count = 0U;
+
+        for (uint32_t size = FLASH_TUNE_MIN_CHUNK_SIZE; (size <= budget) &&
+            (CY_RSLT_SUCCESS == result); size *= 2U)
+        {
+            sizes[count] = size;
+            result = measure(mem, (flash_tune_op_t)op, scratch_addr, &offset,
+                                buf, size, &nsec[count]);
+            count++;
+        }
+
+        fit_model(&tune->models[op], sizes, nsec, count, budget,
+                    target_percent);
+    }
+
+    tune->magic = TUNE_MAGIC;
+    tune->target_percent = target_percent;
+    tune->ram_budget = budget;
+    tune->check = tune_check(tune);
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_tune_save
+ *******************************************************************************
+ *
+ * Summary:
+ *  Stores tuned values at the start of a sector, which is erased first.
+ *
+ * Parameters:
+ *  tune - tuned values.
+ *  mem - serial memory object.
+ *  address - start of the sector.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+cy_rslt_t flash_tune_save(flash_tune_t *tune, mtb_serial_memory_t *mem,
+                            uint32_t address)
+{
+    cy_rslt_t result = mtb_serial_memory_erase(mem, address,
+                            mtb_serial_memory_get_erase_size(mem, address));
+
+    tune->check = tune_check(tune);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = mtb_serial_memory_write(mem, address, sizeof(*tune),
+                                            (const uint8_t *)tune);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_tune_load
+ *******************************************************************************
+ *
+ * Summary:
+ *  Loads tuned values stored by flash_tune_save().
+ *
+ * Parameters:
+ *  tune - receives the tuned values.
+ *  mem - serial memory object.
+ *  address - start of the sector.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash read, or CY_SMIF_BAD_PARAM if no valid
+ *  values are stored
+ *
+ ******************************************************************************/
+cy_rslt_t flash_tune_load(flash_tune_t *tune, mtb_serial_memory_t *mem,
+                            uint32_t address)
+{
+    cy_rslt_t result = mtb_serial_memory_read(mem, address, sizeof(*tune),
+                                                (uint8_t *)tune);
+
+    if ((CY_RSLT_SUCCESS == result) &&
+        ((TUNE_MAGIC != tune->magic) || (tune_check(tune) != tune->check)))
+    {
+        result = (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_tune_apply
+ *******************************************************************************
+ *
+ * Summary:
+ *  Makes the streaming helpers use the tuned chunk sizes.
+ *
+ * Parameters:
+ *  tune - tuned values.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_tune_apply(const flash_tune_t *tune)
+{
+    for (uint32_t op = 0U; op < FLASH_TUNE_OP_COUNT; op++)
+    {
+        active_chunk[op] = tune->models[op].chunk_size;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: flash_tune_get_chunk_size
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the chunk size in use for an operation.
+ *
+ * Parameters:
+ *  op - operation.
+ *
+ * Return:
+ *  uint32_t - chunk size in bytes
+ *
+ ******************************************************************************/
+uint32_t flash_tune_get_chunk_size(flash_tune_op_t op)
+{
+    return active_chunk[op];
+}
+
+/*******************************************************************************
+ * Function Name: flash_tune_read
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads a range of any length in chunks of the tuned size.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  address - start of the range.
+ *  length - number of bytes to read.
+ *  buf - receives the data.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash reads
+ *
+ ******************************************************************************/
+cy_rslt_t flash_tune_read(mtb_serial_memory_t *mem, uint32_t address,
+                            uint32_t length, uint8_t *buf)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t chunk = active_chunk[FLASH_TUNE_OP_READ];
+
+    for (uint32_t offset = 0U; (offset < length) &&
+        (CY_RSLT_SUCCESS == result); offset += chunk)
+    {
+        result = mtb_serial_memory_read(mem, address + offset,
+                                        ((length - offset) < chunk) ?
+                                        (length - offset) : chunk,
+                                        &buf[offset]);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_tune_write
+ *******************************************************************************
+ *
+ * Summary:
+ *  Programs a range of any length in chunks of the tuned size.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  address - start of the range, which must be erased.
+ *  length - number of bytes to program.
+ *  data - data to program.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash writes
+ *
+ ******************************************************************************/
+cy_rslt_t flash_tune_write(mtb_serial_memory_t *mem, uint32_t address,
+                            uint32_t length, const uint8_t *data)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t chunk = active_chunk[FLASH_TUNE_OP_WRITE];
+
+    for (uint32_t offset = 0U; (offset < length) &&
+        (CY_RSLT_SUCCESS == result); offset += chunk)
+    {
+        result = mtb_serial_memory_write(mem, address + offset,
+                                            ((length - offset) < chunk) ?
+                                            (length - offset) : chunk,
+                                            &data[offset]);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_tune_print_report
+ *******************************************************************************
+ *
+ * Summary:
+ *  Prints the fitted costs and the selected chunk size of each operation.
+ *
+ * Parameters:
+ *  tune - tuned values.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_tune_print_report(const flash_tune_t *tune)
+{
+    static const char * const op_names[FLASH_TUNE_OP_COUNT] =
+    {
+        "Read ",
+        "Write"
+    };
+
+    printf("\r\nChunk size tuning (%"PRIu32"%% of peak, budget %"PRIu32
+            " bytes):\r\n", tune->target_percent, tune->ram_budget);
+    printf("-------------------------\r\n");
+
+    for (uint32_t op = 0U; op < FLASH_TUNE_OP_COUNT; op++)
+    {
+        const flash_tune_model_t *model = &tune->models[op];
+        uint32_t peak = (0U == model->per_byte_psec) ? 0U :
+                        (uint32_t)(PSEC_PER_SEC / model->per_byte_psec /
+                                    BYTES_PER_KIB);
+
+        printf("%s: %"PRIu32" ns + %"PRIu32" ps/byte, peak %"PRIu32
+                " KiB/s, chunk %"PRIu32" bytes (%"PRIu32"%%)\r\n",
+                op_names[op], model->fixed_nsec, model->per_byte_psec, peak,
+                model->chunk_size, model->efficiency);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * File Name        : flash_tune.h
+ *
+ * Description      : This file is the public interface of flash_tune.c, which
+ *                    calibrates the transfer chunk size of reads and writes.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_TUNE_H_
+#define _FLASH_TUNE_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "mtb_serial_memory.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Set to 1U to calibrate the chunk sizes at start-up in main() */
+#ifndef FLASH_TUNE_ENABLE
+#define FLASH_TUNE_ENABLE                   (0U)
+#endif
+
+/* Chunk size used until tuned values are applied */
+#ifndef FLASH_TUNE_DEFAULT_CHUNK_SIZE
+#define FLASH_TUNE_DEFAULT_CHUNK_SIZE       (64U)
+#endif
+
+/* Smallest transfer measured and selected */
+#define FLASH_TUNE_MIN_CHUNK_SIZE           (16U)
+
+/* Share of the peak bandwidth, in percent, the selected chunk must reach */
+#ifndef FLASH_TUNE_TARGET_PERCENT
+#define FLASH_TUNE_TARGET_PERCENT           (90U)
+#endif
+
+/*******************************************************************************
+ * Enumerations
+ ******************************************************************************/
+typedef enum
+{
+    FLASH_TUNE_OP_READ,
+    FLASH_TUNE_OP_WRITE,
+    FLASH_TUNE_OP_COUNT
+} flash_tune_op_t;
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+/* Transfer time modeled as fixed_nsec + size * per_byte_psec / 1000 */
+typedef struct
+{
+    uint32_t    fixed_nsec;         /* Command, address and set-up cost */
+    uint32_t    per_byte_psec;
+    uint32_t    chunk_size;         /* Selected chunk size */
+    uint32_t    efficiency;         /* Percent of peak at chunk_size */
+} flash_tune_model_t;
+
+/* Stored as is in flash; check covers everything before it */
+typedef struct
+{
+    uint32_t            magic;
+    uint32_t            target_percent;
+    uint32_t            ram_budget;
+    flash_tune_model_t  models[FLASH_TUNE_OP_COUNT];
+    uint32_t            check;
+} flash_tune_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+cy_rslt_t flash_tune_calibrate(flash_tune_t *tune, mtb_serial_memory_t *mem,
+                                uint32_t scratch_addr, uint8_t *buf,
+                                uint32_t buf_size, uint32_t target_percent);
+cy_rslt_t flash_tune_save(flash_tune_t *tune, mtb_serial_memory_t *mem,
+                            uint32_t address);
+cy_rslt_t flash_tune_load(flash_tune_t *tune, mtb_serial_memory_t *mem,
+                            uint32_t address);
+void flash_tune_apply(const flash_tune_t *tune);
+uint32_t flash_tune_get_chunk_size(flash_tune_op_t op);
+cy_rslt_t flash_tune_read(mtb_serial_memory_t *mem, uint32_t address,
+                            uint32_t length, uint8_t *buf);
+cy_rslt_t flash_tune_write(mtb_serial_memory_t *mem, uint32_t address,
+                            uint32_t length, const uint8_t *data);
+void flash_tune_print_report(const flash_tune_t *tune);
+
+#endif /* _FLASH_TUNE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * File Name        : flash_verify.c
+ *
+ * Description      : This file contains the fused read-and-compare verify. The
+ *                    memory is read in chunks of FLASH_VERIFY_CHUNK_SIZE and
+ *                    each chunk is compared as soon as it arrives, so the
+ *                    verify needs no buffer of the full length and stops at
+ *                    the first mismatch.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_verify.h"
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: verify_chunks
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads a memory range chunk by chunk and compares each chunk as soon as it
+ *  is read, optionally ending with the chunk that holds the first difference.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  address - start of the range.
+ *  expected - expected content of the range.
+ *  length - size of the range.
+ *  diff - receives the differences of the chunks compared.
+ *  stop_at_first - true to stop after the first differing chunk.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash reads; a mismatch is not an error
+ *
+ ******************************************************************************/
+static cy_rslt_t verify_chunks(mtb_serial_memory_t *mem, uint32_t address,
+                                const uint8_t *expected, uint32_t length,
+                                mem_compare_t *diff, bool stop_at_first)
+{
+    uint8_t chunk[FLASH_VERIFY_CHUNK_SIZE];
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t size;
+
+    mem_compare_init(diff);
+
+    for (uint32_t offset = 0U; (offset < length) &&
+        (CY_RSLT_SUCCESS == result); offset += size)
+    {
+        size = ((length - offset) < FLASH_VERIFY_CHUNK_SIZE) ?
+                (length - offset) : FLASH_VERIFY_CHUNK_SIZE;
+        result = mtb_serial_memory_read(mem, address + offset, size, chunk);
+
+        if (CY_RSLT_SUCCESS == result)
+        {
+            mem_compare_update(diff, offset, chunk, &expected[offset], size);
+
+            if (stop_at_first && (MEM_COMPARE_MATCH != diff->first))
+            {
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: flash_verify
+ *******************************************************************************
+ *
+ * Summary:
+ *  Compares a memory range with expected data. Each chunk is compared as
+ *  soon as it is read, so the range needs no read buffer of its own size.
+ *  The whole range is compared, so a failing part is reported with the
+ *  number of differing bytes and bits as well as the first difference. Use
+ *  it where the counts are printed; flash_verify_first() is cheaper for a
+ *  pass/fail check.
+ *
+ *  The serial-memory reads block until the data is in RAM, so the compare of
+ *  a chunk cannot run during the transfer of the next one; it costs a small
+ *  fraction of the transfer time of the chunk.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  address - start of the range.
+ *  expected - expected content of the range.
+ *  length - size of the range.
+ *  diff - receives the differences; diff->first is MEM_COMPARE_MATCH if
+ *  the range matches.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash reads; a mismatch is not an error
+ *
+ ******************************************************************************/
+cy_rslt_t flash_verify(mtb_serial_memory_t *mem, uint32_t address,
+                        const uint8_t *expected, uint32_t length,
+                        mem_compare_t *diff)
+{
+    return verify_chunks(mem, address, expected, length, diff, false);
+}
+
+/*******************************************************************************
+ * Function Name: flash_verify_first
+ *******************************************************************************
+ *
+ * Summary:
+ *  Compares a memory range with expected data like flash_verify(), but ends
+ *  with the chunk that holds the first mismatch, so a bad range is reported
+ *  after a single chunk read in the best case instead of after the full read.
+ *
+ * Parameters:
+ *  mem - serial memory object.
+ *  address - start of the range.
+ *  expected - expected content of the range.
+ *  length - size of the range.
+ *  mismatch - receives the offset of the first differing byte, or
+ *  MEM_COMPARE_MATCH.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash reads; a mismatch is not an error
+ *
+ ******************************************************************************/
+cy_rslt_t flash_verify_first(mtb_serial_memory_t *mem, uint32_t address,
+                                const uint8_t *expected, uint32_t length,
+                                uint32_t *mismatch)
+{
+    mem_compare_t diff;
+    cy_rslt_t result;
+
+    result = verify_chunks(mem, address, expected, length, &diff, true);
+    *mismatch = diff.first;
+
+    return result;
+}
+
+/* [] END OF FILE */
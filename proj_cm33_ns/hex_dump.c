@@ -0,0 +1,288 @@
+/*******************************************************************************
+ * File Name        : hex_dump.c
+ *
+ * Description      : This file formats buffers as hex dump lines. Each line is
+ *                    built in a line buffer with a nibble lookup table and
+ *                    handed to the writer in one call. Runs of identical lines
+ *                    are collapsed into a single marker line.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "hex_dump.h"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define NIBBLE_SHIFT                        (4U)
+#define NIBBLE_MASK                         (0x0FU)
+#define OFFSET_DIGITS                       (8U)
+#define ASCII_FIRST_PRINTABLE               (0x20U)
+#define ASCII_LAST_PRINTABLE                (0x7EU)
+
+/* "OOOOOOOO: " + "XX " per byte + " |" + ASCII + "|" + "\r\n" */
+#define LINE_BUF_SIZE                       (OFFSET_DIGITS + 2U + \
+                                            (3U * HEX_DUMP_BYTES_PER_LINE) + \
+                                            2U + HEX_DUMP_BYTES_PER_LINE + \
+                                            1U + 2U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static const char hex_lut[] = "0123456789ABCDEF";
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: write_stdout
+ *******************************************************************************
+ *
+ * Summary:
+ *  Default writer; sends the line to the console with a single write.
+ *
+ * Parameters:
+ *  line - formatted line.
+ *  length - length of the line.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void write_stdout(const char *line, uint32_t length)
+{
+    (void)fwrite(line, 1U, length, stdout);
+}
+
+/*******************************************************************************
+ * Function Name: put_offset
+ *******************************************************************************
+ *
+ * Summary:
+ *  Writes an offset as eight hex digits.
+ *
+ * Parameters:
+ *  pos - position in the line buffer.
+ *  offset - offset to write.
+ *
+ * Return:
+ *  char * - position after the digits
+ *
+ ******************************************************************************/
+static char *put_offset(char *pos, uint32_t offset)
+{
+    for (uint32_t digit = OFFSET_DIGITS; digit > 0U; digit--)
+    {
+        pos[digit - 1U] = hex_lut[offset & NIBBLE_MASK];
+        offset >>= NIBBLE_SHIFT;
+    }
+
+    return pos + OFFSET_DIGITS;
+}
+
+/*******************************************************************************
+ * Function Name: format_line
+ *******************************************************************************
+ *
+ * Summary:
+ *  Formats up to HEX_DUMP_BYTES_PER_LINE bytes into the line buffer.
+ *
+ * Parameters:
+ *  config - dump configuration.
+ *  line - line buffer of LINE_BUF_SIZE bytes.
+ *  offset - offset of the first byte.
+ *  data - bytes of the line.
+ *  count - number of bytes of the line.
+ *
+ * Return:
+ *  uint32_t - length of the line
+ *
+ ******************************************************************************/
+static uint32_t format_line(const hex_dump_config_t *config, char *line,
+                            uint32_t offset, const uint8_t *data,
+                            uint32_t count)
+{
+    char *pos = line;
+    uint8_t value;
+
+    if (config->show_offset)
+    {
+        pos = put_offset(pos, offset);
+        *pos++ = ':';
+        *pos++ = ' ';
+    }
+
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        value = data[index];
+        *pos++ = hex_lut[value >> NIBBLE_SHIFT];
+        *pos++ = hex_lut[value & NIBBLE_MASK];
+        *pos++ = ' ';
+    }
+
+    if (config->show_ascii)
+    {
+        /* Pad a short last line so that the gutter stays aligned */
+        memset(pos, ' ', 3U * (HEX_DUMP_BYTES_PER_LINE - count));
+        pos += 3U * (HEX_DUMP_BYTES_PER_LINE - count);
+        *pos++ = ' ';
+        *pos++ = '|';
+
+        for (uint32_t index = 0U; index < count; index++)
+        {
+            value = data[index];
+            *pos++ = ((ASCII_FIRST_PRINTABLE <= value) &&
+                        (ASCII_LAST_PRINTABLE >= value)) ? (char)value : '.';
+        }
+
+        *pos++ = '|';
+    }
+
+    *pos++ = '\r';
+    *pos++ = '\n';
+
+    return (uint32_t)(pos - line);
+}
+
+/*******************************************************************************
+ * Function Name: flush_run
+ *******************************************************************************
+ *
+ * Summary:
+ *  Writes the marker line of a run of collapsed lines.
+ *
+ * Parameters:
+ *  config - dump configuration.
+ *  line - line buffer of LINE_BUF_SIZE bytes.
+ *  run - number of collapsed lines.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void flush_run(const hex_dump_config_t *config, char *line,
+                        uint32_t run)
+{
+    int length = snprintf(line, LINE_BUF_SIZE,
+                            "* %lu identical line(s)\r\n", (unsigned long)run);
+
+    config->write(line, (uint32_t)length);
+}
+
+/*******************************************************************************
+ * Function Name: hex_dump_get_default_config
+ *******************************************************************************
+ *
+ * Summary:
+ *  Fills in the default configuration: offsets, ASCII gutter and collapsing
+ *  enabled, output to the console.
+ *
+ * Parameters:
+ *  config - configuration to fill in.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void hex_dump_get_default_config(hex_dump_config_t *config)
+{
+    config->base_offset = 0U;
+    config->show_offset = true;
+    config->show_ascii = true;
+    config->collapse = true;
+    config->write = &write_stdout;
+}
+
+/*******************************************************************************
+ * Function Name: hex_dump
+ *******************************************************************************
+ *
+ * Summary:
+ *  Dumps a buffer line by line. With collapsing enabled, full lines equal to
+ *  the previous one are not printed; a marker line with their count is
+ *  printed instead.
+ *
+ * Parameters:
+ *  config - dump configuration.
+ *  buf - buffer to dump.
+ *  size - size of the buffer.
+ *
+ * Return:
+ *  uint32_t - number of lines written
+ *
+ ******************************************************************************/
+uint32_t hex_dump(const hex_dump_config_t *config, const uint8_t *buf,
+                    uint32_t size)
+{
+    char line[LINE_BUF_SIZE];
+    uint32_t count;
+    uint32_t run = 0U;
+    uint32_t lines = 0U;
+
+    for (uint32_t index = 0U; index < size; index += count)
+    {
+        count = ((size - index) < HEX_DUMP_BYTES_PER_LINE) ?
+                    (size - index) : HEX_DUMP_BYTES_PER_LINE;
+
+        if (config->collapse && (0U < index) &&
+            (HEX_DUMP_BYTES_PER_LINE == count) &&
+            (0 == memcmp(&buf[index], &buf[index - HEX_DUMP_BYTES_PER_LINE],
+                            HEX_DUMP_BYTES_PER_LINE)))
+        {
+            run++;
+            continue;
+        }
+
+        if (0U < run)
+        {
+            flush_run(config, line, run);
+            run = 0U;
+            lines++;
+        }
+
+        config->write(line, format_line(config, line,
+                                        config->base_offset + index,
+                                        &buf[index], count));
+        lines++;
+    }
+
+    if (0U < run)
+    {
+        flush_run(config, line, run);
+        lines++;
+    }
+
+    return lines;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * File Name        : hex_dump.h
+ *
+ * Description      : This file is the public interface of hex_dump.c which
+ *                    formats buffers as hex dump lines for the console.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _HEX_DUMP_H_
+#define _HEX_DUMP_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define HEX_DUMP_BYTES_PER_LINE             (16U)
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+/* Receives one complete line, including the line ending */
+typedef void (*hex_dump_write_t)(const char *line, uint32_t length);
+
+typedef struct
+{
+    uint32_t            base_offset;    /* Offset printed for the first byte */
+    bool                show_offset;
+    bool                show_ascii;
+    bool                collapse;       /* Collapse runs of identical lines */
+    hex_dump_write_t    write;
+} hex_dump_config_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void hex_dump_get_default_config(hex_dump_config_t *config);
+uint32_t hex_dump(const hex_dump_config_t *config, const uint8_t *buf,
+                    uint32_t size);
+
+#endif /* _HEX_DUMP_H_ */
+
+/* [] END OF FILE */
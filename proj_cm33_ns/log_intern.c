@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * File Name        : log_intern.c
+ *
+ * Description      : This file encodes interned log messages as binary frames
+ *                    and writes them to the debug UART.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "log_intern.h"
+#include "cybsp.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define LEB128_PAYLOAD_BITS                 (7U)
+#define LEB128_PAYLOAD_MASK                 (0x7FU)
+#define LEB128_CONTINUE                     (0x80U)
+#define BYTE_MASK                           (0xFFU)
+#define BITS_PER_BYTE                       (8U)
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: log_intern_encode
+ *******************************************************************************
+ *
+ * Summary:
+ *  Encodes a message into a frame. Arguments are written as unsigned LEB128
+ *  so that small values take a single byte.
+ *
+ * Parameters:
+ *  frame - buffer of LOG_INTERN_MAX_FRAME_SIZE bytes.
+ *  id - offset of the format string in the log_strings section.
+ *  argc - number of arguments, at most LOG_INTERN_MAX_ARGS.
+ *  args - arguments of the format string.
+ *
+ * Return:
+ *  uint32_t - length of the frame
+ *
+ ******************************************************************************/
+uint32_t log_intern_encode(uint8_t *frame, uint32_t id, uint32_t argc,
+                            const uint32_t *args)
+{
+    uint32_t length = 0U;
+    uint32_t value;
+
+    argc = (argc > LOG_INTERN_MAX_ARGS) ? LOG_INTERN_MAX_ARGS : argc;
+
+    frame[length++] = LOG_INTERN_SYNC;
+    frame[length++] = (uint8_t)(id & BYTE_MASK);
+    frame[length++] = (uint8_t)((id >> BITS_PER_BYTE) & BYTE_MASK);
+    frame[length++] = (uint8_t)argc;
+
+    for (uint32_t index = 0U; index < argc; index++)
+    {
+        value = args[index];
+
+        while (value > LEB128_PAYLOAD_MASK)
+        {
+            frame[length++] = (uint8_t)((value & LEB128_PAYLOAD_MASK) |
+                                        LEB128_CONTINUE);
+            value >>= LEB128_PAYLOAD_BITS;
+        }
+
+        frame[length++] = (uint8_t)value;
+    }
+
+    return length;
+}
+
+/*******************************************************************************
+ * Function Name: log_intern_send
+ *******************************************************************************
+ *
+ * Summary:
+ *  Encodes a message and writes the frame to the debug UART. Pending console
+ *  text is flushed first so that frames and text keep their order. The frame
+ *  bypasses retarget-io, which would expand 0x0A bytes to CR LF.
+ *
+ * Parameters:
+ *  id - offset of the format string in the log_strings section.
+ *  argc - number of arguments, at most LOG_INTERN_MAX_ARGS.
+ *  args - arguments of the format string.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void log_intern_send(uint32_t id, uint32_t argc, const uint32_t *args)
+{
+    uint8_t frame[LOG_INTERN_MAX_FRAME_SIZE];
+    uint32_t length;
+
+    /* The frame has room for a 16-bit ID only */
+    CY_ASSERT(id <= LOG_INTERN_MAX_ID);
+
+    length = log_intern_encode(frame, id, argc, args);
+
+    (void)fflush(stdout);
+    Cy_SCB_UART_PutArrayBlocking(CYBSP_DEBUG_UART_HW, frame, length);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * File Name        : log_intern.h
+ *
+ * Description      : This file is the public interface of log_intern.c which
+ *                    sends log messages as binary frames that reference format
+ *                    strings kept only in the ELF file.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _LOG_INTERN_H_
+#define _LOG_INTERN_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Set to 1U to send LOG_INTERNn() messages as binary frames that are decoded
+ * on the host by tools/log_decode. With 0U they are printed as text.
+ * Arguments are sent as 32-bit words: conversions are limited to 32-bit
+ * integers and to %s of strings in the flash image.
+ */
+#ifndef LOG_INTERN_ENABLE
+#define LOG_INTERN_ENABLE                   (0U)
+#endif
+
+/* First byte of every frame; never part of the ASCII console text */
+#define LOG_INTERN_SYNC                     (0xA5U)
+
+/* Frame: sync, 16-bit string ID, argument count, LEB128 arguments */
+#define LOG_INTERN_MAX_ARGS                 (4U)
+#define LOG_INTERN_MAX_FRAME_SIZE           (4U + (5U * LOG_INTERN_MAX_ARGS))
+#define LOG_INTERN_MAX_ID                   (0xFFFFU)
+
+/* Format strings are placed in a section without the alloc flag: they stay in
+ * the ELF file for the decoder but take no space in the flash image. The
+ * section flags GCC appends are turned into a comment by the trailing "@",
+ * the comment character of the Arm assembler. The ID of a string is its
+ * offset from __start_log_strings, which the linker defines for the section
+ * whatever its address. The section must stay below 64 KiB; log_decode.py
+ * refuses larger ones and log_intern_send() asserts on larger IDs.
+ */
+#if (LOG_INTERN_ENABLE) && defined(__GNUC__) && !defined(__ARMCC_VERSION)
+#define LOG_INTERN_ACTIVE                   (1U)
+#define LOG_INTERN_SECTION                  \
+    __attribute__((section("log_strings,\"\",%progbits @")))
+#else
+#define LOG_INTERN_ACTIVE                   (0U)
+#endif
+
+#if (LOG_INTERN_ACTIVE)
+/* Pointers, for %s, are sent as their address */
+#define LOG_INTERN_ARG(x)                   ((uint32_t)(uintptr_t)(x))
+#define LOG_INTERN_ID(fmt)                  \
+    ((uint32_t)((fmt) - __start_log_strings))
+
+#define LOG_INTERN_SEND(fmt, argc, ...)                                     \
+    do                                                                      \
+    {                                                                       \
+        static const char LOG_INTERN_SECTION log_intern_fmt[] = fmt;        \
+        const uint32_t log_intern_args[] = { __VA_ARGS__ };                 \
+        log_intern_send(LOG_INTERN_ID(log_intern_fmt), (argc),              \
+                        log_intern_args);                                   \
+    } while (0)
+
+#define LOG_INTERN0(fmt)                    LOG_INTERN_SEND(fmt, 0U, 0U)
+#define LOG_INTERN1(fmt, a)                 \
+    LOG_INTERN_SEND(fmt, 1U, LOG_INTERN_ARG(a))
+#define LOG_INTERN2(fmt, a, b)              \
+    LOG_INTERN_SEND(fmt, 2U, LOG_INTERN_ARG(a), LOG_INTERN_ARG(b))
+#define LOG_INTERN3(fmt, a, b, c)           \
+    LOG_INTERN_SEND(fmt, 3U, LOG_INTERN_ARG(a), LOG_INTERN_ARG(b), \
+                    LOG_INTERN_ARG(c))
+#define LOG_INTERN4(fmt, a, b, c, d)        \
+    LOG_INTERN_SEND(fmt, 4U, LOG_INTERN_ARG(a), LOG_INTERN_ARG(b), \
+                    LOG_INTERN_ARG(c), LOG_INTERN_ARG(d))
+#else
+#define LOG_INTERN0(fmt)                    (void)printf(fmt)
+#define LOG_INTERN1(fmt, a)                 (void)printf(fmt, a)
+#define LOG_INTERN2(fmt, a, b)              (void)printf(fmt, a, b)
+#define LOG_INTERN3(fmt, a, b, c)           (void)printf(fmt, a, b, c)
+#define LOG_INTERN4(fmt, a, b, c, d)        (void)printf(fmt, a, b, c, d)
+#endif /* (LOG_INTERN_ACTIVE) */
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+#if (LOG_INTERN_ACTIVE)
+/* Start of the format string section, defined by the linker */
+extern const char __start_log_strings[];
+#endif
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void log_intern_send(uint32_t id, uint32_t argc, const uint32_t *args);
+uint32_t log_intern_encode(uint8_t *frame, uint32_t id, uint32_t argc,
+                            const uint32_t *args);
+
+#endif /* _LOG_INTERN_H_ */
+
+/* [] END OF FILE */
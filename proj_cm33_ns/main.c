@@ -39,6 +39,32 @@
 #include "retarget_io_init.h"
 #include "cycfg_qspi_memslot.h"
 #include "mtb_serial_memory.h"
+#include "flash_energy.h"
+#include "flash_bench.h"
+#include "flash_bench_cont_read.h"
+#include "flash_bench_read_merge.h"
+#include "flash_bench_resume.h"
+#include "flash_bench_hex_dump.h"
+#include "flash_bench_fifo.h"
+#include "flash_bench_crc_table.h"
+#include "flash_bench_lazy_verify.h"
+#include "flash_bench_multi.h"
+#include "flash_bench_bulk.h"
+#include "flash_bench_sparse.h"
+#include "flash_bench_config.h"
+#include "flash_bench_energy.h"
+#include "flash_dpd.h"
+#include "flash_syspm.h"
+#include "hex_dump.h"
+#include "deferred_log.h"
+#include "log_intern.h"
+#include "flash_qual.h"
+#include "sensor_log.h"
+#include "flash_tune.h"
+#include "flash_verify.h"
+#include "shared_mem.h"
+#include "mem_compare.h"
+#include "perf_counter.h"
 #include <inttypes.h>
 #include <string.h>
 
@@ -60,9 +86,6 @@
 /* Memory Read/Write size */
 #define PACKET_SIZE                         (64U)
 
-/* Used when array of data is printed on the console */
-#define NUM_BYTES_PER_LINE                  (16U)
-
 /* Slot number of the memory to use */
 #define MEM_SLOT_NUM                        (0U)      
 #define MEM_SLOT_DIVIDER                    (2U)
@@ -78,8 +101,70 @@
 #define TIMEOUT_1_MS                        (1000U)   
 
 #define SUCCESS_STATUS                      (0U)
-#define ARR_PRINT_LINE_CHECK                (0U)
-#define ARR_PRINT_LINE_DIVIDER              (1U)
+
+#define USEC_PER_MSEC                       (1000U)
+
+/* While the memory is powered down when idle, the test packet is read back
+ * through flash_dpd_read() every DPD_CHECK_PERIOD_MSEC, which wakes it, and
+ * the deep power-down statistics are printed every DPD_STATS_PERIOD_MSEC.
+ */
+#define DPD_CHECK_PERIOD_MSEC               (5000U)
+#define DPD_STATS_PERIOD_MSEC               (60000U)
+
+/* Regions of the qualification plan, in sectors around the test sector */
+#define QUAL_REGION_COUNT                   (3U)
+#define QUAL_SEED_A                         (0x5EED0001UL)
+#define QUAL_SEED_B                         (0x5EED0002UL)
+
+/* Time given to the CM55 to publish its XIP benchmark results */
+#define XIP_REPORT_TIMEOUT_MSEC             (1000U)
+#define XIP_REPORT_POLL_MSEC                (1U)
+
+/* Sector of the CRC side table, below the sensor log */
+#define CRC_TABLE_SECTOR                    (7U)
+
+/* Sensor log region, below the sectors used by the benchmarks */
+#define SENSOR_LOG_FIRST_SECTOR             (6U)
+#define SENSOR_LOG_SECTORS                  (4U)
+#define SENSOR_LOG_DURATION_USEC            (2000000U)
+
+/* Sector holding the tuned chunk sizes, also used for the calibration */
+#define TUNE_SECTOR                         (8U)
+#define TUNE_RAM_BUDGET                     (1024U)
+
+/* Second memory of the multi-device benchmark, on the other chip select.
+ * Each device gets the same sectors, below the tune sector.
+ */
+#define MULTI_SLOT_NUM                      (1U)
+#define MULTI_FIRST_SECTOR                  (12U)
+#define MULTI_SECTORS                       (4U)
+
+/* Sector programmed by the bulk programming benchmark */
+#define BULK_SECTOR                         (13U)
+
+/* Sector programmed by the sparse image benchmark */
+#define SPARSE_SECTOR                       (14U)
+
+/* Two sectors used by the config store benchmark, the lower one first */
+#define CONFIG_FIRST_SECTOR                 (16U)
+
+/* Sector written through the CRC side table by its benchmark */
+#define CRC_REGION_SECTOR                   (17U)
+
+/* Sector logged into by the energy benchmark */
+#define ENERGY_SECTOR                       (18U)
+
+/* Low-power timer that wakes the CPU from sleep and deep sleep in the resume
+ * and energy benchmarks: counter 0 matches every ~1 ms of the 32768 Hz clock
+ */
+#if (FLASH_BENCHMARK_ENABLE) && defined(CYBSP_CM33_LPTIMER_0_HW)
+#define WAKE_TIMER_ENABLE                   (1U)
+#else
+#define WAKE_TIMER_ENABLE                   (0U)
+#endif
+#define WAKE_TIMER_MATCH                    (33U)
+#define WAKE_TIMER_WAIT_USEC                (93U)
+#define WAKE_TIMER_IRQ_PRIORITY             (7U)
 
 /*******************************************************************************
  * Global Variables
@@ -89,6 +174,43 @@ static mtb_serial_memory_t serial_memory_obj;
 static cy_stc_smif_mem_context_t smif_mem_context;
 static cy_stc_smif_mem_info_t smif_mem_info;
 
+/* Raw command interface of the same memory */
+static flash_cmd_t flash_cmd_obj;
+
+/* State of the memory saved across deep sleep */
+static flash_syspm_t flash_syspm_obj;
+
+#if (FLASH_BENCHMARK_ENABLE)
+static flash_cont_read_t cont_read_obj;
+static flash_read_merge_t read_merge_obj;
+#endif /* (FLASH_BENCHMARK_ENABLE) */
+
+#if (FLASH_DPD_ENABLE)
+static flash_dpd_t dpd_obj;
+#endif /* (FLASH_DPD_ENABLE) */
+
+#if (FLASH_QUAL_ENABLE)
+static flash_bank_t qual_bank_obj;
+static flash_qual_t qual_obj;
+static flash_qual_region_t qual_regions[QUAL_REGION_COUNT];
+#endif /* (FLASH_QUAL_ENABLE) */
+
+#if (SENSOR_PIPE_ENABLE)
+static sensor_log_t sensor_log_obj;
+#endif /* (SENSOR_PIPE_ENABLE) */
+
+#if (FLASH_BENCHMARK_ENABLE) && (FLASH_MULTI_ENABLE)
+static mtb_serial_memory_t multi_memory_obj;
+static cy_stc_smif_mem_context_t multi_mem_context;
+static cy_stc_smif_mem_info_t multi_mem_info;
+static flash_cmd_t multi_cmd_obj;
+#endif /* (FLASH_BENCHMARK_ENABLE) && (FLASH_MULTI_ENABLE) */
+
+#if (FLASH_TUNE_ENABLE)
+static flash_tune_t tune_obj;
+static uint8_t tune_buf[TUNE_RAM_BUDGET];
+#endif /* (FLASH_TUNE_ENABLE) */
+
 /*******************************************************************************
  * Function Definitions
  ******************************************************************************/
@@ -112,10 +234,16 @@ static void check_status(char *message, uint32_t status)
 {
     if (SUCCESS_STATUS != status)
     {
-        printf("\r\n=====================================================\r\n");
-        printf("\nFAIL: %s\r\n", message);
-        printf("Error Code: 0x%08"PRIX32"\n", status);
-        printf("\r\n=====================================================\r\n");
+#if (DEFERRED_LOG_ENABLE)
+        deferred_log_flush();
+#endif /* (DEFERRED_LOG_ENABLE) */
+
+        LOG_INTERN0("\r\n====================================================="
+                    "\r\n");
+        LOG_INTERN1("\nFAIL: %s\r\n", message);
+        LOG_INTERN1("Error Code: 0x%08"PRIX32"\n", status);
+        LOG_INTERN0("\r\n====================================================="
+                    "\r\n");
 
         /* On failure, turn the LED ON */
         Cy_GPIO_Set(CYBSP_USER_LED1_PORT, CYBSP_USER_LED1_PIN);
@@ -124,12 +252,47 @@ static void check_status(char *message, uint32_t status)
     }
 }
 
+/*******************************************************************************
+ * Function Name: check_compare
+ *******************************************************************************
+ *
+ * Summary:
+ *  Prints where and by how much the data differs, then fails like
+ *  check_status() with the number of differing bytes as the status.
+ *
+ * Parameters:
+ *  message - message to print if the data differs.
+ *  diff - result of the comparison.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void check_compare(char *message, const mem_compare_t *diff)
+{
+    if (MEM_COMPARE_MATCH != diff->first)
+    {
+#if (DEFERRED_LOG_ENABLE)
+        deferred_log_flush();
+#endif /* (DEFERRED_LOG_ENABLE) */
+
+        LOG_INTERN3("\r\nFirst mismatch at offset %"PRIu32", %"PRIu32
+                    " bytes and %"PRIu32" bits differ\r\n", diff->first,
+                    diff->bytes, diff->bits);
+    }
+
+    check_status(message, diff->bytes);
+}
+
 /*******************************************************************************
  * Function Name: print_array
  *******************************************************************************
  *
  * Summary:
- *  Prints the content of the buffer to the UART console.
+ *  Prints the content of the buffer to the UART console as a hex dump with
+ *  offsets and an ASCII column. The dump bypasses the deferred log, so it is
+ *  printed only after the queued messages have been flushed, outside the
+ *  timed flash sequence.
  *
  * Parameters:
  *  message - message to print before array output.
@@ -142,20 +305,251 @@ static void check_status(char *message, uint32_t status)
  ******************************************************************************/
 static void print_array(char *message, uint8_t *buf, uint32_t size)
 {
+    hex_dump_config_t config;
+
     printf("\r\n%s (%"PRIu32" bytes):\r\n", message, size);
     printf("-------------------------\r\n");
 
-    for (uint32_t index = 0; index < size; index++)
+    hex_dump_get_default_config(&config);
+    (void)hex_dump(&config, buf, size);
+}
+
+/*******************************************************************************
+ * Function Name: setup_serial_memory
+ *******************************************************************************
+ *
+ * Summary:
+ *  Sets up the serial memory object for the memory in slot MEM_SLOT_NUM.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  cy_rslt_t - result of mtb_serial_memory_setup()
+ *
+ ******************************************************************************/
+static cy_rslt_t setup_serial_memory(void)
+{
+    return mtb_serial_memory_setup(&serial_memory_obj, 
+                                MTB_SERIAL_MEMORY_CHIP_SELECT_1, 
+                                CYBSP_SMIF_CORE_0_XSPI_FLASH_hal_config.base,
+                                CYBSP_SMIF_CORE_0_XSPI_FLASH_hal_config.clock,
+                                &smif_mem_context, 
+                                &smif_mem_info,
+                                &smif0BlockConfig);
+}
+
+#if (WAKE_TIMER_ENABLE)
+/*******************************************************************************
+ * Function Name: wake_timer_isr
+ *******************************************************************************
+ *
+ * Summary:
+ *  Clears the match interrupt of the wake-up timer.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void wake_timer_isr(void)
+{
+    Cy_MCWDT_ClearInterrupt(CYBSP_CM33_LPTIMER_0_HW, CY_MCWDT_CTR0);
+}
+
+/*******************************************************************************
+ * Function Name: wake_timer
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts or stops the periodic low-power timer interrupt that wakes the CPU
+ *  from sleep and deep sleep in the resume and energy benchmarks.
+ *
+ * Parameters:
+ *  enable - true to start the timer, false to stop it.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void wake_timer(bool enable)
+{
+    static const cy_stc_sysint_t irq_config =
     {
-        printf("0x%02X ", buf[index]);
+        .intrSrc = CYBSP_CM33_LPTIMER_0_IRQ,
+        .intrPriority = WAKE_TIMER_IRQ_PRIORITY
+    };
 
-        if (ARR_PRINT_LINE_CHECK == 
-            ((index + ARR_PRINT_LINE_DIVIDER) % NUM_BYTES_PER_LINE))
-        {
-            printf("\r\n");
-        }
+    if (enable)
+    {
+        (void)Cy_MCWDT_Init(CYBSP_CM33_LPTIMER_0_HW,
+                            &CYBSP_CM33_LPTIMER_0_config);
+        Cy_MCWDT_SetMatch(CYBSP_CM33_LPTIMER_0_HW, CY_MCWDT_COUNTER0,
+                            WAKE_TIMER_MATCH, WAKE_TIMER_WAIT_USEC);
+        (void)Cy_SysInt_Init(&irq_config, &wake_timer_isr);
+        NVIC_EnableIRQ(irq_config.intrSrc);
+        Cy_MCWDT_SetInterruptMask(CYBSP_CM33_LPTIMER_0_HW, CY_MCWDT_CTR0);
+        Cy_MCWDT_Enable(CYBSP_CM33_LPTIMER_0_HW, CY_MCWDT_CTR0,
+                        WAKE_TIMER_WAIT_USEC);
+    }
+    else
+    {
+        Cy_MCWDT_Disable(CYBSP_CM33_LPTIMER_0_HW, CY_MCWDT_CTR0,
+                            WAKE_TIMER_WAIT_USEC);
+        Cy_MCWDT_SetInterruptMask(CYBSP_CM33_LPTIMER_0_HW, 0U);
+        NVIC_DisableIRQ(irq_config.intrSrc);
+    }
+}
+#endif /* (WAKE_TIMER_ENABLE) */
+
+#if (XIP_BENCH_ENABLE)
+/*******************************************************************************
+ * Function Name: print_xip_report
+ *******************************************************************************
+ *
+ * Summary:
+ *  Waits for the XIP benchmark of the CM55 and prints its results.
+ *
+ * Parameters:
+ *  report - report in the shared memory, cleared before the CM55 started.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void print_xip_report(const xip_report_t *report)
+{
+    static const char * const pattern_names[XIP_REPORT_PATTERN_COUNT] =
+    {
+        "Sequential",
+        "Strided   "
+    };
+    uint32_t waited = 0U;
+
+    while ((XIP_REPORT_MAGIC != report->magic) &&
+            (waited < XIP_REPORT_TIMEOUT_MSEC))
+    {
+        Cy_SysLib_Delay(XIP_REPORT_POLL_MSEC);
+        waited += XIP_REPORT_POLL_MSEC;
+    }
+
+    printf("\r\nCM55 XIP reads:\r\n");
+    printf("-------------------------\r\n");
+
+    if (XIP_REPORT_MAGIC != report->magic)
+    {
+        printf("No results from the CM55\r\n");
+        return;
+    }
+
+    printf("%"PRIu32"-byte table, %"PRIu32"-byte lines, stride %"PRIu32
+            " bytes, prefetch %"PRIu32" lines ahead\r\n", report->table_size,
+            report->line_size, report->stride, report->prefetch_lines);
+
+    for (uint32_t pattern = 0U; pattern < XIP_REPORT_PATTERN_COUNT; pattern++)
+    {
+        const xip_report_result_t *result = &report->results[pattern];
+
+        printf("%s: %"PRIu32" lines, plain %"PRIu32" ns/line, prefetch %"
+                PRIu32" ns/line\r\n", pattern_names[pattern], result->lines,
+                result->plain_nsec / result->lines,
+                result->prefetch_nsec / result->lines);
+    }
+}
+#endif /* (XIP_BENCH_ENABLE) */
+
+#if (FLASH_BENCHMARK_ENABLE) && (FLASH_MULTI_ENABLE)
+/*******************************************************************************
+ * Function Name: bench_multi_device
+ *******************************************************************************
+ *
+ * Summary:
+ *  Sets up the memory in slot MULTI_SLOT_NUM and compares writes striped
+ *  across both memories with writes to the first one only. Skipped when the
+ *  board has a single memory.
+ *
+ * Parameters:
+ *  address - start of the sectors used on each memory.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void bench_multi_device(uint32_t address)
+{
+    flash_multi_device_t devices[FLASH_MULTI_MAX_DEVICES];
+    cy_rslt_t result;
+
+    if (smif0BlockConfig.memCount <= MULTI_SLOT_NUM)
+    {
+        printf("\r\nMulti-device write: no memory in slot %u\r\n",
+                (unsigned int)MULTI_SLOT_NUM);
+        return;
+    }
+
+    result = mtb_serial_memory_setup(&multi_memory_obj,
+                                MTB_SERIAL_MEMORY_CHIP_SELECT_2,
+                                CYBSP_SMIF_CORE_0_XSPI_FLASH_hal_config.base,
+                                CYBSP_SMIF_CORE_0_XSPI_FLASH_hal_config.clock,
+                                &multi_mem_context,
+                                &multi_mem_info,
+                                &smif0BlockConfig);
+    check_status("Second serial memory setup failed", result);
+
+    flash_cmd_init(&multi_cmd_obj,
+                    CYBSP_SMIF_CORE_0_XSPI_FLASH_hal_config.base,
+                    &multi_memory_obj.context,
+                    smifMemConfigs[MULTI_SLOT_NUM]);
+
+    devices[0U].mem = &serial_memory_obj;
+    devices[0U].cmd = &flash_cmd_obj;
+    devices[0U].base = address;
+    devices[1U].mem = &multi_memory_obj;
+    devices[1U].cmd = &multi_cmd_obj;
+    devices[1U].base = address;
+
+    flash_bench_multi(devices, 2U, MULTI_SECTORS);
+}
+#endif /* (FLASH_BENCHMARK_ENABLE) && (FLASH_MULTI_ENABLE) */
+
+#if (FLASH_TUNE_ENABLE)
+/*******************************************************************************
+ * Function Name: tune_transfers
+ *******************************************************************************
+ *
+ * Summary:
+ *  Applies the chunk sizes stored in the tune sector. When none are stored,
+ *  the chunk sizes are calibrated in that sector and stored there.
+ *
+ * Parameters:
+ *  address - start of the tune sector.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void tune_transfers(uint32_t address)
+{
+    cy_rslt_t result = flash_tune_load(&tune_obj, &serial_memory_obj,
+                                        address);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        result = flash_tune_calibrate(&tune_obj, &serial_memory_obj, address,
+                                        tune_buf, sizeof(tune_buf),
+                                        FLASH_TUNE_TARGET_PERCENT);
+        check_status("Chunk size calibration failed", result);
+
+        result = flash_tune_save(&tune_obj, &serial_memory_obj, address);
+        check_status("Saving tuned chunk sizes failed", result);
     }
+
+    flash_tune_apply(&tune_obj);
+    flash_tune_print_report(&tune_obj);
 }
+#endif /* (FLASH_TUNE_ENABLE) */
 
 /*******************************************************************************
  * Function Name: main
@@ -179,8 +573,18 @@ int main(void)
     cy_rslt_t result;
     uint8_t tx_buf[PACKET_SIZE];
     uint8_t rx_buf[PACKET_SIZE];
+    mem_compare_t diff;
+    uint32_t chunk;
+    uint32_t chunk_size;
     uint32_t ext_mem_address;
     size_t sectorSize;
+#if (FLASH_DPD_ENABLE)
+    uint32_t uptime_ms = 0U;
+    bool dpd_active;
+#endif /* (FLASH_DPD_ENABLE) */
+#if (FLASH_ENERGY_MEASUREMENT_ENABLE)
+    flash_energy_idle_state_t idle_state = FLASH_ENERGY_IDLE_STANDBY;
+#endif /* (FLASH_ENERGY_MEASUREMENT_ENABLE) */
 
     /* Initialize the device and board peripherals */
     result = cybsp_init();
@@ -204,17 +608,24 @@ int main(void)
     printf("PSOC Edge MCU: Serial Flash Read and Write Test");
     printf("**************\r\n");
 
+#if (FLASH_ENERGY_MEASUREMENT_ENABLE)
+    /* Use the default power model of flash_energy.h */
+    flash_energy_init(NULL);
+#endif /* (FLASH_ENERGY_MEASUREMENT_ENABLE) */
+
     /* Set-up serial memory. */
-    result = mtb_serial_memory_setup(&serial_memory_obj, 
-                                MTB_SERIAL_MEMORY_CHIP_SELECT_1, 
-                                CYBSP_SMIF_CORE_0_XSPI_FLASH_hal_config.base,
-                                CYBSP_SMIF_CORE_0_XSPI_FLASH_hal_config.clock,
-                                &smif_mem_context, 
-                                &smif_mem_info,
-                                &smif0BlockConfig);
+    result = setup_serial_memory();
 
     check_status("Serial memory setup failed", result);
 
+    flash_cmd_init(&flash_cmd_obj,
+                    CYBSP_SMIF_CORE_0_XSPI_FLASH_hal_config.base,
+                    &serial_memory_obj.context,
+                    smifMemConfigs[MEM_SLOT_NUM]);
+
+    /* Keep the memory usable across deep sleep without a new set-up */
+    flash_syspm_init(&flash_syspm_obj, &flash_cmd_obj);
+
     /* Use last sector to erase for flash operation */
     ext_mem_address = (smifMemConfigs[MEM_SLOT_NUM]->deviceCfg->memSize/
                         MEM_SLOT_DIVIDER - 
@@ -223,35 +634,42 @@ int main(void)
 
     sectorSize = mtb_serial_memory_get_erase_size(&serial_memory_obj, 
                                                     ext_mem_address);
-    printf("\r\nTotal Flash Size: %u bytes\r\n",
-            mtb_serial_memory_get_size(&serial_memory_obj));
+    DEFERRED_LOG1("\r\nTotal Flash Size: %"PRIu32" bytes\r\n",
+                    mtb_serial_memory_get_size(&serial_memory_obj));
+
+#if (FLASH_TUNE_ENABLE)
+    tune_transfers(ext_mem_address - (TUNE_SECTOR * sectorSize));
+#endif /* (FLASH_TUNE_ENABLE) */
 
     /* Erase before write */
-    printf("\r\n1. Erasing %u bytes from offset address 0x%"PRIx32"\r\n", 
-            sectorSize, ext_mem_address);
+    DEFERRED_LOG2("\r\n1. Erasing %"PRIu32" bytes from offset address "
+                    "0x%"PRIx32"\r\n", sectorSize, ext_mem_address);
 
+    FLASH_ENERGY_BEGIN();
     result = mtb_serial_memory_erase(&serial_memory_obj, 
                                     ext_mem_address, 
                                     sectorSize);
+    FLASH_ENERGY_END(FLASH_ENERGY_OP_ERASE, sectorSize);
 
     check_status("Erasing memory failed", result);
 
     /* Read after Erase to confirm that all data is 0xFF */
-    printf("\r\n2. Reading after Erase & verifying that each byte is 0xFF\r\n");
+    DEFERRED_LOG0("\r\n2. Reading after Erase & verifying that each byte is "
+                    "0xFF\r\n");
     
-    result = mtb_serial_memory_read(&serial_memory_obj, 
+    FLASH_ENERGY_BEGIN();
+    result = flash_tune_read(&serial_memory_obj, 
                                     ext_mem_address, 
                                     PACKET_SIZE, 
                                     rx_buf);
+    FLASH_ENERGY_END(FLASH_ENERGY_OP_READ, PACKET_SIZE);
 
     check_status("Reading memory failed", result);
     
-    print_array("Received Data", rx_buf, PACKET_SIZE);
-    
     memset(tx_buf, FLASH_DATA_AFTER_ERASE, PACKET_SIZE);
     
-    check_status("Flash contains data other than 0xFF after erase",
-                    memcmp(tx_buf, rx_buf, PACKET_SIZE));
+    mem_compare(&diff, rx_buf, tx_buf, PACKET_SIZE);
+    check_compare("Flash contains data other than 0xFF after erase", &diff);
 
     /* Prepare the TX buffer */
     for (uint32_t index = 0; index < PACKET_SIZE; index++)
@@ -260,46 +678,253 @@ int main(void)
     }
 
     /* Write the content of the TX buffer to the memory */
-    printf("\r\n3. Writing data to offset address 0x%"PRIx32"\r\n", 
-                                                    ext_mem_address);
+    DEFERRED_LOG1("\r\n3. Writing data to offset address 0x%"PRIx32"\r\n",
+                    ext_mem_address);
     
-    result = mtb_serial_memory_write(&serial_memory_obj, 
+    FLASH_ENERGY_BEGIN();
+    result = flash_tune_write(&serial_memory_obj, 
                                     ext_mem_address, 
                                     PACKET_SIZE, 
                                     tx_buf);
+    FLASH_ENERGY_END(FLASH_ENERGY_OP_WRITE, PACKET_SIZE);
 
     check_status("Writing to memory failed", result);
-    
-    print_array("Written Data", tx_buf, PACKET_SIZE);
 
     /* Read back after Write for verification */
-    printf("\r\n4. Reading back for verification\r\n");
+    DEFERRED_LOG0("\r\n4. Reading back for verification\r\n");
     
-    result = mtb_serial_memory_read(&serial_memory_obj, 
-                                    ext_mem_address, 
-                                    PACKET_SIZE, 
-                                    rx_buf);
+    /* Each chunk is compared with the TX buffer as soon as it is read */
+    FLASH_ENERGY_BEGIN();
+    result = flash_verify(&serial_memory_obj, 
+                            ext_mem_address, 
+                            tx_buf, 
+                            PACKET_SIZE, 
+                            &diff);
+    FLASH_ENERGY_END(FLASH_ENERGY_OP_READ, PACKET_SIZE);
     
     check_status("Reading memory failed", result);
-    
+
+    if (MEM_COMPARE_MATCH != diff.first)
+    {
+        /* The verify keeps no copy of the data; read the chunk holding the
+         * first mismatch again to show what the memory returned.
+         */
+        chunk = diff.first - (diff.first % FLASH_VERIFY_CHUNK_SIZE);
+        chunk_size = ((PACKET_SIZE - chunk) < FLASH_VERIFY_CHUNK_SIZE) ?
+                        (PACKET_SIZE - chunk) : FLASH_VERIFY_CHUNK_SIZE;
+
+        if (CY_RSLT_SUCCESS == mtb_serial_memory_read(&serial_memory_obj,
+                                                ext_mem_address + chunk,
+                                                chunk_size, rx_buf))
+        {
+#if (DEFERRED_LOG_ENABLE)
+            deferred_log_flush();
+#endif /* (DEFERRED_LOG_ENABLE) */
+            printf("\r\nMismatching chunk at offset %"PRIu32":", chunk);
+            print_array("Received Data", rx_buf, chunk_size);
+        }
+    }
+
+    check_compare("Read data does not match with written data. Read/Write "
+            "operation failed.", &diff);
+
+#if (DEFERRED_LOG_ENABLE)
+    deferred_log_flush();
+#endif /* (DEFERRED_LOG_ENABLE) */
+
+    /* The buffers are left as steps 2 and 3 used them; dump them now that
+     * the flash sequence is over.
+     */
     print_array("Received Data", rx_buf, PACKET_SIZE);
+    print_array("Written Data", tx_buf, PACKET_SIZE);
+
+    LOG_INTERN0("\r\n========================================================="
+                "\r\n");
+    LOG_INTERN0("\r\nSUCCESS: Read data matches with written data!\r\n");
+    LOG_INTERN0("\r\n========================================================="
+                "\r\n");
+
+#if (FLASH_ENERGY_MEASUREMENT_ENABLE)
+    flash_energy_print_report();
+#endif /* (FLASH_ENERGY_MEASUREMENT_ENABLE) */
+
+#if (FLASH_BENCHMARK_ENABLE)
+    flash_bench_init();
+
+    if (CY_SMIF_SUCCESS == flash_cont_read_init(&cont_read_obj, &flash_cmd_obj))
+    {
+        flash_bench_cont_read(&serial_memory_obj, &cont_read_obj,
+                                ext_mem_address, sectorSize);
+    }
+    else
+    {
+        printf("\r\nContinuous read skipped: no mode phase or memory is "
+                "memory-mapped\r\n");
+    }
 
-    /* Check if the transmitted and received arrays are equal */
-    check_status("Read data does not match with written data. Read/Write "
-            "operation failed.", memcmp(tx_buf, rx_buf, PACKET_SIZE));
+    flash_read_merge_init(&read_merge_obj, &serial_memory_obj);
+    flash_bench_read_merge(&serial_memory_obj, &read_merge_obj,
+                            ext_mem_address);
+#if (WAKE_TIMER_ENABLE)
+    flash_bench_resume(&serial_memory_obj, &flash_syspm_obj,
+                        &setup_serial_memory, &wake_timer, ext_mem_address);
+#else
+    flash_bench_resume(&serial_memory_obj, &flash_syspm_obj,
+                        &setup_serial_memory, NULL, ext_mem_address);
+#endif /* (WAKE_TIMER_ENABLE) */
+    flash_bench_hex_dump();
+    flash_bench_fifo(&serial_memory_obj, ext_mem_address - (2U * sectorSize),
+                        2U * sectorSize);
+    flash_bench_crc_table(&serial_memory_obj,
+                            ext_mem_address - (CRC_REGION_SECTOR * sectorSize),
+                            sectorSize,
+                            ext_mem_address - (CRC_TABLE_SECTOR * sectorSize));
+    flash_bench_lazy_verify(&serial_memory_obj, ext_mem_address - sectorSize);
+    flash_bench_bulk(&serial_memory_obj, &flash_cmd_obj,
+                        ext_mem_address - (BULK_SECTOR * sectorSize),
+                        sectorSize);
+    flash_bench_sparse(&serial_memory_obj,
+                        ext_mem_address - (SPARSE_SECTOR * sectorSize),
+                        sectorSize);
+    flash_bench_config(&serial_memory_obj,
+                        ext_mem_address - (CONFIG_FIRST_SECTOR * sectorSize));
+#if (WAKE_TIMER_ENABLE)
+    flash_bench_energy(&serial_memory_obj, &flash_cmd_obj, &wake_timer,
+                        ext_mem_address - (ENERGY_SECTOR * sectorSize),
+                        sectorSize);
+#else
+    flash_bench_energy(&serial_memory_obj, &flash_cmd_obj, NULL,
+                        ext_mem_address - (ENERGY_SECTOR * sectorSize),
+                        sectorSize);
+#endif /* (WAKE_TIMER_ENABLE) */
+#if (FLASH_MULTI_ENABLE)
+    bench_multi_device(ext_mem_address - (MULTI_FIRST_SECTOR * sectorSize));
+#endif /* (FLASH_MULTI_ENABLE) */
+#endif /* (FLASH_BENCHMARK_ENABLE) */
+
+#if (FLASH_QUAL_ENABLE)
+    /* Two sectors are programmed and verified while a third is erased and
+     * blank-checked; the test sector itself is left alone.
+     */
+    flash_bank_init(&qual_bank_obj, &flash_cmd_obj, FLASH_BANK_COUNT);
+    flash_qual_region_init(&qual_regions[0U], ext_mem_address + sectorSize,
+                            sectorSize, FLASH_QUAL_OP_ALL, QUAL_SEED_A);
+    flash_qual_region_init(&qual_regions[1U], ext_mem_address - sectorSize,
+                            sectorSize, FLASH_QUAL_OP_ALL, QUAL_SEED_B);
+    flash_qual_region_init(&qual_regions[2U],
+                            ext_mem_address - (2U * sectorSize), sectorSize,
+                            FLASH_QUAL_OP_ERASE | FLASH_QUAL_OP_VERIFY, 0U);
+
+    if (CY_SMIF_SUCCESS == flash_qual_init(&qual_obj, &serial_memory_obj,
+                                            &qual_bank_obj, qual_regions,
+                                            QUAL_REGION_COUNT))
+    {
+        (void)flash_qual_run(&qual_obj);
+        flash_qual_print_report(&qual_obj);
+    }
+#endif /* (FLASH_QUAL_ENABLE) */
 
-    printf("\r\n=========================================================\r\n");
-    printf("\r\nSUCCESS: Read data matches with written data!\r\n");
-    printf("\r\n=========================================================\r\n");
+#if (XIP_BENCH_ENABLE)
+    memset(&shared_mem.xip_report, 0, sizeof(shared_mem.xip_report));
+#endif /* (XIP_BENCH_ENABLE) */
+
+#if (SENSOR_PIPE_ENABLE)
+    /* The CM55 waits for the pipe to be initialized */
+    sensor_pipe_init(&shared_mem.sensor_pipe);
+#endif /* (SENSOR_PIPE_ENABLE) */
 
     /* Enable CM55. */
     /* CM55_APP_BOOT_ADDR must be updated if CM55 memory layout is changed.*/
     Cy_SysEnableCM55(MXCM55, CM55_APP_BOOT_ADDR, CM55_BOOT_WAIT_TIME_USEC);
 
+#if (XIP_BENCH_ENABLE)
+    /* No flash operations until the CM55 has measured its reads */
+    print_xip_report(&shared_mem.xip_report);
+#endif /* (XIP_BENCH_ENABLE) */
+
+#if (SENSOR_PIPE_ENABLE)
+    perf_counter_init();
+    result = sensor_log_init(&sensor_log_obj, &shared_mem.sensor_pipe,
+                                &serial_memory_obj,
+                                ext_mem_address -
+                                (SENSOR_LOG_FIRST_SECTOR * sectorSize),
+                                SENSOR_LOG_SECTORS * sectorSize);
+
+    /* The log shares the memory the CM55 executes from. The producer runs
+     * from RAM until the last page is released; see sensor_producer_run().
+     */
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = sensor_log_run(&sensor_log_obj, SENSOR_LOG_DURATION_USEC);
+        sensor_log_print_report(&sensor_log_obj);
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("\r\nSensor logging failed: 0x%08"PRIX32"\r\n",
+                (uint32_t)result);
+    }
+#endif /* (SENSOR_PIPE_ENABLE) */
+
+#if (FLASH_DPD_ENABLE)
+    /* The memory idles from here on; power it down after the timeout */
+    dpd_active = (CY_SMIF_SUCCESS == flash_dpd_init(&dpd_obj, &flash_cmd_obj,
+                                                    uptime_ms));
+
+    if (!dpd_active)
+    {
+        printf("\r\nDeep power-down skipped: memory is memory-mapped\r\n");
+    }
+#endif /* (FLASH_DPD_ENABLE) */
+
     for (;;)
     {
         Cy_GPIO_Inv(CYBSP_USER_LED1_PORT, CYBSP_USER_LED1_PIN);
         Cy_SysLib_Delay(LED_TOGGLE_DELAY_MSEC);
+
+#if (DEFERRED_LOG_ENABLE)
+        /* Print what was logged since the last toggle */
+        (void)deferred_log_drain(DEFERRED_LOG_RING_SIZE);
+#endif /* (DEFERRED_LOG_ENABLE) */
+
+#if (FLASH_DPD_ENABLE)
+        uptime_ms += LED_TOGGLE_DELAY_MSEC;
+
+        if (dpd_active)
+        {
+            if (0U == (uptime_ms % DPD_CHECK_PERIOD_MSEC))
+            {
+                result = flash_dpd_read(&dpd_obj, &serial_memory_obj,
+                                        ext_mem_address, PACKET_SIZE, rx_buf,
+                                        uptime_ms);
+                mem_compare(&diff, rx_buf, tx_buf, PACKET_SIZE);
+
+                if ((CY_RSLT_SUCCESS != result) ||
+                    (MEM_COMPARE_MATCH != diff.first))
+                {
+                    printf("\r\nIdle check failed at %"PRIu32" ms\r\n",
+                            uptime_ms);
+                }
+            }
+
+            if (0U == (uptime_ms % DPD_STATS_PERIOD_MSEC))
+            {
+                flash_dpd_print_stats(&dpd_obj);
+            }
+
+            (void)flash_dpd_poll(&dpd_obj, uptime_ms);
+        }
+#if (FLASH_ENERGY_MEASUREMENT_ENABLE)
+        idle_state = flash_dpd_is_powered_down(&dpd_obj) ?
+                        FLASH_ENERGY_IDLE_DEEP_POWER_DOWN :
+                        FLASH_ENERGY_IDLE_STANDBY;
+#endif /* (FLASH_ENERGY_MEASUREMENT_ENABLE) */
+#endif /* (FLASH_DPD_ENABLE) */
+
+#if (FLASH_ENERGY_MEASUREMENT_ENABLE)
+        flash_energy_add_idle(LED_TOGGLE_DELAY_MSEC * USEC_PER_MSEC,
+                                idle_state, FLASH_ENERGY_CPU_ACTIVE);
+#endif /* (FLASH_ENERGY_MEASUREMENT_ENABLE) */
     }
 }
 
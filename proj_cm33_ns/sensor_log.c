@@ -0,0 +1,320 @@
+/*******************************************************************************
+ * File Name        : sensor_log.c
+ *
+ * Description      : This file contains the CM33 side of the sensor logging
+ *                    pipeline: pages compressed by the CM55 are checked and
+ *                    programmed into a circular region of the serial flash.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "sensor_log.h"
+#include "crc32.h"
+#include "perf_counter.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define PERCENT                             (100U)
+#define BYTES_PER_KIB                       (1024U)
+#define USEC_PER_MSEC                       (1000U)
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: sensor_log_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Prepares logging into a region of the memory. Sectors are erased as the
+ *  log enters them, so the region does not need to be blank.
+ *
+ * Parameters:
+ *  obj - log object.
+ *  pipe - shared pipe, initialized before the CM55 was enabled.
+ *  mem - serial memory object.
+ *  base - sector-aligned start of the log region.
+ *  size - size of the log region, a multiple of the sector size.
+ *
+ * Return:
+ *  cy_rslt_t - CY_RSLT_SUCCESS, or CY_SMIF_BAD_PARAM if the region is not
+ *  made of whole sectors
+ *
+ ******************************************************************************/
+cy_rslt_t sensor_log_init(sensor_log_t *obj, sensor_pipe_t *pipe,
+                            mtb_serial_memory_t *mem, uint32_t base,
+                            uint32_t size)
+{
+    uint32_t sector_size =
+        (uint32_t)mtb_serial_memory_get_erase_size(mem, base);
+
+    if ((0U == sector_size) || (0U == size) ||
+        (0U != (base % sector_size)) || (0U != (size % sector_size)) ||
+        (0U != (sector_size % SENSOR_PIPE_PAGE_SIZE)))
+    {
+        return (cy_rslt_t)CY_SMIF_BAD_PARAM;
+    }
+
+    memset(obj, 0, sizeof(*obj));
+    obj->pipe = pipe;
+    obj->mem = mem;
+    obj->base = base;
+    obj->size = size;
+    obj->sector_size = sector_size;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: log_page
+ *******************************************************************************
+ *
+ * Summary:
+ *  Checks one page of the pipe and programs it at the head of the log.
+ *
+ * Parameters:
+ *  obj - log object.
+ *  page - page returned by sensor_pipe_peek().
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations
+ *
+ ******************************************************************************/
+static cy_rslt_t log_page(sensor_log_t *obj, const sensor_pipe_page_t *page)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t address = obj->base + obj->offset;
+    uint32_t start;
+
+    if (page->header.seq != obj->next_seq)
+    {
+        obj->stats.seq_errors++;
+    }
+    obj->next_seq = page->header.seq + 1U;
+
+    if ((page->header.length > SENSOR_PIPE_PAYLOAD_SIZE) ||
+        (page->header.crc != crc32(page->payload, page->header.length)))
+    {
+        obj->stats.crc_errors++;
+        return CY_RSLT_SUCCESS;
+    }
+
+    start = perf_counter_get();
+
+    if (0U == (obj->offset % obj->sector_size))
+    {
+        result = mtb_serial_memory_erase(obj->mem, address, obj->sector_size);
+        obj->stats.sectors_erased++;
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        /* Pages are programmed whole so that each holds its own header */
+        result = mtb_serial_memory_write(obj->mem, address,
+                                            SENSOR_PIPE_PAGE_SIZE,
+                                            (const uint8_t *)page);
+    }
+
+    obj->stats.flash_usec +=
+        perf_counter_cycles_to_usec(perf_counter_get() - start);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        obj->stats.pages_logged++;
+        obj->stats.bytes_programmed += SENSOR_PIPE_PAGE_SIZE;
+        obj->offset = (obj->offset + SENSOR_PIPE_PAGE_SIZE) % obj->size;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: sensor_log_run
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts the producer on the CM55 and logs its pages for the given time,
+ *  then stops it and logs the pages still in the pipe.
+ *
+ * Parameters:
+ *  obj - log object.
+ *  duration_usec - logging time.
+ *
+ * Return:
+ *  cy_rslt_t - result of the flash operations, or CY_SMIF_EXCEED_TIMEOUT if
+ *  the producer did not respond
+ *
+ ******************************************************************************/
+cy_rslt_t sensor_log_run(sensor_log_t *obj, uint32_t duration_usec)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    sensor_pipe_producer_t producer;
+    uint64_t elapsed_cycles = 0U;
+    uint64_t idle_cycles = 0U;      /* Since the last page */
+    uint64_t total_idle_cycles = 0U;
+    uint32_t last = perf_counter_get();
+    bool running = true;
+
+    sensor_pipe_set_command(obj->pipe, SENSOR_PIPE_CMD_RUN);
+
+    for (;;)
+    {
+        sensor_pipe_page_t *page = sensor_pipe_peek(obj->pipe);
+        uint32_t now;
+        uint32_t cycles;
+
+        if (NULL != page)
+        {
+            result = log_page(obj, page);
+            sensor_pipe_release(obj->pipe);
+            idle_cycles = 0U;
+        }
+
+        /* Whole cycle counts are kept: an idle pass is shorter than 1 us */
+        now = perf_counter_get();
+        cycles = now - last;
+        last = now;
+        elapsed_cycles += cycles;
+
+        if (NULL == page)
+        {
+            idle_cycles += cycles;
+            total_idle_cycles += cycles;
+        }
+
+        if (CY_RSLT_SUCCESS != result)
+        {
+            break;
+        }
+
+        if (perf_counter_cycles_to_usec(idle_cycles) >=
+            SENSOR_LOG_IDLE_TIMEOUT_USEC)
+        {
+            result = (cy_rslt_t)CY_SMIF_EXCEED_TIMEOUT;
+            break;
+        }
+
+        if (running &&
+            (perf_counter_cycles_to_usec(elapsed_cycles) >= duration_usec))
+        {
+            sensor_pipe_set_command(obj->pipe, SENSOR_PIPE_CMD_STOP);
+            running = false;
+        }
+
+        /* After the stop, drain what was published before the producer
+         * acknowledged it.
+         */
+        if (!running && (NULL == page))
+        {
+            sensor_pipe_get_producer(obj->pipe, &producer);
+            if ((0U != producer.stopped) &&
+                (NULL == sensor_pipe_peek(obj->pipe)))
+            {
+                break;
+            }
+        }
+    }
+
+    sensor_pipe_set_command(obj->pipe, SENSOR_PIPE_CMD_STOP);
+    obj->stats.elapsed_usec += perf_counter_cycles_to_usec(elapsed_cycles);
+    obj->stats.idle_usec += perf_counter_cycles_to_usec(total_idle_cycles);
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: sensor_log_print_report
+ *******************************************************************************
+ *
+ * Summary:
+ *  Prints the throughput of both sides of the pipeline and which side
+ *  limited it.
+ *
+ * Parameters:
+ *  obj - log object.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void sensor_log_print_report(const sensor_log_t *obj)
+{
+    const sensor_log_stats_t *stats = &obj->stats;
+    sensor_pipe_producer_t producer;
+    uint64_t elapsed = (0U != stats->elapsed_usec) ? stats->elapsed_usec : 1U;
+    uint32_t ratio = 0U;
+
+    sensor_pipe_get_producer(obj->pipe, &producer);
+
+    if (0U != producer.compressed_bytes)
+    {
+        ratio = (uint32_t)(((uint64_t)producer.raw_bytes * PERCENT) /
+                            producer.compressed_bytes);
+    }
+
+    printf("\r\nSensor logging pipeline (%"PRIu32" ms)\r\n",
+            (uint32_t)(elapsed / USEC_PER_MSEC));
+    printf("-------------------------------\r\n");
+    printf("Ingest %"PRIu32" KiB/s of samples, compression %"PRIu32".%02"
+            PRIu32"x\r\n",
+            (uint32_t)(((uint64_t)producer.raw_bytes *
+                        PERF_COUNTER_USEC_PER_SEC) / elapsed / BYTES_PER_KIB),
+            ratio / PERCENT, ratio % PERCENT);
+    printf("Flash %"PRIu32" KiB/s, %"PRIu32" pages, %"PRIu32" sectors erased"
+            "\r\n",
+            (uint32_t)(((uint64_t)stats->bytes_programmed *
+                        PERF_COUNTER_USEC_PER_SEC) / elapsed / BYTES_PER_KIB),
+            stats->pages_logged, stats->sectors_erased);
+    printf("CRC errors %"PRIu32", sequence gaps %"PRIu32"\r\n",
+            stats->crc_errors, stats->seq_errors);
+    printf("CM55 busy %"PRIu32"%%, stalled %"PRIu32"%%; "
+            "CM33 flash %"PRIu32"%%, idle %"PRIu32"%%\r\n",
+            (uint32_t)((uint64_t)producer.busy_usec * PERCENT / elapsed),
+            (uint32_t)((uint64_t)producer.stall_usec * PERCENT / elapsed),
+            (uint32_t)(stats->flash_usec * PERCENT / elapsed),
+            (uint32_t)(stats->idle_usec * PERCENT / elapsed));
+
+    /* The busier side limits the pipeline; the other one waits for it */
+    if (stats->flash_usec >= producer.busy_usec)
+    {
+        printf("Bottleneck: flash programming on the CM33\r\n");
+    }
+    else
+    {
+        printf("Bottleneck: sampling and compression on the CM55\r\n");
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * File Name        : sensor_log.h
+ *
+ * Description      : This file is the public interface of sensor_log.c, the
+ *                    CM33 side of the sensor logging pipeline.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _SENSOR_LOG_H_
+#define _SENSOR_LOG_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "mtb_serial_memory.h"
+#include "sensor_pipe.h"
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Time without a new page after which the CM55 is considered absent */
+#ifndef SENSOR_LOG_IDLE_TIMEOUT_USEC
+#define SENSOR_LOG_IDLE_TIMEOUT_USEC        (100000U)
+#endif
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t    pages_logged;
+    uint32_t    crc_errors;         /* Pages dropped, checksum mismatch */
+    uint32_t    seq_errors;         /* Gaps in the page sequence */
+    uint32_t    sectors_erased;
+    uint32_t    bytes_programmed;
+    uint64_t    elapsed_usec;
+    uint64_t    flash_usec;         /* Erasing and programming */
+    uint64_t    idle_usec;          /* Waiting for the producer */
+} sensor_log_stats_t;
+
+typedef struct
+{
+    sensor_pipe_t       *pipe;
+    mtb_serial_memory_t *mem;
+    uint32_t            base;
+    uint32_t            size;
+    uint32_t            sector_size;
+    uint32_t            offset;         /* Next page of the circular log */
+    uint32_t            next_seq;
+    sensor_log_stats_t  stats;
+} sensor_log_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+cy_rslt_t sensor_log_init(sensor_log_t *obj, sensor_pipe_t *pipe,
+                            mtb_serial_memory_t *mem, uint32_t base,
+                            uint32_t size);
+cy_rslt_t sensor_log_run(sensor_log_t *obj, uint32_t duration_usec);
+void sensor_log_print_report(const sensor_log_t *obj);
+
+#endif /* _SENSOR_LOG_H_ */
+
+/* [] END OF FILE */
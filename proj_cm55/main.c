@@ -36,6 +36,10 @@
 *******************************************************************************/
 
 #include "cybsp.h"
+#include "perf_counter.h"
+#include "sensor_producer.h"
+#include "xip_bench.h"
+#include "shared_mem.h"
 
 /*******************************************************************************
 * Function Name: main
@@ -44,7 +48,9 @@
 * This is the main function for CM55 application. 
 * 
 * CM33 application enables the CM55 CPU and then the CM55 CPU enters 
-* deep sleep.
+* deep sleep. With XIP_BENCH_ENABLE the CM55 first measures data reads
+* through the XIP window. With SENSOR_PIPE_ENABLE it then produces compressed
+* sensor pages for the CM33 until the CM33 stops it.
 * 
 * Parameters:
 *  void
@@ -75,6 +81,15 @@ int main(void)
     /* Enable global interrupts. */
     __enable_irq();
 
+#if (XIP_BENCH_ENABLE)
+    xip_bench_run(&shared_mem.xip_report);
+#endif /* (XIP_BENCH_ENABLE) */
+
+#if (SENSOR_PIPE_ENABLE)
+    perf_counter_init();
+    sensor_producer_run(&shared_mem.sensor_pipe);
+#endif /* (SENSOR_PIPE_ENABLE) */
+
     /* Put the CPU to Deep Sleep. */
     for (;;)
     {
@@ -0,0 +1,489 @@
+/*******************************************************************************
+ * File Name        : sensor_producer.c
+ *
+ * Description      : This file contains the CM55 side of the sensor logging
+ *                    pipeline. Blocks of samples are delta-encoded with the
+ *                    Helium (MVE) unit when available, packed into pages,
+ *                    checksummed and handed to the CM33 through the shared
+ *                    pipe.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "sensor_producer.h"
+#include "crc32.h"
+#include "perf_counter.h"
+
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+#define PRODUCER_USE_MVE                    (1U)
+#else
+#define PRODUCER_USE_MVE                    (0U)
+#endif /* defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1) */
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Synthetic sensor: a triangle wave with a little pseudo-random noise */
+#define SOURCE_TRIANGLE_STEP                (37)
+#define SOURCE_TRIANGLE_PEAK                (12000)
+#define SOURCE_LFSR_SEED                    (0xACE1U)
+#define SOURCE_LFSR_TAPS                    (0xB400U)
+#define SOURCE_NOISE_MASK                   (0x3FU)
+#define SOURCE_NOISE_OFFSET                 (32)
+
+#define DELTA_COUNT                         (SENSOR_PIPE_BLOCK_SAMPLES - 1U)
+#define MVE_LANES                           (8U)
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    int32_t     level;
+    int32_t     step;
+    uint16_t    lfsr;
+} sensor_source_t;
+
+/* Times are kept in whole microseconds plus the cycles of the fraction, so
+ * that no 64-bit division, a library call into flash, is needed.
+ */
+typedef struct
+{
+    sensor_pipe_page_t  *page;
+    uint32_t            used;
+    uint32_t            blocks;
+    uint32_t            raw_bytes;
+    uint32_t            cycles_per_usec;
+    uint32_t            busy_usec;
+    uint32_t            busy_cycles;
+    uint32_t            stall_usec;
+    uint32_t            stall_cycles;
+} producer_state_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static sensor_source_t source =
+{
+    .level = 0,
+    .step = SOURCE_TRIANGLE_STEP,
+    .lfsr = SOURCE_LFSR_SEED
+};
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: producer_copy
+ *******************************************************************************
+ *
+ * Summary:
+ *  Copies bytes. Used instead of memcpy(), which the library places in
+ *  flash; the volatile destination keeps the compiler from turning the loop
+ *  back into a call of it.
+ *
+ * Parameters:
+ *  dst - destination.
+ *  src - source.
+ *  size - number of bytes.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+static void producer_copy(uint8_t *dst, const uint8_t *src, uint32_t size)
+{
+    volatile uint8_t *out = dst;
+
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        out[i] = src[i];
+    }
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: producer_account
+ *******************************************************************************
+ *
+ * Summary:
+ *  Adds a duration in cycles to a time kept in microseconds and cycles.
+ *
+ * Parameters:
+ *  usec - whole microseconds, updated in place.
+ *  cycles - cycles of the fraction, updated in place.
+ *  elapsed - cycles to add.
+ *  cycles_per_usec - CPU cycles per microsecond.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+static void producer_account(uint32_t *usec, uint32_t *cycles,
+                                uint32_t elapsed, uint32_t cycles_per_usec)
+{
+    *usec += elapsed / cycles_per_usec;
+    *cycles += elapsed % cycles_per_usec;
+
+    if (*cycles >= cycles_per_usec)
+    {
+        *cycles -= cycles_per_usec;
+        (*usec)++;
+    }
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: source_read
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads one block of samples from the synthetic sensor.
+ *
+ * Parameters:
+ *  samples - receives SENSOR_PIPE_BLOCK_SAMPLES samples.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+static void source_read(int16_t *samples)
+{
+    uint32_t i;
+    uint16_t lfsr = source.lfsr;
+
+    for (i = 0U; i < SENSOR_PIPE_BLOCK_SAMPLES; i++)
+    {
+        source.level += source.step;
+        if ((source.level >= SOURCE_TRIANGLE_PEAK) ||
+            (source.level <= -SOURCE_TRIANGLE_PEAK))
+        {
+            source.step = -source.step;
+        }
+
+        /* Galois LFSR, x^16 + x^14 + x^13 + x^11 + 1 */
+        lfsr = (uint16_t)((lfsr >> 1) ^
+                          ((0U != (lfsr & 1U)) ? SOURCE_LFSR_TAPS : 0U));
+
+        samples[i] = (int16_t)(source.level +
+                               (int32_t)(lfsr & SOURCE_NOISE_MASK) -
+                               SOURCE_NOISE_OFFSET);
+    }
+
+    source.lfsr = lfsr;
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: encode_block
+ *******************************************************************************
+ *
+ * Summary:
+ *  Delta-encodes one block of samples. The deltas are stored as bytes when
+ *  they all fit, as 16-bit values otherwise.
+ *
+ * Parameters:
+ *  samples - SENSOR_PIPE_BLOCK_SAMPLES samples.
+ *  out - receives up to SENSOR_PIPE_BLOCK_MAX_SIZE bytes.
+ *
+ * Return:
+ *  uint32_t - size of the encoded block
+ *
+ ******************************************************************************/
+#if (PRODUCER_USE_MVE)
+CY_RAMFUNC_BEGIN
+static uint32_t encode_block(const int16_t *samples, uint8_t *out)
+{
+    int16_t deltas[DELTA_COUNT];
+    uint16_t range = 0U;
+    uint32_t i;
+    uint32_t width;
+
+    /* Predicated tails handle the odd delta count without a scalar loop */
+    for (i = 0U; i < DELTA_COUNT; i += MVE_LANES)
+    {
+        mve_pred16_t p = vctp16q(DELTA_COUNT - i);
+        int16x8_t prev = vldrhq_z_s16(&samples[i], p);
+        int16x8_t next = vldrhq_z_s16(&samples[i + 1U], p);
+        int16x8_t delta = vsubq_x_s16(next, prev, p);
+
+        vstrhq_p_s16(&deltas[i], delta, p);
+        range = vmaxavq_p_s16(range, delta, p);
+    }
+
+    width = (range <= (uint16_t)INT8_MAX) ? 1U : 2U;
+    out[0] = (uint8_t)width;
+    out[1] = (uint8_t)((uint16_t)samples[0]);
+    out[2] = (uint8_t)((uint16_t)samples[0] >> 8);
+
+    if (1U == width)
+    {
+        /* Narrowing store keeps the low byte of each delta */
+        for (i = 0U; i < DELTA_COUNT; i += MVE_LANES)
+        {
+            mve_pred16_t p = vctp16q(DELTA_COUNT - i);
+
+            vstrbq_p_s16((int8_t *)&out[SENSOR_PIPE_BLOCK_HEADER_SIZE + i],
+                         vldrhq_z_s16(&deltas[i], p), p);
+        }
+    }
+    else
+    {
+        producer_copy(&out[SENSOR_PIPE_BLOCK_HEADER_SIZE],
+                        (const uint8_t *)deltas, (uint32_t)sizeof(deltas));
+    }
+
+    return SENSOR_PIPE_BLOCK_HEADER_SIZE + (width * DELTA_COUNT);
+}
+CY_RAMFUNC_END
+#else
+CY_RAMFUNC_BEGIN
+static uint32_t encode_block(const int16_t *samples, uint8_t *out)
+{
+    int16_t deltas[DELTA_COUNT];
+    uint32_t range = 0U;
+    uint32_t i;
+    uint32_t width;
+
+    for (i = 0U; i < DELTA_COUNT; i++)
+    {
+        int32_t delta = (int32_t)samples[i + 1U] - (int32_t)samples[i];
+        uint32_t magnitude;
+
+        deltas[i] = (int16_t)delta;
+        magnitude = (uint32_t)((deltas[i] < 0) ? -(int32_t)deltas[i] :
+                                                 (int32_t)deltas[i]);
+        if (magnitude > range)
+        {
+            range = magnitude;
+        }
+    }
+
+    width = (range <= (uint32_t)INT8_MAX) ? 1U : 2U;
+    out[0] = (uint8_t)width;
+    out[1] = (uint8_t)((uint16_t)samples[0]);
+    out[2] = (uint8_t)((uint16_t)samples[0] >> 8);
+
+    if (1U == width)
+    {
+        for (i = 0U; i < DELTA_COUNT; i++)
+        {
+            out[SENSOR_PIPE_BLOCK_HEADER_SIZE + i] = (uint8_t)deltas[i];
+        }
+    }
+    else
+    {
+        producer_copy(&out[SENSOR_PIPE_BLOCK_HEADER_SIZE],
+                        (const uint8_t *)deltas, (uint32_t)sizeof(deltas));
+    }
+
+    return SENSOR_PIPE_BLOCK_HEADER_SIZE + (width * DELTA_COUNT);
+}
+CY_RAMFUNC_END
+#endif /* (PRODUCER_USE_MVE) */
+
+/*******************************************************************************
+ * Function Name: producer_acquire
+ *******************************************************************************
+ *
+ * Summary:
+ *  Waits for a free page. The wait is accounted as stall time.
+ *
+ * Parameters:
+ *  pipe - shared pipe.
+ *  state - producer state.
+ *
+ * Return:
+ *  bool - false if the producer was stopped while waiting
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+static bool producer_acquire(sensor_pipe_t *pipe, producer_state_t *state)
+{
+    uint32_t start = perf_counter_get();
+
+    state->page = sensor_pipe_acquire(pipe);
+    while ((NULL == state->page) &&
+           (SENSOR_PIPE_CMD_RUN == sensor_pipe_get_command(pipe)))
+    {
+        state->page = sensor_pipe_acquire(pipe);
+    }
+
+    producer_account(&state->stall_usec, &state->stall_cycles,
+                        perf_counter_get() - start, state->cycles_per_usec);
+    state->used = 0U;
+    state->blocks = 0U;
+    state->raw_bytes = 0U;
+
+    return (NULL != state->page);
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: producer_publish
+ *******************************************************************************
+ *
+ * Summary:
+ *  Completes the header of the current page and hands the page to the CM33.
+ *
+ * Parameters:
+ *  pipe - shared pipe.
+ *  state - producer state.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+static void producer_publish(sensor_pipe_t *pipe, producer_state_t *state)
+{
+    sensor_pipe_page_t *page = state->page;
+    sensor_pipe_producer_t *producer = &pipe->producer;
+    uint32_t start = perf_counter_get();
+
+    page->header.seq = producer->head;
+    page->header.crc = crc32(page->payload, state->used);
+    page->header.length = (uint16_t)state->used;
+    page->header.block_count = (uint16_t)state->blocks;
+    page->header.raw_bytes = state->raw_bytes;
+
+    producer_account(&state->busy_usec, &state->busy_cycles,
+                        perf_counter_get() - start, state->cycles_per_usec);
+
+    producer->blocks += state->blocks;
+    producer->raw_bytes += state->raw_bytes;
+    producer->compressed_bytes += state->used;
+    producer->busy_usec = state->busy_usec;
+    producer->stall_usec = state->stall_usec;
+
+    sensor_pipe_publish(pipe);
+    state->page = NULL;
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: sensor_producer_run
+ *******************************************************************************
+ *
+ * Summary:
+ *  Waits for the CM33 to start the pipeline and produces pages until it is
+ *  stopped. A partly filled page is published on stop, before the stop is
+ *  acknowledged.
+ *
+ *  The CM33 erases and programs the serial memory the CM55 executes from as
+ *  pages arrive, so the producer runs from RAM with interrupts masked, and
+ *  calls only RAM functions, from before its first page is published until
+ *  the CM33 has released the last one.
+ *
+ * Parameters:
+ *  pipe - shared pipe initialized by the CM33.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+void sensor_producer_run(sensor_pipe_t *pipe)
+{
+    producer_state_t state;
+    int16_t samples[SENSOR_PIPE_BLOCK_SAMPLES];
+    uint8_t block[SENSOR_PIPE_BLOCK_MAX_SIZE];
+    uint32_t interrupts = __get_PRIMASK();
+
+    /* Set field by field: a zeroing initializer may become a memset() call */
+    state.page = NULL;
+    state.cycles_per_usec = SystemCoreClock / PERF_COUNTER_USEC_PER_SEC;
+    state.busy_usec = 0U;
+    state.busy_cycles = 0U;
+    state.stall_usec = 0U;
+    state.stall_cycles = 0U;
+
+    /* No vector or handler in flash may be fetched while the CM33 erases */
+    __disable_irq();
+
+    while (!sensor_pipe_is_ready(pipe))
+    {
+    }
+
+    while (SENSOR_PIPE_CMD_RUN != sensor_pipe_get_command(pipe))
+    {
+    }
+
+    while (SENSOR_PIPE_CMD_RUN == sensor_pipe_get_command(pipe))
+    {
+        uint32_t start = perf_counter_get();
+        uint32_t size;
+
+        source_read(samples);
+        size = encode_block(samples, block);
+        producer_account(&state.busy_usec, &state.busy_cycles,
+                            perf_counter_get() - start, state.cycles_per_usec);
+
+        if ((NULL != state.page) &&
+            ((state.used + size) > SENSOR_PIPE_PAYLOAD_SIZE))
+        {
+            producer_publish(pipe, &state);
+        }
+
+        if ((NULL == state.page) && !producer_acquire(pipe, &state))
+        {
+            break;
+        }
+
+        producer_copy(&state.page->payload[state.used], block, size);
+        state.used += size;
+        state.blocks++;
+        state.raw_bytes += (uint32_t)sizeof(samples);
+    }
+
+    if ((NULL != state.page) && (0U != state.used))
+    {
+        producer_publish(pipe, &state);
+    }
+
+    sensor_pipe_set_stopped(pipe);
+
+    /* The CM33 programs each page before it releases it. If it gives up on
+     * an error, the CM55 stays here, which is safe.
+     */
+    while (!sensor_pipe_is_drained(pipe))
+    {
+    }
+
+    __set_PRIMASK(interrupts);
+}
+CY_RAMFUNC_END
+
+/* [] END OF FILE */
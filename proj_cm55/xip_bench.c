@@ -0,0 +1,257 @@
+/*******************************************************************************
+ * File Name        : xip_bench.c
+ *
+ * Description      : This file contains the benchmark of data reads through
+ *                    the XIP window: sequential and strided passes over a
+ *                    flash-resident table, each with and without prefetch.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "xip_bench.h"
+#include "xip_layout.h"
+#include "perf_counter.h"
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Table of line-aligned records, four lines each; the strided pass reads
+ * the key of each record only.
+ */
+#define RECORD_WORDS                        (28U)
+#define RECORD_COUNT                        (128U)
+#define WORD_SIZE                           (4U)
+#define WORDS_PER_LINE                      (XIP_CACHE_LINE_SIZE / WORD_SIZE)
+#define TABLE_LINES                         (sizeof(table) / \
+                                            XIP_CACHE_LINE_SIZE)
+
+/* Lines fetched ahead of the one in use */
+#define PREFETCH_LINES                      (4U)
+
+/* Passes per measurement, each starting with a cold cache */
+#define BENCH_ROUNDS                        (4U)
+
+#define NSEC_PER_USEC                       (1000U)
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t    key;
+    uint32_t    value[RECORD_WORDS - 1U];
+    uint8_t     pad[XIP_LINE_PAD(RECORD_WORDS * WORD_SIZE)];
+} xip_bench_record_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Constant data of the CM55 image stays in the XIP flash */
+XIP_CACHE_ALIGNED static const xip_bench_record_t table[RECORD_COUNT] =
+{
+    { .key = 1U }
+};
+
+/* Keeps the compiler from dropping the reads */
+static volatile uint32_t bench_sink;
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: read_sequential
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads every word of the table in order.
+ *
+ * Parameters:
+ *  prefetch - fetch lines PREFETCH_LINES ahead.
+ *
+ * Return:
+ *  uint32_t - sum of the words
+ *
+ ******************************************************************************/
+static uint32_t read_sequential(bool prefetch)
+{
+    const uint32_t *words = (const uint32_t *)table;
+    uint32_t sum = 0U;
+
+    if (prefetch)
+    {
+        xip_prefetch_range(words, PREFETCH_LINES * XIP_CACHE_LINE_SIZE);
+    }
+
+    for (uint32_t line = 0U; line < TABLE_LINES; line++)
+    {
+        const uint32_t *next = &words[line * WORDS_PER_LINE];
+
+        if (prefetch && ((line + PREFETCH_LINES) < TABLE_LINES))
+        {
+            xip_prefetch(&next[PREFETCH_LINES * WORDS_PER_LINE]);
+        }
+
+        for (uint32_t word = 0U; word < WORDS_PER_LINE; word++)
+        {
+            sum += next[word];
+        }
+    }
+
+    return sum;
+}
+
+/*******************************************************************************
+ * Function Name: read_strided
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads the key of every record, one line out of each record.
+ *
+ * Parameters:
+ *  prefetch - fetch the keys of PREFETCH_LINES records ahead.
+ *
+ * Return:
+ *  uint32_t - sum of the keys
+ *
+ ******************************************************************************/
+static uint32_t read_strided(bool prefetch)
+{
+    uint32_t sum = 0U;
+
+    if (prefetch)
+    {
+        for (uint32_t index = 0U; index < PREFETCH_LINES; index++)
+        {
+            xip_prefetch(&table[index].key);
+        }
+    }
+
+    for (uint32_t index = 0U; index < RECORD_COUNT; index++)
+    {
+        if (prefetch && ((index + PREFETCH_LINES) < RECORD_COUNT))
+        {
+            xip_prefetch(&table[index + PREFETCH_LINES].key);
+        }
+
+        sum += table[index].key;
+    }
+
+    return sum;
+}
+
+/*******************************************************************************
+ * Function Name: measure
+ *******************************************************************************
+ *
+ * Summary:
+ *  Times BENCH_ROUNDS passes of an access pattern, dropping the table from
+ *  the data cache before each so that every line comes from the flash.
+ *
+ * Parameters:
+ *  pattern - access pattern.
+ *  prefetch - whether the pattern prefetches.
+ *
+ * Return:
+ *  uint32_t - average duration of a pass in nanoseconds
+ *
+ ******************************************************************************/
+static uint32_t measure(xip_report_pattern_t pattern, bool prefetch)
+{
+    uint64_t cycles = 0U;
+
+    for (uint32_t round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        uint32_t start;
+
+#if defined(__DCACHE_PRESENT) && (1U == __DCACHE_PRESENT)
+        SCB_InvalidateDCache_by_Addr((volatile void *)table,
+                                        (int32_t)sizeof(table));
+#endif /* defined(__DCACHE_PRESENT) && (1U == __DCACHE_PRESENT) */
+
+        start = perf_counter_get();
+        bench_sink = (XIP_REPORT_SEQUENTIAL == pattern) ?
+                        read_sequential(prefetch) : read_strided(prefetch);
+        cycles += perf_counter_get() - start;
+    }
+
+    return (uint32_t)((cycles * NSEC_PER_USEC) /
+                        ((uint64_t)BENCH_ROUNDS * (SystemCoreClock /
+                                                PERF_COUNTER_USEC_PER_SEC)));
+}
+
+/*******************************************************************************
+ * Function Name: xip_bench_run
+ *******************************************************************************
+ *
+ * Summary:
+ *  Measures sequential and strided reads of a flash-resident table with and
+ *  without prefetch and publishes the results for the CM33.
+ *
+ * Parameters:
+ *  report - shared report, cleared by the CM33 before the CM55 started.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void xip_bench_run(xip_report_t *report)
+{
+    perf_counter_init();
+
+    for (uint32_t pattern = 0U; pattern < XIP_REPORT_PATTERN_COUNT; pattern++)
+    {
+        xip_report_result_t *result = &report->results[pattern];
+
+        result->lines = (XIP_REPORT_SEQUENTIAL == pattern) ?
+                        (uint32_t)TABLE_LINES : RECORD_COUNT;
+        result->plain_nsec = measure((xip_report_pattern_t)pattern, false);
+        result->prefetch_nsec = measure((xip_report_pattern_t)pattern, true);
+    }
+
+    report->table_size = (uint32_t)sizeof(table);
+    report->line_size = XIP_CACHE_LINE_SIZE;
+    report->stride = (uint32_t)sizeof(xip_bench_record_t);
+    report->prefetch_lines = PREFETCH_LINES;
+
+#if defined(__DCACHE_PRESENT) && (1U == __DCACHE_PRESENT)
+    SCB_CleanDCache_by_Addr((volatile void *)report, (int32_t)sizeof(*report));
+#endif /* defined(__DCACHE_PRESENT) && (1U == __DCACHE_PRESENT) */
+
+    __DMB();
+    report->magic = XIP_REPORT_MAGIC;
+
+#if defined(__DCACHE_PRESENT) && (1U == __DCACHE_PRESENT)
+    SCB_CleanDCache_by_Addr((volatile void *)report, (int32_t)sizeof(*report));
+#endif /* defined(__DCACHE_PRESENT) && (1U == __DCACHE_PRESENT) */
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * File Name        : xip_layout.h
+ *
+ * Description      : This file contains helpers to lay out data read through
+ *                    the memory-mapped (XIP) flash window in data cache lines,
+ *                    and to prefetch lines ahead of use.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _XIP_LAYOUT_H_
+#define _XIP_LAYOUT_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "cybsp.h"
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Data cache line of the CM55; every miss is one flash transaction */
+#define XIP_CACHE_LINE_SIZE                 (32U)
+
+/* Place in front of a declaration so that an object starts a line */
+#define XIP_CACHE_ALIGNED                   CY_ALIGN(XIP_CACHE_LINE_SIZE)
+
+/* Size rounded up to whole lines, and the lines it spans when aligned */
+#define XIP_LINE_ROUND_UP(size)             (((size) + \
+                                            XIP_CACHE_LINE_SIZE - 1U) & \
+                                            ~(XIP_CACHE_LINE_SIZE - 1U))
+#define XIP_LINE_COUNT(size)                (XIP_LINE_ROUND_UP(size) / \
+                                            XIP_CACHE_LINE_SIZE)
+
+/* Padding that makes a record of the given size fill whole lines, so that
+ * records of an array never share a line
+ */
+#define XIP_LINE_PAD(size)                  (XIP_LINE_ROUND_UP(size) - (size))
+
+/*******************************************************************************
+ * Function Name: xip_prefetch
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts the fill of the cache line holding an address without waiting
+ *  for it. The hint never faults and is dropped by toolchains without
+ *  support for it.
+ *
+ * Parameters:
+ *  addr - address within the line to fetch.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+__STATIC_FORCEINLINE void xip_prefetch(const void *addr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(addr);
+#else
+    (void)addr;
+#endif /* defined(__GNUC__) || defined(__clang__) */
+}
+
+/*******************************************************************************
+ * Function Name: xip_prefetch_range
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts the fill of every cache line of a range.
+ *
+ * Parameters:
+ *  addr - start of the range.
+ *  size - size of the range.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+__STATIC_FORCEINLINE void xip_prefetch_range(const void *addr, uint32_t size)
+{
+    uintptr_t line = (uintptr_t)addr & ~(uintptr_t)(XIP_CACHE_LINE_SIZE - 1U);
+    uintptr_t end = (uintptr_t)addr + size;
+
+    for (; line < end; line += XIP_CACHE_LINE_SIZE)
+    {
+        xip_prefetch((const void *)line);
+    }
+}
+
+#endif /* _XIP_LAYOUT_H_ */
+
+/* [] END OF FILE */
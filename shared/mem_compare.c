@@ -0,0 +1,339 @@
+/*******************************************************************************
+ * File Name        : mem_compare.c
+ *
+ * Description      : This file compares buffers in one pass and returns the
+ *                    offset of the first difference and the number of differing
+ *                    bytes and bits. The kernel uses Helium (MVE) vectors
+ *                    where the core has them, as on the CM55, and word-wide
+ *                    scalar code otherwise.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "mem_compare.h"
+#include <string.h>
+#if defined(__ARM_FEATURE_MVE)
+#include <arm_mve.h>
+#endif /* defined(__ARM_FEATURE_MVE) */
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define WORD_SIZE                           (sizeof(uint32_t))
+#define BITS_PER_BYTE                       (8U)
+#define BYTE_MASK                           (0xFFUL)
+
+/* Words compared per iteration of the scalar kernel */
+#define WORD_PAIR_SIZE                      (2U * WORD_SIZE)
+
+/* Masks of the SWAR bit and byte counts */
+#define POPCOUNT_MASK_1                     (0x55555555UL)
+#define POPCOUNT_MASK_2                     (0x33333333UL)
+#define POPCOUNT_MASK_4                     (0x0F0F0F0FUL)
+#define POPCOUNT_BYTE_SUM                   (0x01010101UL)
+#define POPCOUNT_SUM_SHIFT                  (24U)
+#define BYTE_LOW_BITS                       (0x7F7F7F7FUL)
+#define BYTE_HIGH_BITS                      (0x80808080UL)
+
+#if defined(__ARM_FEATURE_MVE)
+#define VECTOR_SIZE                         (16U)
+#endif /* defined(__ARM_FEATURE_MVE) */
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+#if defined(__ARM_FEATURE_MVE)
+/*******************************************************************************
+ * Function Name: compare_vectors
+ *******************************************************************************
+ *
+ * Summary:
+ *  Compares 16 bytes per iteration with Helium. Equal vectors cost a load
+ *  pair, an XOR and a compare; the counts are only taken for vectors that
+ *  differ. The last vector is tail predicated, so no scalar loop follows.
+ *
+ * Parameters:
+ *  diff - running result.
+ *  offset - offset of actual[0] in the whole comparison.
+ *  actual - data read back.
+ *  expected - expected data.
+ *  length - number of bytes to compare.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void compare_vectors(mem_compare_t *diff, uint32_t offset,
+                            const uint8_t *actual, const uint8_t *expected,
+                            uint32_t length)
+{
+    uint8x16_t x;
+    mve_pred16_t lanes;
+    mve_pred16_t differs;
+    uint32_t lane;
+
+    for (uint32_t index = 0U; index < length; index += VECTOR_SIZE)
+    {
+        /* Lanes past the end load as zero from both buffers */
+        lanes = vctp8q(length - index);
+        x = veorq_u8(vld1q_z_u8(&actual[index], lanes),
+                        vld1q_z_u8(&expected[index], lanes));
+        differs = vcmpneq_n_u8(x, 0U);
+
+        if (0U != differs)
+        {
+            diff->bytes += vaddvq_p_u8(vdupq_n_u8(1U), differs);
+
+            /* Bit count of each lane, as in popcount() */
+            x = vsubq_u8(x, vandq_u8(vshrq_n_u8(x, 1),
+                                        vdupq_n_u8(0x55U)));
+            x = vaddq_u8(vandq_u8(x, vdupq_n_u8(0x33U)),
+                            vandq_u8(vshrq_n_u8(x, 2), vdupq_n_u8(0x33U)));
+            x = vandq_u8(vaddq_u8(x, vshrq_n_u8(x, 4)), vdupq_n_u8(0x0FU));
+            diff->bits += vaddvq_u8(x);
+
+            if (MEM_COMPARE_MATCH == diff->first)
+            {
+                /* The predicate has one bit per byte lane */
+                lane = 0U;
+
+                while (0U == (differs & (1U << lane)))
+                {
+                    lane++;
+                }
+
+                diff->first = offset + index + lane;
+            }
+        }
+    }
+}
+#else
+/*******************************************************************************
+ * Function Name: popcount
+ *******************************************************************************
+ *
+ * Summary:
+ *  Counts the set bits of a word without a lookup table.
+ *
+ * Parameters:
+ *  x - word to count.
+ *
+ * Return:
+ *  uint32_t - number of set bits
+ *
+ ******************************************************************************/
+static uint32_t popcount(uint32_t x)
+{
+    x -= (x >> 1) & POPCOUNT_MASK_1;
+    x = (x & POPCOUNT_MASK_2) + ((x >> 2) & POPCOUNT_MASK_2);
+    x = (x + (x >> 4)) & POPCOUNT_MASK_4;
+
+    return (uint32_t)(x * POPCOUNT_BYTE_SUM) >> POPCOUNT_SUM_SHIFT;
+}
+
+/*******************************************************************************
+ * Function Name: add_word
+ *******************************************************************************
+ *
+ * Summary:
+ *  Adds the differences of one word to the result.
+ *
+ * Parameters:
+ *  diff - running result.
+ *  offset - offset of the word in the whole comparison.
+ *  x - XOR of the actual and expected word, not zero.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void add_word(mem_compare_t *diff, uint32_t offset, uint32_t x)
+{
+    /* Top bit of each byte set where the byte is not zero */
+    uint32_t nonzero = (((x & BYTE_LOW_BITS) + BYTE_LOW_BITS) | x) &
+                        BYTE_HIGH_BITS;
+    uint32_t byte = 0U;
+
+    diff->bits += popcount(x);
+    diff->bytes += popcount(nonzero);
+
+    if (MEM_COMPARE_MATCH == diff->first)
+    {
+        /* Words are loaded little-endian: the lowest byte comes first */
+        while (0U == ((x >> (byte * BITS_PER_BYTE)) & BYTE_MASK))
+        {
+            byte++;
+        }
+
+        diff->first = offset + byte;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: compare_words
+ *******************************************************************************
+ *
+ * Summary:
+ *  Compares two words per iteration. The loads go through memcpy(), which
+ *  the compiler turns into single loads on cores that allow unaligned
+ *  access, so the buffers may have any alignment.
+ *
+ * Parameters:
+ *  diff - running result.
+ *  offset - offset of actual[0] in the whole comparison.
+ *  actual - data read back.
+ *  expected - expected data.
+ *  length - number of bytes to compare.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void compare_words(mem_compare_t *diff, uint32_t offset,
+                            const uint8_t *actual, const uint8_t *expected,
+                            uint32_t length)
+{
+    uint32_t actual_words[2];
+    uint32_t expected_words[2];
+    uint32_t x;
+    uint32_t index = 0U;
+
+    for (; (length - index) >= WORD_PAIR_SIZE; index += WORD_PAIR_SIZE)
+    {
+        memcpy(actual_words, &actual[index], WORD_PAIR_SIZE);
+        memcpy(expected_words, &expected[index], WORD_PAIR_SIZE);
+        actual_words[0] ^= expected_words[0];
+        actual_words[1] ^= expected_words[1];
+
+        if (0U != (actual_words[0] | actual_words[1]))
+        {
+            if (0U != actual_words[0])
+            {
+                add_word(diff, offset + index, actual_words[0]);
+            }
+
+            if (0U != actual_words[1])
+            {
+                add_word(diff, offset + index + WORD_SIZE, actual_words[1]);
+            }
+        }
+    }
+
+    for (; index < length; index++)
+    {
+        x = (uint32_t)(actual[index] ^ expected[index]);
+
+        if (0U != x)
+        {
+            add_word(diff, offset + index, x);
+        }
+    }
+}
+#endif /* defined(__ARM_FEATURE_MVE) */
+
+/*******************************************************************************
+ * Function Name: mem_compare_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Resets a result before the first mem_compare_update().
+ *
+ * Parameters:
+ *  diff - result to reset.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void mem_compare_init(mem_compare_t *diff)
+{
+    diff->first = MEM_COMPARE_MATCH;
+    diff->bytes = 0U;
+    diff->bits = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: mem_compare_update
+ *******************************************************************************
+ *
+ * Summary:
+ *  Adds the comparison of one piece of a larger range to a result, so a
+ *  range read back in chunks is compared without a buffer of its size.
+ *
+ * Parameters:
+ *  diff - running result.
+ *  offset - offset of the piece in the range.
+ *  actual - data read back.
+ *  expected - expected data.
+ *  length - size of the piece.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void mem_compare_update(mem_compare_t *diff, uint32_t offset,
+                        const uint8_t *actual, const uint8_t *expected,
+                        uint32_t length)
+{
+#if defined(__ARM_FEATURE_MVE)
+    compare_vectors(diff, offset, actual, expected, length);
+#else
+    compare_words(diff, offset, actual, expected, length);
+#endif /* defined(__ARM_FEATURE_MVE) */
+}
+
+/*******************************************************************************
+ * Function Name: mem_compare
+ *******************************************************************************
+ *
+ * Summary:
+ *  Compares two buffers. Unlike memcmp(), the result tells where the first
+ *  difference is and how many bytes and bits differ, which separates a
+ *  single weak bit from a misplaced or missing write.
+ *
+ * Parameters:
+ *  diff - receives the result.
+ *  actual - data read back.
+ *  expected - expected data.
+ *  length - number of bytes to compare.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void mem_compare(mem_compare_t *diff, const uint8_t *actual,
+                    const uint8_t *expected, uint32_t length)
+{
+    mem_compare_init(diff);
+    mem_compare_update(diff, 0U, actual, expected, length);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * File Name        : mem_compare.h
+ *
+ * Description      : This file is the public interface of mem_compare.c,
+ *                    which compares buffers for the verify paths of the CM33
+ *                    and CM55 applications.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _MEM_COMPARE_H_
+#define _MEM_COMPARE_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* First difference reported while the buffers match */
+#define MEM_COMPARE_MATCH                   (0xFFFFFFFFUL)
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t    first;              /* Offset of the first differing byte */
+    uint32_t    bytes;              /* Differing bytes */
+    uint32_t    bits;               /* Differing bits */
+} mem_compare_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void mem_compare_init(mem_compare_t *diff);
+void mem_compare_update(mem_compare_t *diff, uint32_t offset,
+                        const uint8_t *actual, const uint8_t *expected,
+                        uint32_t length);
+void mem_compare(mem_compare_t *diff, const uint8_t *actual,
+                    const uint8_t *expected, uint32_t length);
+
+#endif /* _MEM_COMPARE_H_ */
+
+/* [] END OF FILE */
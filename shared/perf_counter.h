@@ -0,0 +1,169 @@
+/*******************************************************************************
+ * File Name        : perf_counter.h
+ *
+ * Description      : This file provides inline helpers around the DWT cycle
+ *                    counter that are used by both CPUs to time flash and
+ *                    pipeline operations. On the host the virtual time of
+ *                    the flash simulator is used.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _PERF_COUNTER_H_
+#define _PERF_COUNTER_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#if defined(FLASH_SIM)
+#include "flash_sim.h"
+#else
+#include "cybsp.h"
+#endif /* defined(FLASH_SIM) */
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define PERF_COUNTER_USEC_PER_SEC           (1000000U)
+#define PERF_COUNTER_NSEC_PER_USEC          (1000U)
+
+#if defined(FLASH_SIM)
+/* On the host a cycle is one nanosecond of the simulator's virtual time */
+#define PERF_COUNTER_SIM_NSEC_PER_USEC      (1000U)
+#endif /* defined(FLASH_SIM) */
+
+/*******************************************************************************
+ * Function Name: perf_counter_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Enables the trace block and starts the DWT cycle counter.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+#if defined(FLASH_SIM)
+static inline void perf_counter_init(void)
+{
+}
+#else
+__STATIC_INLINE void perf_counter_init(void)
+{
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+#endif /* defined(FLASH_SIM) */
+
+/*******************************************************************************
+ * Function Name: perf_counter_get
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the current value of the free-running cycle counter. Differences
+ *  between two readings are valid across a single counter wrap.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint32_t - current CPU cycle count
+ *
+ ******************************************************************************/
+#if defined(FLASH_SIM)
+static inline uint32_t perf_counter_get(void)
+{
+    return (uint32_t)flash_sim_time_ns();
+}
+#else
+__STATIC_INLINE uint32_t perf_counter_get(void)
+{
+    return DWT->CYCCNT;
+}
+#endif /* defined(FLASH_SIM) */
+
+/*******************************************************************************
+ * Function Name: perf_counter_cycles_to_usec
+ *******************************************************************************
+ *
+ * Summary:
+ *  Converts a number of CPU cycles to microseconds.
+ *
+ * Parameters:
+ *  cycles - number of CPU cycles.
+ *
+ * Return:
+ *  uint64_t - elapsed time in microseconds
+ *
+ ******************************************************************************/
+#if defined(FLASH_SIM)
+static inline uint64_t perf_counter_cycles_to_usec(uint64_t cycles)
+{
+    return cycles / PERF_COUNTER_SIM_NSEC_PER_USEC;
+}
+#else
+__STATIC_INLINE uint64_t perf_counter_cycles_to_usec(uint64_t cycles)
+{
+    return (cycles * PERF_COUNTER_USEC_PER_SEC) / SystemCoreClock;
+}
+#endif /* defined(FLASH_SIM) */
+
+/*******************************************************************************
+ * Function Name: perf_counter_cycles_to_nsec
+ *******************************************************************************
+ *
+ * Summary:
+ *  Converts a number of CPU cycles to nanoseconds.
+ *
+ * Parameters:
+ *  cycles - number of CPU cycles.
+ *
+ * Return:
+ *  uint64_t - elapsed time in nanoseconds
+ *
+ ******************************************************************************/
+#if defined(FLASH_SIM)
+static inline uint64_t perf_counter_cycles_to_nsec(uint64_t cycles)
+{
+    return cycles;
+}
+#else
+__STATIC_INLINE uint64_t perf_counter_cycles_to_nsec(uint64_t cycles)
+{
+    return (cycles * PERF_COUNTER_NSEC_PER_USEC) /
+            (SystemCoreClock / PERF_COUNTER_USEC_PER_SEC);
+}
+#endif /* defined(FLASH_SIM) */
+
+#endif /* _PERF_COUNTER_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,386 @@
+/*******************************************************************************
+ * File Name        : sensor_pipe.c
+ *
+ * Description      : This file contains the single-producer, single-consumer
+ *                    ring of flash pages shared by the CM55 and the CM33. Data
+ *                    cache maintenance is done on the CPUs that have a cache.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "sensor_pipe.h"
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define PAGE_INDEX_MASK                     (SENSOR_PIPE_PAGE_COUNT - 1U)
+
+#if (0U != (SENSOR_PIPE_PAGE_COUNT & PAGE_INDEX_MASK))
+#error "SENSOR_PIPE_PAGE_COUNT must be a power of two"
+#endif
+
+#if defined(__DCACHE_PRESENT) && (1U == __DCACHE_PRESENT)
+#define PIPE_HAS_DCACHE                     (1U)
+#else
+#define PIPE_HAS_DCACHE                     (0U)
+#endif
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: pipe_clean
+ *******************************************************************************
+ *
+ * Summary:
+ *  Writes cached data of a shared object back to memory.
+ *
+ * Parameters:
+ *  addr - cache-line-aligned start of the object.
+ *  size - size of the object.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+static void pipe_clean(volatile void *addr, uint32_t size)
+{
+#if (PIPE_HAS_DCACHE)
+    SCB_CleanDCache_by_Addr(addr, (int32_t)size);
+#else
+    (void)addr;
+    (void)size;
+#endif /* (PIPE_HAS_DCACHE) */
+
+    __DMB();
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: pipe_invalidate
+ *******************************************************************************
+ *
+ * Summary:
+ *  Discards cached data of a shared object written by the other CPU.
+ *
+ * Parameters:
+ *  addr - cache-line-aligned start of the object.
+ *  size - size of the object.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+static void pipe_invalidate(volatile void *addr, uint32_t size)
+{
+    __DMB();
+
+#if (PIPE_HAS_DCACHE)
+    SCB_InvalidateDCache_by_Addr(addr, (int32_t)size);
+#else
+    (void)addr;
+    (void)size;
+#endif /* (PIPE_HAS_DCACHE) */
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: sensor_pipe_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Empties the pipe. Called by the CM33 before the CM55 is enabled.
+ *
+ * Parameters:
+ *  pipe - shared pipe.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void sensor_pipe_init(sensor_pipe_t *pipe)
+{
+    memset(pipe, 0, sizeof(*pipe));
+    pipe->consumer.command = SENSOR_PIPE_CMD_STOP;
+    pipe_clean(pipe, sizeof(*pipe));
+
+    /* Publish the magic last; the CM55 waits for it */
+    pipe->consumer.magic = SENSOR_PIPE_MAGIC;
+    pipe_clean(&pipe->consumer, sizeof(pipe->consumer));
+}
+
+/*******************************************************************************
+ * Function Name: sensor_pipe_set_command
+ *******************************************************************************
+ *
+ * Summary:
+ *  Starts or stops the producer on the CM55.
+ *
+ * Parameters:
+ *  pipe - shared pipe.
+ *  command - command for the producer.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void sensor_pipe_set_command(sensor_pipe_t *pipe, sensor_pipe_cmd_t command)
+{
+    pipe->consumer.command = (uint32_t)command;
+    pipe_clean(&pipe->consumer, sizeof(pipe->consumer));
+}
+
+/*******************************************************************************
+ * Function Name: sensor_pipe_peek
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the oldest published page, which stays owned by the consumer
+ *  until sensor_pipe_release().
+ *
+ * Parameters:
+ *  pipe - shared pipe.
+ *
+ * Return:
+ *  sensor_pipe_page_t * - oldest page, or NULL if none is published
+ *
+ ******************************************************************************/
+sensor_pipe_page_t *sensor_pipe_peek(sensor_pipe_t *pipe)
+{
+    sensor_pipe_page_t *page;
+
+    pipe_invalidate(&pipe->producer, sizeof(pipe->producer));
+
+    if (pipe->producer.head == pipe->consumer.tail)
+    {
+        return NULL;
+    }
+
+    page = &pipe->pages[pipe->consumer.tail & PAGE_INDEX_MASK];
+    pipe_invalidate(page, sizeof(*page));
+
+    return page;
+}
+
+/*******************************************************************************
+ * Function Name: sensor_pipe_release
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the page obtained by sensor_pipe_peek() to the producer.
+ *
+ * Parameters:
+ *  pipe - shared pipe.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void sensor_pipe_release(sensor_pipe_t *pipe)
+{
+    __DMB();
+    pipe->consumer.tail++;
+    pipe_clean(&pipe->consumer, sizeof(pipe->consumer));
+}
+
+/*******************************************************************************
+ * Function Name: sensor_pipe_get_producer
+ *******************************************************************************
+ *
+ * Summary:
+ *  Copies the producer counters.
+ *
+ * Parameters:
+ *  pipe - shared pipe.
+ *  producer - receives the counters.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void sensor_pipe_get_producer(sensor_pipe_t *pipe,
+                                sensor_pipe_producer_t *producer)
+{
+    pipe_invalidate(&pipe->producer, sizeof(pipe->producer));
+    *producer = pipe->producer;
+}
+
+/*******************************************************************************
+ * Function Name: sensor_pipe_is_ready
+ *******************************************************************************
+ *
+ * Summary:
+ *  Checks whether the CM33 has initialized the pipe.
+ *
+ * Parameters:
+ *  pipe - shared pipe.
+ *
+ * Return:
+ *  bool - true once the pipe is initialized
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+bool sensor_pipe_is_ready(sensor_pipe_t *pipe)
+{
+    pipe_invalidate(&pipe->consumer, sizeof(pipe->consumer));
+
+    return (SENSOR_PIPE_MAGIC == pipe->consumer.magic);
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: sensor_pipe_get_command
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the last command of the CM33.
+ *
+ * Parameters:
+ *  pipe - shared pipe.
+ *
+ * Return:
+ *  sensor_pipe_cmd_t - command for the producer
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+sensor_pipe_cmd_t sensor_pipe_get_command(sensor_pipe_t *pipe)
+{
+    pipe_invalidate(&pipe->consumer, sizeof(pipe->consumer));
+
+    return (sensor_pipe_cmd_t)pipe->consumer.command;
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: sensor_pipe_acquire
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the next free page for the producer to fill.
+ *
+ * Parameters:
+ *  pipe - shared pipe.
+ *
+ * Return:
+ *  sensor_pipe_page_t * - free page, or NULL if all pages are in flight
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+sensor_pipe_page_t *sensor_pipe_acquire(sensor_pipe_t *pipe)
+{
+    pipe_invalidate(&pipe->consumer, sizeof(pipe->consumer));
+
+    if ((pipe->producer.head - pipe->consumer.tail) >= SENSOR_PIPE_PAGE_COUNT)
+    {
+        return NULL;
+    }
+
+    return &pipe->pages[pipe->producer.head & PAGE_INDEX_MASK];
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: sensor_pipe_publish
+ *******************************************************************************
+ *
+ * Summary:
+ *  Hands the page obtained by sensor_pipe_acquire() to the consumer,
+ *  together with the updated producer counters.
+ *
+ * Parameters:
+ *  pipe - shared pipe.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+void sensor_pipe_publish(sensor_pipe_t *pipe)
+{
+    sensor_pipe_page_t *page = &pipe->pages[pipe->producer.head &
+                                            PAGE_INDEX_MASK];
+
+    pipe_clean(page, sizeof(*page));
+    pipe->producer.head++;
+    pipe_clean(&pipe->producer, sizeof(pipe->producer));
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: sensor_pipe_set_stopped
+ *******************************************************************************
+ *
+ * Summary:
+ *  Tells the CM33 that no more pages will be published.
+ *
+ * Parameters:
+ *  pipe - shared pipe.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+void sensor_pipe_set_stopped(sensor_pipe_t *pipe)
+{
+    pipe->producer.stopped = 1U;
+    pipe_clean(&pipe->producer, sizeof(pipe->producer));
+}
+CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Function Name: sensor_pipe_is_drained
+ *******************************************************************************
+ *
+ * Summary:
+ *  Checks whether the consumer has released every published page, that is,
+ *  has finished the flash operations of all of them.
+ *
+ * Parameters:
+ *  pipe - shared pipe.
+ *
+ * Return:
+ *  bool - true if no page is in flight
+ *
+ ******************************************************************************/
+CY_RAMFUNC_BEGIN
+bool sensor_pipe_is_drained(sensor_pipe_t *pipe)
+{
+    pipe_invalidate(&pipe->consumer, sizeof(pipe->consumer));
+
+    return (pipe->producer.head == pipe->consumer.tail);
+}
+CY_RAMFUNC_END
+
+/* [] END OF FILE */
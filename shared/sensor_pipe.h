@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * File Name        : sensor_pipe.h
+ *
+ * Description      : This file describes the shared-memory pipe through
+ *                    which the CM55 hands compressed, checksummed sensor
+ *                    pages to the CM33 for programming into the serial
+ *                    flash.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _SENSOR_PIPE_H_
+#define _SENSOR_PIPE_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "cybsp.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Set to 1U in both applications to run the sensor logging pipeline */
+#ifndef SENSOR_PIPE_ENABLE
+#define SENSOR_PIPE_ENABLE                  (0U)
+#endif
+
+/* Pages in flight between the CPUs; must be a power of two */
+#ifndef SENSOR_PIPE_PAGE_COUNT
+#define SENSOR_PIPE_PAGE_COUNT              (8U)
+#endif
+
+/* One flash page; pages are programmed as they are */
+#define SENSOR_PIPE_PAGE_SIZE               (256U)
+#define SENSOR_PIPE_HEADER_SIZE             (16U)
+#define SENSOR_PIPE_PAYLOAD_SIZE            (SENSOR_PIPE_PAGE_SIZE - \
+                                            SENSOR_PIPE_HEADER_SIZE)
+
+/* Data cache line of the CM55; shared fields written by different CPUs are
+ * kept in separate lines.
+ */
+#define SENSOR_PIPE_CACHE_LINE              (32U)
+
+#define SENSOR_PIPE_MAGIC                   (0x50495053UL)  /* "SPIP" */
+
+/* Payload of a page: compressed blocks back to back, each made of
+ * - width of the deltas in bytes (1 or 2)
+ * - first sample, 16-bit little-endian
+ * - SENSOR_PIPE_BLOCK_SAMPLES - 1 deltas to the previous sample
+ */
+#define SENSOR_PIPE_BLOCK_SAMPLES           (64U)
+#define SENSOR_PIPE_BLOCK_HEADER_SIZE       (3U)
+#define SENSOR_PIPE_BLOCK_MAX_SIZE          (SENSOR_PIPE_BLOCK_HEADER_SIZE + \
+                                            (2U * \
+                                            (SENSOR_PIPE_BLOCK_SAMPLES - 1U)))
+
+/*******************************************************************************
+ * Enumerations
+ ******************************************************************************/
+typedef enum
+{
+    SENSOR_PIPE_CMD_STOP,
+    SENSOR_PIPE_CMD_RUN
+} sensor_pipe_cmd_t;
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t    seq;
+    uint32_t    crc;                /* CRC-32 of the used payload */
+    uint16_t    length;             /* Used payload bytes */
+    uint16_t    block_count;
+    uint32_t    raw_bytes;          /* Sample bytes before compression */
+} sensor_pipe_header_t;
+
+typedef struct
+{
+    sensor_pipe_header_t    header;
+    uint8_t                 payload[SENSOR_PIPE_PAYLOAD_SIZE];
+} CY_ALIGN(SENSOR_PIPE_CACHE_LINE) sensor_pipe_page_t;
+
+/* Written by the CM55 only */
+typedef struct
+{
+    volatile uint32_t   head;           /* Pages published */
+    uint32_t            blocks;
+    uint32_t            raw_bytes;
+    uint32_t            compressed_bytes;
+    uint32_t            busy_usec;      /* Sampling, compression and CRC */
+    uint32_t            stall_usec;     /* Waiting for a free page */
+    volatile uint32_t   stopped;        /* Set once the producer has quit */
+} CY_ALIGN(SENSOR_PIPE_CACHE_LINE) sensor_pipe_producer_t;
+
+/* Written by the CM33 only */
+typedef struct
+{
+    volatile uint32_t   magic;
+    volatile uint32_t   command;
+    volatile uint32_t   tail;           /* Pages released */
+} CY_ALIGN(SENSOR_PIPE_CACHE_LINE) sensor_pipe_consumer_t;
+
+typedef struct
+{
+    sensor_pipe_consumer_t  consumer;
+    sensor_pipe_producer_t  producer;
+    sensor_pipe_page_t      pages[SENSOR_PIPE_PAGE_COUNT];
+} sensor_pipe_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+/* CM33 */
+void sensor_pipe_init(sensor_pipe_t *pipe);
+void sensor_pipe_set_command(sensor_pipe_t *pipe, sensor_pipe_cmd_t command);
+sensor_pipe_page_t *sensor_pipe_peek(sensor_pipe_t *pipe);
+void sensor_pipe_release(sensor_pipe_t *pipe);
+void sensor_pipe_get_producer(sensor_pipe_t *pipe,
+                                sensor_pipe_producer_t *producer);
+
+/* CM55. RAM functions: the CM33 erases and programs the memory the CM55
+ * executes from while the producer runs.
+ */
+bool sensor_pipe_is_ready(sensor_pipe_t *pipe);
+sensor_pipe_cmd_t sensor_pipe_get_command(sensor_pipe_t *pipe);
+sensor_pipe_page_t *sensor_pipe_acquire(sensor_pipe_t *pipe);
+void sensor_pipe_publish(sensor_pipe_t *pipe);
+void sensor_pipe_set_stopped(sensor_pipe_t *pipe);
+bool sensor_pipe_is_drained(sensor_pipe_t *pipe);
+
+#endif /* _SENSOR_PIPE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * File Name        : xip_report.h
+ *
+ * Description      : This file describes the results of the CM55 XIP access
+ *                    benchmark, written by the CM55 and printed by the CM33.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _XIP_REPORT_H_
+#define _XIP_REPORT_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "cybsp.h"
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Set to 1U in both applications to run the XIP benchmark on the CM55 */
+#ifndef XIP_BENCH_ENABLE
+#define XIP_BENCH_ENABLE                    (0U)
+#endif
+
+#define XIP_REPORT_MAGIC                    (0x50495858UL)  /* "XXIP" */
+
+/*******************************************************************************
+ * Enumerations
+ ******************************************************************************/
+typedef enum
+{
+    XIP_REPORT_SEQUENTIAL,
+    XIP_REPORT_STRIDED,
+    XIP_REPORT_PATTERN_COUNT
+} xip_report_pattern_t;
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t    lines;              /* Cache lines fetched per run */
+    uint32_t    plain_nsec;
+    uint32_t    prefetch_nsec;
+} xip_report_result_t;
+
+typedef struct
+{
+    volatile uint32_t   magic;      /* Written last, once results are set */
+    uint32_t            table_size;
+    uint32_t            line_size;
+    uint32_t            stride;         /* Bytes between strided reads */
+    uint32_t            prefetch_lines; /* Prefetch distance */
+    xip_report_result_t results[XIP_REPORT_PATTERN_COUNT];
+} CY_ALIGN(32) xip_report_t;
+
+#endif /* _XIP_REPORT_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,627 @@
+/*******************************************************************************
+ * File Name        : flash_build_tool.c
+ *
+ * Description      : This file is a command-line tool that builds a complete
+ *                    factory image of the external memory with the firmware
+ *                    format code: the partition table, a key-value FIFO filled
+ *                    from a text file, and an asset archive protected by a CRC
+ *                    side table. Unused space stays erased (0xFF). The image is
+ *                    mounted again through the simulator before the tool exits.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/* getopt() is POSIX */
+#define _POSIX_C_SOURCE                     200809L
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_image.h"
+#include "flash_part.h"
+#include "flash_fifo.h"
+#include "flash_crc_table.h"
+#include "crc32.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define EXIT_BAD_INPUT                      (2)
+#define EXIT_VERIFY_FAILED                  (3)
+
+/* Partition table in sector 0, key-value FIFO right after it */
+#define TABLE_ADDR                          (0U)
+#define KV_DEFAULT_SECTORS                  (2U)
+#define KV_NAME                             "kv"
+#define ASSETS_NAME                         "assets"
+
+#define MAX_ASSETS                          (FLASH_PART_MAX_ENTRIES - 2U)
+
+/* Smallest granule of the asset CRC table; the table has one entry per
+ * granule, so larger archives use larger granules.
+ */
+#define MIN_GRANULE_SIZE                    (256U)
+
+/* Records dequeued per batch by the verification */
+#define VERIFY_BATCH_SIZE                   (64U)
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    const char  *name;
+    uint8_t     *data;
+    uint32_t    size;
+} asset_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static flash_sim_t build_sim;
+static flash_fifo_t build_fifo;
+static flash_crc_table_t build_crc_table;
+static flash_part_table_t build_table;
+static asset_t assets[MAX_ASSETS];
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: usage
+ *******************************************************************************
+ *
+ * Summary:
+ *  Prints the command line syntax.
+ *
+ * Parameters:
+ *  name - program name.
+ *
+ * Return:
+ *  int - exit status for a bad command line
+ *
+ ******************************************************************************/
+static int usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [-s size] [-e sector_size] [-k kv_sectors] [-c kv_file]\n"
+        "       -o image [asset ...]\n"
+        "kv_file holds one key=value record per line; empty lines and lines\n"
+        "starting with # are skipped. Assets are stored under their file\n"
+        "name, which must have at most %u characters.\n",
+        name, (unsigned int)FLASH_PART_NAME_SIZE);
+
+    return EXIT_BAD_INPUT;
+}
+
+/*******************************************************************************
+ * Function Name: round_up
+ *******************************************************************************
+ *
+ * Summary:
+ *  Rounds a value up to a multiple of a unit.
+ *
+ * Parameters:
+ *  value - value to round.
+ *  unit - rounding unit.
+ *
+ * Return:
+ *  uint32_t - rounded value
+ *
+ ******************************************************************************/
+static uint32_t round_up(uint32_t value, uint32_t unit)
+{
+    return ((value + unit - 1U) / unit) * unit;
+}
+
+/*******************************************************************************
+ * Function Name: load_asset
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads an asset file into memory.
+ *
+ * Parameters:
+ *  asset - receives the asset.
+ *  path - asset file; its base name is the name of the asset.
+ *
+ * Return:
+ *  bool - true if the file was read and its name fits the table
+ *
+ ******************************************************************************/
+static bool load_asset(asset_t *asset, const char *path)
+{
+    const char *slash = strrchr(path, '/');
+    FILE *file = fopen(path, "rb");
+    long size;
+
+    asset->name = (NULL != slash) ? (slash + 1) : path;
+
+    if ((NULL == file) || (FLASH_PART_NAME_SIZE < strlen(asset->name)) ||
+        (0 != fseek(file, 0L, SEEK_END)) || (0L >= (size = ftell(file))) ||
+        (size > INT32_MAX) || (0 != fseek(file, 0L, SEEK_SET)))
+    {
+        fprintf(stderr, "Cannot use asset %s\n", path);
+
+        if (NULL != file)
+        {
+            fclose(file);
+        }
+
+        return false;
+    }
+
+    asset->size = (uint32_t)size;
+    asset->data = malloc(asset->size);
+
+    if ((NULL == asset->data) ||
+        (asset->size != fread(asset->data, 1U, asset->size, file)))
+    {
+        fprintf(stderr, "Cannot read asset %s\n", path);
+        fclose(file);
+        return false;
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: write_kv
+ *******************************************************************************
+ *
+ * Summary:
+ *  Formats the key-value FIFO and enqueues one record per line of the
+ *  key-value file.
+ *
+ * Parameters:
+ *  mem - serial memory object of the image.
+ *  entry - FIFO partition.
+ *  path - key-value file, or NULL for an empty FIFO.
+ *  records - receives the number of records enqueued.
+ *
+ * Return:
+ *  bool - true on success
+ *
+ ******************************************************************************/
+static bool write_kv(mtb_serial_memory_t *mem, const flash_part_entry_t *entry,
+                        const char *path, uint32_t *records)
+{
+    char line[FLASH_FIFO_MAX_RECORD_SIZE + 2U];
+    FILE *file = NULL;
+    size_t length;
+    cy_rslt_t result = flash_fifo_init(&build_fifo, mem, entry->offset,
+                                        entry->size);
+
+    *records = 0U;
+
+    if ((CY_RSLT_SUCCESS == result) && (NULL != path))
+    {
+        file = fopen(path, "r");
+        result = (NULL == file) ? (cy_rslt_t)CY_SMIF_BAD_PARAM : result;
+    }
+
+    while ((CY_RSLT_SUCCESS == result) && (NULL != file) &&
+            (NULL != fgets(line, sizeof(line), file)))
+    {
+        length = strcspn(line, "\r\n");
+
+        if ((length == strlen(line)) && !feof(file))
+        {
+            fprintf(stderr, "Record longer than %u bytes in %s\n",
+                    (unsigned int)FLASH_FIFO_MAX_RECORD_SIZE, path);
+            result = (cy_rslt_t)CY_SMIF_BAD_PARAM;
+        }
+        else if ((0U != length) && ('#' != line[0]))
+        {
+            result = flash_fifo_enqueue(&build_fifo, (const uint8_t *)line,
+                                        (uint32_t)length);
+            *records += 1U;
+        }
+    }
+
+    if (NULL != file)
+    {
+        fclose(file);
+    }
+
+    result = (CY_RSLT_SUCCESS != result) ? result :
+                flash_fifo_flush(&build_fifo);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        fprintf(stderr, "Cannot fill the key-value FIFO: 0x%08"PRIX32"\n",
+                (uint32_t)result);
+    }
+
+    return (CY_RSLT_SUCCESS == result);
+}
+
+/*******************************************************************************
+ * Function Name: write_assets
+ *******************************************************************************
+ *
+ * Summary:
+ *  Programs the assets into the archive partition, each at a page boundary,
+ *  adds a FILE entry for each and builds the CRC table of the archive.
+ *
+ * Parameters:
+ *  mem - serial memory object of the image.
+ *  archive - DATA partition of the archive.
+ *  count - number of assets.
+ *
+ * Return:
+ *  bool - true on success
+ *
+ ******************************************************************************/
+static bool write_assets(mtb_serial_memory_t *mem,
+                            const flash_part_entry_t *archive, uint32_t count)
+{
+    uint32_t page_size = (uint32_t)mtb_serial_memory_get_prog_size(mem, 0U);
+    uint32_t address = archive->offset;
+    flash_part_entry_t *entry;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    for (uint32_t index = 0U; (index < count) &&
+        (CY_RSLT_SUCCESS == result); index++)
+    {
+        result = flash_part_add(&build_table, assets[index].name,
+                                FLASH_PART_TYPE_FILE, address,
+                                assets[index].size, &entry);
+
+        if (CY_RSLT_SUCCESS == result)
+        {
+            entry->crc = crc32(assets[index].data, assets[index].size);
+            result = mtb_serial_memory_write(mem, address, assets[index].size,
+                                                assets[index].data);
+        }
+
+        address += round_up(assets[index].size, page_size);
+    }
+
+    result = (CY_RSLT_SUCCESS != result) ? result :
+                flash_crc_table_init(&build_crc_table, mem, archive->offset,
+                                        archive->size, archive->granule,
+                                        archive->table_addr);
+    result = (CY_RSLT_SUCCESS != result) ? result :
+                flash_crc_table_build(&build_crc_table);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        fprintf(stderr, "Cannot write the assets: 0x%08"PRIX32"\n",
+                (uint32_t)result);
+    }
+
+    return (CY_RSLT_SUCCESS == result);
+}
+
+/*******************************************************************************
+ * Function Name: count_record
+ *******************************************************************************
+ *
+ * Summary:
+ *  Counts a record read back from the key-value FIFO.
+ *
+ * Parameters:
+ *  data - record; unused.
+ *  length - length of the record; unused.
+ *  arg - uint32_t counter.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void count_record(const uint8_t *data, uint32_t length, void *arg)
+{
+    (void)data;
+    (void)length;
+    *(uint32_t *)arg += 1U;
+}
+
+/*******************************************************************************
+ * Function Name: verify_image
+ *******************************************************************************
+ *
+ * Summary:
+ *  Maps the written image file and mounts it the way the firmware would:
+ *  loads the partition table, recovers the key-value FIFO and reads out its
+ *  records, checks the archive against its CRC table and every asset
+ *  against the CRC of its entry.
+ *
+ * Parameters:
+ *  path - image file.
+ *  config - geometry of the memory.
+ *  records - number of key-value records written.
+ *
+ * Return:
+ *  bool - true if the image mounts and all checks pass
+ *
+ ******************************************************************************/
+static bool verify_image(const char *path, const flash_sim_config_t *config,
+                            uint32_t records)
+{
+    static flash_image_t image;
+    static flash_part_table_t table;
+    const flash_part_entry_t *entry;
+    const flash_part_entry_t *archive;
+    uint32_t read_back = 0U;
+    uint32_t batch = 0U;
+    uint32_t bad = 0U;
+    uint32_t bad_granules;
+    uint8_t *buf = NULL;
+    cy_rslt_t result = flash_image_open(&image, path, config, false);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        fprintf(stderr, "Cannot map %s\n", path);
+        return false;
+    }
+
+    result = flash_part_load(&table, &image.mem, TABLE_ADDR);
+    entry = flash_part_find(&table, KV_NAME);
+    result = ((CY_RSLT_SUCCESS == result) && (NULL == entry)) ?
+                (cy_rslt_t)CY_SMIF_BAD_PARAM : result;
+    result = (CY_RSLT_SUCCESS != result) ? result :
+                flash_fifo_init(&build_fifo, &image.mem, entry->offset,
+                                entry->size);
+
+    do
+    {
+        result = (CY_RSLT_SUCCESS != result) ? result :
+                    flash_fifo_dequeue(&build_fifo, &count_record,
+                                        &read_back, VERIFY_BATCH_SIZE,
+                                        &batch);
+    }
+    while ((CY_RSLT_SUCCESS == result) && (0U < batch));
+
+    archive = flash_part_find(&table, ASSETS_NAME);
+
+    if ((CY_RSLT_SUCCESS == result) && (NULL != archive))
+    {
+        buf = malloc(archive->granule);
+        result = (NULL == buf) ? (cy_rslt_t)CY_SMIF_BAD_PARAM :
+                    flash_crc_table_init(&build_crc_table, &image.mem,
+                                            archive->offset, archive->size,
+                                            archive->granule,
+                                            archive->table_addr);
+        bad += ((CY_RSLT_SUCCESS == result) &&
+                !flash_crc_table_is_valid(&build_crc_table)) ? 1U : 0U;
+
+        for (uint32_t offset = 0U; (CY_RSLT_SUCCESS == result) &&
+            (0U == bad) && (offset < archive->size);
+            offset += archive->granule)
+        {
+            result = flash_crc_table_read(&build_crc_table,
+                                            archive->offset + offset,
+                                            archive->granule, buf,
+                                            &bad_granules);
+            bad += bad_granules;
+        }
+
+        free(buf);
+    }
+
+    /* Assets are checked in place, without copies */
+    for (uint32_t index = 0U; (CY_RSLT_SUCCESS == result) &&
+        (index < table.count); index++)
+    {
+        entry = &table.entries[index];
+
+        if ((FLASH_PART_TYPE_FILE == entry->type) &&
+            (entry->crc != crc32(flash_image_data(&image, entry->offset,
+                                                    entry->size),
+                                    entry->size)))
+        {
+            fprintf(stderr, "Asset %.*s does not match\n",
+                    (int)FLASH_PART_NAME_SIZE, entry->name);
+            bad++;
+        }
+    }
+
+    flash_image_close(&image);
+
+    if ((CY_RSLT_SUCCESS != result) || (0U != bad) ||
+        (read_back != records) || (0U != build_fifo.stats.torn_records))
+    {
+        fprintf(stderr, "Verification failed: 0x%08"PRIX32", %"PRIu32
+                " of %"PRIu32" records, %"PRIu32" bad checks\n",
+                (uint32_t)result, read_back, records, bad);
+        return false;
+    }
+
+    printf("Verified: partition table, %"PRIu32" records, %"PRIu32
+            " entries\n", read_back, table.count);
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: main
+ *******************************************************************************
+ *
+ * Summary:
+ *  Lays out the partitions, fills them in a simulated memory of the image
+ *  size, writes the whole memory to the image file and verifies it.
+ *
+ *  Layout, in sectors: the partition table, the key-value FIFO, the asset
+ *  archive rounded up to whole sectors, and the CRC table of the archive.
+ *
+ * Parameters:
+ *  argc - number of arguments.
+ *  argv - arguments.
+ *
+ * Return:
+ *  int - 0 on success, EXIT_BAD_INPUT for unusable arguments or inputs,
+ *  EXIT_VERIFY_FAILED if the image does not mount
+ *
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+    flash_sim_config_t config;
+    mtb_serial_memory_t mem;
+    flash_part_entry_t *kv;
+    flash_part_entry_t *archive = NULL;
+    const char *output = NULL;
+    const char *kv_path = NULL;
+    uint32_t kv_sectors = KV_DEFAULT_SECTORS;
+    uint32_t asset_count;
+    uint32_t archive_size = 0U;
+    uint32_t records = 0U;
+    FILE *file;
+    bool ok;
+    int opt;
+
+    flash_sim_get_default_config(&config);
+
+    while (-1 != (opt = getopt(argc, argv, "s:e:k:c:o:")))
+    {
+        switch (opt)
+        {
+            case 's':
+                config.size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'e':
+                config.erase_size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'k':
+                kv_sectors = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'c':
+                kv_path = optarg;
+                break;
+            case 'o':
+                output = optarg;
+                break;
+            default:
+                return usage(argv[0]);
+        }
+    }
+
+    asset_count = (uint32_t)(argc - optind);
+
+    if ((NULL == output) || (MAX_ASSETS < asset_count))
+    {
+        return usage(argv[0]);
+    }
+
+    config.bank_count = 1U;
+
+    if (CY_RSLT_SUCCESS != flash_sim_init(&build_sim, &config, NULL))
+    {
+        fprintf(stderr, "Invalid memory geometry\n");
+        return EXIT_BAD_INPUT;
+    }
+
+    flash_sim_attach(&build_sim, &mem, NULL);
+    flash_part_init(&build_table);
+
+    for (uint32_t index = 0U; index < asset_count; index++)
+    {
+        if (!load_asset(&assets[index], argv[optind + (int)index]))
+        {
+            return EXIT_BAD_INPUT;
+        }
+
+        archive_size += round_up(assets[index].size, config.program_size);
+    }
+
+    ok = (CY_RSLT_SUCCESS == flash_part_add(&build_table, KV_NAME,
+                                FLASH_PART_TYPE_FIFO, config.erase_size,
+                                kv_sectors * config.erase_size, &kv));
+
+    if (ok && (0U < asset_count))
+    {
+        archive_size = round_up(archive_size, config.erase_size);
+        ok = (CY_RSLT_SUCCESS == flash_part_add(&build_table, ASSETS_NAME,
+                                    FLASH_PART_TYPE_DATA,
+                                    kv->offset + kv->size, archive_size,
+                                    &archive));
+    }
+
+    if (ok && (NULL != archive))
+    {
+        archive->table_addr = archive->offset + archive->size;
+        archive->granule = round_up(archive->size /
+                                    FLASH_CRC_TABLE_MAX_ENTRIES,
+                                    MIN_GRANULE_SIZE);
+
+        /* The granule must divide the archive */
+        while (0U != (archive->size % archive->granule))
+        {
+            archive->granule += MIN_GRANULE_SIZE;
+        }
+
+        ok = ((archive->table_addr + config.erase_size) <= config.size);
+    }
+
+    ok = ok && ((kv->offset + kv->size) <= config.size) &&
+            write_kv(&mem, kv, kv_path, &records);
+    ok = ok && ((NULL == archive) ||
+                write_assets(&mem, archive, asset_count));
+    ok = ok && (CY_RSLT_SUCCESS == flash_part_save(&build_table, &mem,
+                                                    TABLE_ADDR));
+
+    if (!ok)
+    {
+        fprintf(stderr, "The partitions do not fit the memory\n");
+        return EXIT_BAD_INPUT;
+    }
+
+    file = fopen(output, "wb");
+
+    if ((NULL == file) ||
+        (config.size != fwrite(build_sim.data, 1U, config.size, file)) ||
+        (0 != fclose(file)))
+    {
+        fprintf(stderr, "Cannot write %s\n", output);
+        return EXIT_BAD_INPUT;
+    }
+
+    flash_sim_free(&build_sim);
+
+    for (uint32_t index = 0U; index < build_table.count; index++)
+    {
+        const flash_part_entry_t *entry = &build_table.entries[index];
+
+        printf("%-*.*s type %"PRIu32" at 0x%08"PRIX32", %"PRIu32
+                " bytes\n", (int)FLASH_PART_NAME_SIZE,
+                (int)FLASH_PART_NAME_SIZE, entry->name, entry->type,
+                entry->offset, entry->size);
+    }
+
+    return verify_image(output, &config, records) ? EXIT_SUCCESS :
+            EXIT_VERIFY_FAILED;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,899 @@
+/*******************************************************************************
+ * File Name        : flash_fuzz_tool.c
+ *
+ * Description      : This file is a fuzz target and random-run driver for the
+ *                    firmware flash modules on the simulator. Each input is
+ *                    decoded into raw read, write and erase calls and FIFO and
+ *                    config store calls; every read is compared with a RAM
+ *                    model that applies the NOR rules.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/* clock_gettime() and getopt() are POSIX */
+#define _POSIX_C_SOURCE                     200809L
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_sim.h"
+#include "flash_fifo.h"
+#include "flash_config.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define NSEC_PER_SEC                        (1000000000ULL)
+
+/* A small memory keeps flash_sim_reset() and the final check cheap */
+#define FUZZ_MEMORY_SIZE                    (0x40000UL)
+#define FUZZ_SECTOR_SIZE                    (0x1000UL)
+#define FUZZ_PAGE_SIZE                      (256U)
+
+/* Layout: raw sectors checked against the NOR model, then the FIFO
+ * partition, then the two sectors of the config store.
+ */
+#define RAW_BASE                            (0x00000UL)
+#define RAW_SIZE                            (0x10000UL)
+#define FIFO_BASE                           (0x10000UL)
+#define FIFO_SIZE                           (0x10000UL)
+#define CONFIG_BASE                         (0x20000UL)
+
+/* Largest raw transfer of one operation */
+#define MAX_TRANSFER                        (1024U)
+
+/* Records the reference FIFO can hold; more than the partition takes */
+#define MODEL_FIFO_RECORDS                  (1024U)
+
+/* Records dequeued per call at most */
+#define FIFO_BATCH_SIZE                     (16U)
+
+/* Random-run defaults */
+#define DEFAULT_RUNS                        (20000U)
+#define DEFAULT_INPUT_SIZE                  (512U)
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef enum
+{
+    OP_READ,
+    OP_WRITE,
+    OP_ERASE,
+    OP_FIFO_ENQUEUE,
+    OP_FIFO_FLUSH,
+    OP_FIFO_DEQUEUE,
+    OP_FIFO_REMOUNT,
+    OP_CONFIG_SET,
+    OP_CONFIG_POLL,
+    OP_CONFIG_FLUSH,
+    OP_CONFIG_REMOUNT,
+    OP_COUNT
+} fuzz_op_t;
+
+/* Input bytes consumed by the decoder; reads past the end return zero */
+typedef struct
+{
+    const uint8_t   *data;
+    size_t          size;
+    size_t          pos;
+} fuzz_input_t;
+
+/* Records enqueued and not yet dequeued, oldest first */
+typedef struct
+{
+    uint16_t    length[MODEL_FIFO_RECORDS];
+    uint8_t     seed[MODEL_FIFO_RECORDS];
+    uint32_t    head;
+    uint32_t    count;
+} fifo_model_t;
+
+typedef struct
+{
+    flash_sim_t             sim;
+    mtb_serial_memory_t     mem;
+    flash_cmd_t             cmd;
+    uint8_t                 nor[RAW_SIZE];  /* Reference image of RAW */
+    flash_fifo_t            fifo;
+    fifo_model_t            fifo_model;
+    flash_config_t          config;
+    uint32_t                values[FLASH_CONFIG_MAX_ENTRIES];
+    uint32_t                saved[FLASH_CONFIG_MAX_ENTRIES];
+    uint32_t                now_ms;
+    uint8_t                 buf[MAX_TRANSFER];
+    uint64_t                runs;
+    uint64_t                ops;
+} fuzz_state_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static fuzz_state_t fuzz;
+
+/* Power-on values of the config store */
+static const uint32_t config_defaults[FLASH_CONFIG_MAX_ENTRIES] = { 0U };
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: now_ns
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the host monotonic time.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint64_t - time in nanoseconds
+ *
+ ******************************************************************************/
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * NSEC_PER_SEC) + (uint64_t)ts.tv_nsec;
+}
+
+/*******************************************************************************
+ * Function Name: fail
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reports a mismatch with the reference model and aborts, so that
+ *  libFuzzer saves the input and the random driver stops at the run.
+ *
+ * Parameters:
+ *  what - description of the check that failed.
+ *  address - address or key involved.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void fail(const char *what, uint32_t address)
+{
+    fprintf(stderr, "Run %"PRIu64", operation %"PRIu64": %s at 0x%08"PRIX32
+            "\n", fuzz.runs, fuzz.ops, what, address);
+    abort();
+}
+
+/*******************************************************************************
+ * Function Name: check_result
+ *******************************************************************************
+ *
+ * Summary:
+ *  Fails on an error result of an operation that must succeed.
+ *
+ * Parameters:
+ *  result - result of the operation.
+ *  what - name of the operation.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void check_result(cy_rslt_t result, const char *what)
+{
+    if (CY_RSLT_SUCCESS != result)
+    {
+        fail(what, (uint32_t)result);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: get_byte
+ *******************************************************************************
+ *
+ * Summary:
+ *  Takes the next byte of the input.
+ *
+ * Parameters:
+ *  input - input being decoded.
+ *
+ * Return:
+ *  uint8_t - the byte, or zero past the end of the input
+ *
+ ******************************************************************************/
+static uint8_t get_byte(fuzz_input_t *input)
+{
+    return (input->pos < input->size) ? input->data[input->pos++] : 0U;
+}
+
+/*******************************************************************************
+ * Function Name: get_u16
+ *******************************************************************************
+ *
+ * Summary:
+ *  Takes the next two bytes of the input as a little-endian value.
+ *
+ * Parameters:
+ *  input - input being decoded.
+ *
+ * Return:
+ *  uint32_t - the value
+ *
+ ******************************************************************************/
+static uint32_t get_u16(fuzz_input_t *input)
+{
+    uint32_t value = get_byte(input);
+
+    return value | ((uint32_t)get_byte(input) << 8U);
+}
+
+/*******************************************************************************
+ * Function Name: fill_pattern
+ *******************************************************************************
+ *
+ * Summary:
+ *  Fills a buffer with a pattern derived from a seed byte, so that a record
+ *  or a write is described by a few input bytes.
+ *
+ * Parameters:
+ *  buf - buffer to fill.
+ *  length - size of the buffer.
+ *  seed - pattern seed.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void fill_pattern(uint8_t *buf, uint32_t length, uint8_t seed)
+{
+    for (uint32_t index = 0U; index < length; index++)
+    {
+        buf[index] = (uint8_t)((index * 0x9DU) ^ (seed * 0x3BU) ^
+                                (index >> 8U));
+    }
+}
+
+/*******************************************************************************
+ * Function Name: check_read
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads a range of the raw region and compares it with the NOR model.
+ *
+ * Parameters:
+ *  address - offset in the raw region.
+ *  length - size of the range, at most MAX_TRANSFER.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void check_read(uint32_t address, uint32_t length)
+{
+    check_result(mtb_serial_memory_read(&fuzz.mem, RAW_BASE + address, length,
+                                        fuzz.buf), "read");
+
+    for (uint32_t index = 0U; index < length; index++)
+    {
+        if (fuzz.buf[index] != fuzz.nor[address + index])
+        {
+            fail("read mismatch", RAW_BASE + address + index);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: op_read
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads a range of the raw region and compares it with the NOR model.
+ *
+ * Parameters:
+ *  input - input being decoded.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void op_read(fuzz_input_t *input)
+{
+    uint32_t address = get_u16(input) % RAW_SIZE;
+    uint32_t length = get_u16(input) % (MAX_TRANSFER + 1U);
+
+    length = ((address + length) > RAW_SIZE) ? (RAW_SIZE - address) : length;
+    check_read(address, length);
+}
+
+/*******************************************************************************
+ * Function Name: op_write
+ *******************************************************************************
+ *
+ * Summary:
+ *  Programs a range of the raw region. The model applies the NOR rule:
+ *  programming only clears bits.
+ *
+ * Parameters:
+ *  input - input being decoded.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void op_write(fuzz_input_t *input)
+{
+    uint32_t address = get_u16(input) % RAW_SIZE;
+    uint32_t length = get_u16(input) % (MAX_TRANSFER + 1U);
+
+    length = ((address + length) > RAW_SIZE) ? (RAW_SIZE - address) : length;
+    fill_pattern(fuzz.buf, length, get_byte(input));
+    check_result(mtb_serial_memory_write(&fuzz.mem, RAW_BASE + address,
+                                        length, fuzz.buf), "write");
+
+    for (uint32_t index = 0U; index < length; index++)
+    {
+        fuzz.nor[address + index] &= fuzz.buf[index];
+    }
+}
+
+/*******************************************************************************
+ * Function Name: op_erase
+ *******************************************************************************
+ *
+ * Summary:
+ *  Erases a sector of the raw region, or tries an unaligned erase that must
+ *  be refused and leave the memory unchanged.
+ *
+ * Parameters:
+ *  input - input being decoded.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void op_erase(fuzz_input_t *input)
+{
+    uint32_t sector = get_byte(input);
+    uint32_t address = (sector % (RAW_SIZE / FUZZ_SECTOR_SIZE)) *
+                        FUZZ_SECTOR_SIZE;
+
+    if (0U != (sector & 0x80U))
+    {
+        if (CY_RSLT_SUCCESS == mtb_serial_memory_erase(&fuzz.mem,
+                                RAW_BASE + address + FUZZ_PAGE_SIZE,
+                                FUZZ_SECTOR_SIZE))
+        {
+            fail("unaligned erase accepted", RAW_BASE + address);
+        }
+
+        return;
+    }
+
+    check_result(mtb_serial_memory_erase(&fuzz.mem, RAW_BASE + address,
+                                        FUZZ_SECTOR_SIZE), "erase");
+    memset(&fuzz.nor[address], FLASH_SIM_ERASED_VALUE, FUZZ_SECTOR_SIZE);
+}
+
+/*******************************************************************************
+ * Function Name: fifo_record
+ *******************************************************************************
+ *
+ * Summary:
+ *  Compares a dequeued record with the oldest record of the model and
+ *  removes it from the model.
+ *
+ * Parameters:
+ *  data - record.
+ *  length - length of the record.
+ *  arg - unused.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void fifo_record(const uint8_t *data, uint32_t length, void *arg)
+{
+    fifo_model_t *model = &fuzz.fifo_model;
+    uint8_t expected[FLASH_FIFO_MAX_RECORD_SIZE];
+
+    (void)arg;
+
+    if (0U == model->count)
+    {
+        fail("FIFO delivered an extra record", length);
+    }
+
+    if (length != model->length[model->head])
+    {
+        fail("FIFO record length", length);
+    }
+
+    fill_pattern(expected, length, model->seed[model->head]);
+
+    if (0 != memcmp(data, expected, length))
+    {
+        fail("FIFO record data", model->head);
+    }
+
+    model->head = (model->head + 1U) % MODEL_FIFO_RECORDS;
+    model->count--;
+}
+
+/*******************************************************************************
+ * Function Name: op_fifo
+ *******************************************************************************
+ *
+ * Summary:
+ *  Runs a FIFO operation. A full FIFO may refuse a record; a record it
+ *  takes must come out in order and unchanged. A remount after a flush
+ *  must keep every record, unless a batch was acknowledged in RAM only.
+ *
+ * Parameters:
+ *  op - FIFO operation.
+ *  input - input being decoded.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void op_fifo(fuzz_op_t op, fuzz_input_t *input)
+{
+    fifo_model_t *model = &fuzz.fifo_model;
+    uint32_t tail;
+    uint32_t length;
+    uint32_t count;
+    cy_rslt_t result;
+
+    switch (op)
+    {
+        case OP_FIFO_ENQUEUE:
+            length = 1U + (get_byte(input) % FLASH_FIFO_MAX_RECORD_SIZE);
+            tail = (model->head + model->count) % MODEL_FIFO_RECORDS;
+            model->length[tail] = (uint16_t)length;
+            model->seed[tail] = get_byte(input);
+            fill_pattern(fuzz.buf, length, model->seed[tail]);
+
+            if ((MODEL_FIFO_RECORDS > model->count) && (CY_RSLT_SUCCESS ==
+                flash_fifo_enqueue(&fuzz.fifo, fuzz.buf, length)))
+            {
+                model->count++;
+            }
+            break;
+
+        case OP_FIFO_FLUSH:
+            result = flash_fifo_flush(&fuzz.fifo);
+
+            if ((CY_RSLT_SUCCESS != result) &&
+                ((cy_rslt_t)CY_SMIF_BUSY != result))
+            {
+                fail("FIFO flush", (uint32_t)result);
+            }
+            break;
+
+        case OP_FIFO_DEQUEUE:
+            check_result(flash_fifo_dequeue(&fuzz.fifo, &fifo_record, NULL,
+                        1U + (get_byte(input) % FIFO_BATCH_SIZE), &count),
+                        "FIFO dequeue");
+            break;
+
+        default:
+            if ((CY_RSLT_SUCCESS != flash_fifo_flush(&fuzz.fifo)) ||
+                (0U != fuzz.fifo.stats.acks_in_ram))
+            {
+                break;
+            }
+
+            check_result(flash_fifo_init(&fuzz.fifo, &fuzz.mem, FIFO_BASE,
+                                        FIFO_SIZE), "FIFO remount");
+            break;
+    }
+
+    if (flash_fifo_is_empty(&fuzz.fifo) && (0U != model->count))
+    {
+        fail("FIFO lost records", model->count);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: op_config
+ *******************************************************************************
+ *
+ * Summary:
+ *  Runs a config store operation and compares every value with the model.
+ *  A remount without a flush must return the values of the last flush.
+ *
+ * Parameters:
+ *  op - config operation.
+ *  input - input being decoded.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void op_config(fuzz_op_t op, fuzz_input_t *input)
+{
+    uint32_t key;
+    uint32_t value;
+
+    switch (op)
+    {
+        case OP_CONFIG_SET:
+            key = get_byte(input) % FLASH_CONFIG_MAX_ENTRIES;
+            value = get_u16(input) * 0x10001UL;
+            check_result(flash_config_set(&fuzz.config, key, value,
+                                        fuzz.now_ms), "config set");
+            fuzz.values[key] = value;
+            break;
+
+        case OP_CONFIG_POLL:
+            fuzz.now_ms += get_u16(input);
+            check_result(flash_config_poll(&fuzz.config, fuzz.now_ms),
+                        "config poll");
+            break;
+
+        case OP_CONFIG_FLUSH:
+            check_result(flash_config_flush(&fuzz.config), "config flush");
+            break;
+
+        default:
+            check_result(flash_config_init(&fuzz.config, &fuzz.mem,
+                        CONFIG_BASE, config_defaults), "config remount");
+            memcpy(fuzz.values, fuzz.saved, sizeof(fuzz.values));
+            break;
+    }
+
+    if (0U == fuzz.config.dirty)
+    {
+        memcpy(fuzz.saved, fuzz.values, sizeof(fuzz.saved));
+    }
+
+    for (key = 0U; key < FLASH_CONFIG_MAX_ENTRIES; key++)
+    {
+        if (flash_config_get(&fuzz.config, key) != fuzz.values[key])
+        {
+            fail("config value", key);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: fuzz_setup
+ *******************************************************************************
+ *
+ * Summary:
+ *  Creates the simulated memory once.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void fuzz_setup(void)
+{
+    flash_sim_config_t config;
+
+    flash_sim_get_default_config(&config);
+    config.size = FUZZ_MEMORY_SIZE;
+    config.erase_size = FUZZ_SECTOR_SIZE;
+    config.program_size = FUZZ_PAGE_SIZE;
+
+    if (CY_RSLT_SUCCESS != flash_sim_init(&fuzz.sim, &config, NULL))
+    {
+        fprintf(stderr, "Cannot create the simulated memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    flash_sim_attach(&fuzz.sim, &fuzz.mem, &fuzz.cmd);
+}
+
+/*******************************************************************************
+ * Function Name: fuzz_run
+ *******************************************************************************
+ *
+ * Summary:
+ *  Runs one input: resets the memory and the models, decodes the input into
+ *  operations and checks each of them, then reads back the whole raw region.
+ *  A FIFO or config operation that programs a byte without erasing it
+ *  first is reported through the program_conflicts counter.
+ *
+ * Parameters:
+ *  data - input.
+ *  size - size of the input.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void fuzz_run(const uint8_t *data, size_t size)
+{
+    fuzz_input_t input = { data, size, 0U };
+    uint32_t conflicts;
+    fuzz_op_t op;
+
+    flash_sim_reset(&fuzz.sim);
+    memset(fuzz.nor, FLASH_SIM_ERASED_VALUE, sizeof(fuzz.nor));
+    memset(&fuzz.fifo_model, 0, sizeof(fuzz.fifo_model));
+    memcpy(fuzz.values, config_defaults, sizeof(fuzz.values));
+    memcpy(fuzz.saved, config_defaults, sizeof(fuzz.saved));
+    fuzz.now_ms = 0U;
+
+    check_result(flash_fifo_init(&fuzz.fifo, &fuzz.mem, FIFO_BASE,
+                                FIFO_SIZE), "FIFO mount");
+    check_result(flash_config_init(&fuzz.config, &fuzz.mem, CONFIG_BASE,
+                                    config_defaults), "config mount");
+
+    while (input.pos < input.size)
+    {
+        op = (fuzz_op_t)(get_byte(&input) % (uint8_t)OP_COUNT);
+        conflicts = fuzz.sim.stats.program_conflicts;
+        fuzz.ops++;
+
+        switch (op)
+        {
+            case OP_READ:
+                op_read(&input);
+                break;
+            case OP_WRITE:
+                op_write(&input);
+                break;
+            case OP_ERASE:
+                op_erase(&input);
+                break;
+            case OP_FIFO_ENQUEUE:
+            case OP_FIFO_FLUSH:
+            case OP_FIFO_DEQUEUE:
+            case OP_FIFO_REMOUNT:
+                op_fifo(op, &input);
+                break;
+            default:
+                op_config(op, &input);
+                break;
+        }
+
+        if ((op > OP_ERASE) &&
+            (conflicts != fuzz.sim.stats.program_conflicts))
+        {
+            fail("program without erase", (uint32_t)op);
+        }
+    }
+
+    for (uint32_t address = 0U; address < RAW_SIZE; address += MAX_TRANSFER)
+    {
+        check_read(address, MAX_TRANSFER);
+    }
+
+    fuzz.runs++;
+}
+
+/*******************************************************************************
+ * Function Name: report
+ *******************************************************************************
+ *
+ * Summary:
+ *  Prints the number of runs and operations and their rate.
+ *
+ * Parameters:
+ *  elapsed_ns - host time of the runs.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void report(uint64_t elapsed_ns)
+{
+    elapsed_ns = (0U == elapsed_ns) ? 1U : elapsed_ns;
+
+    printf("Runs: %"PRIu64", operations: %"PRIu64"\n", fuzz.runs, fuzz.ops);
+    printf("Iterations per second: %"PRIu64" (%"PRIu64" operations/s)\n",
+            (uint64_t)((fuzz.runs * NSEC_PER_SEC) / elapsed_ns),
+            (uint64_t)((fuzz.ops * NSEC_PER_SEC) / elapsed_ns));
+}
+
+#if defined(FLASH_FUZZ_LIBFUZZER)
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static uint64_t fuzz_start_ns;
+
+/*******************************************************************************
+ * Function Name: fuzz_exit
+ *******************************************************************************
+ *
+ * Summary:
+ *  Prints the iteration rate when libFuzzer exits.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void fuzz_exit(void)
+{
+    report(now_ns() - fuzz_start_ns);
+}
+
+/*******************************************************************************
+ * Function Name: LLVMFuzzerInitialize
+ *******************************************************************************
+ *
+ * Summary:
+ *  Creates the simulated memory before the first input.
+ *
+ * Parameters:
+ *  argc - unused.
+ *  argv - unused.
+ *
+ * Return:
+ *  int - always 0
+ *
+ ******************************************************************************/
+int LLVMFuzzerInitialize(int *argc, char ***argv)
+{
+    (void)argc;
+    (void)argv;
+
+    fuzz_setup();
+    fuzz_start_ns = now_ns();
+    atexit(&fuzz_exit);
+
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: LLVMFuzzerTestOneInput
+ *******************************************************************************
+ *
+ * Summary:
+ *  Runs one input generated by libFuzzer.
+ *
+ * Parameters:
+ *  data - input.
+ *  size - size of the input.
+ *
+ * Return:
+ *  int - always 0
+ *
+ ******************************************************************************/
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    fuzz_run(data, size);
+
+    return 0;
+}
+
+#else /* Random runs */
+/*******************************************************************************
+ * Function Name: next_random
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the next value of a xorshift32 generator.
+ *
+ * Parameters:
+ *  state - generator state, never zero.
+ *
+ * Return:
+ *  uint32_t - the value
+ *
+ ******************************************************************************/
+static uint32_t next_random(uint32_t *state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13U;
+    x ^= x >> 17U;
+    x ^= x << 5U;
+    *state = x;
+
+    return x;
+}
+
+/*******************************************************************************
+ * Function Name: main
+ *******************************************************************************
+ *
+ * Summary:
+ *  Runs random inputs through the same decoder as the libFuzzer target and
+ *  prints the iteration rate. A failing run prints its index and aborts;
+ *  the seed and the run count reproduce it.
+ *
+ * Parameters:
+ *  argc - number of arguments.
+ *  argv - arguments.
+ *
+ * Return:
+ *  int - exit status
+ *
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static uint8_t input[UINT16_MAX];
+    uint32_t seed = 1U;
+    uint32_t runs = DEFAULT_RUNS;
+    uint32_t max_size = DEFAULT_INPUT_SIZE;
+    uint32_t size;
+    uint64_t start;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "s:n:l:")))
+    {
+        switch (opt)
+        {
+            case 's':
+                seed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                runs = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'l':
+                max_size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-s seed] [-n runs] "
+                        "[-l max_input_size]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    seed = (0U == seed) ? 1U : seed;
+    max_size = ((0U == max_size) || (sizeof(input) < max_size)) ?
+                DEFAULT_INPUT_SIZE : max_size;
+
+    fuzz_setup();
+    printf("Seed %"PRIu32", %"PRIu32" runs of up to %"PRIu32" bytes\n", seed,
+            runs, max_size);
+    start = now_ns();
+
+    for (uint32_t run = 0U; run < runs; run++)
+    {
+        size = 1U + (next_random(&seed) % max_size);
+
+        for (uint32_t index = 0U; index < size; index++)
+        {
+            input[index] = (uint8_t)next_random(&seed);
+        }
+
+        fuzz_run(input, size);
+    }
+
+    report(now_ns() - start);
+    flash_sim_free(&fuzz.sim);
+
+    return EXIT_SUCCESS;
+}
+#endif /* defined(FLASH_FUZZ_LIBFUZZER) */
+
+/* [] END OF FILE */
@@ -0,0 +1,246 @@
+/*******************************************************************************
+ * File Name        : flash_idle_tool.c
+ *
+ * Description      : This file is a command-line tool that runs periodic reads
+ *                    on the simulator through the deep power-down wrappers of
+ *                    flash_dpd.c and compares the idle energy of the memory
+ *                    with and without deep power-down.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/* clock_gettime() and getopt() are POSIX */
+#define _POSIX_C_SOURCE                     200809L
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_sim.h"
+#include "flash_dpd.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define NSEC_PER_MSEC                       (1000000ULL)
+#define MSEC_PER_SEC                        (1000U)
+#define PJ_PER_UJ                           (1000000ULL)
+#define PERCENT                             (100U)
+
+/* A small memory is enough; only the idle current matters here */
+#define IDLE_MEMORY_SIZE                    (0x100000UL)
+#define IDLE_READ_SIZE                      (256U)
+
+/* Simulated time of each workload */
+#define DEFAULT_DURATION_SEC                (60U)
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint64_t            energy_pj;
+    uint32_t            failed_reads;
+    uint32_t            stray_accesses;     /* Reads of a powered-down memory */
+    uint32_t            timeout_ms;
+    flash_dpd_stats_t   stats;
+} idle_result_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static flash_sim_t sim;
+static mtb_serial_memory_t mem;
+static flash_cmd_t cmd;
+static flash_dpd_t dpd_obj;
+static uint8_t read_buf[IDLE_READ_SIZE];
+
+/* Time between two reads of each workload. At 150 ms the memory would be
+ * powered down for less than the break-even time, so the timeout backs off.
+ */
+static const uint32_t access_periods_ms[] = { 10U, 150U, 1000U, 10000U };
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: run_workload
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads the memory every period_ms through flash_dpd_read() for the given
+ *  simulated time, in 1 ms steps. With deep power-down, flash_dpd_poll() is
+ *  called at every step as the firmware does from its idle loop.
+ *
+ * Parameters:
+ *  period_ms - time between two reads.
+ *  duration_ms - simulated time.
+ *  use_dpd - true to power the memory down when idle.
+ *  out - receives the idle energy and the statistics.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void run_workload(uint32_t period_ms, uint32_t duration_ms,
+                            bool use_dpd, idle_result_t *out)
+{
+    uint64_t start_ns;
+    uint64_t target_ns;
+
+    flash_sim_reset(&sim);
+    (void)flash_dpd_init(&dpd_obj, &cmd, 0U);
+    start_ns = flash_sim_time_ns();
+    out->failed_reads = 0U;
+
+    for (uint32_t now_ms = 0U; now_ms < duration_ms; now_ms++)
+    {
+        target_ns = start_ns + ((uint64_t)now_ms * NSEC_PER_MSEC);
+
+        if (flash_sim_time_ns() < target_ns)
+        {
+            flash_sim_advance_ns(target_ns - flash_sim_time_ns());
+        }
+
+        if ((0U == (now_ms % period_ms)) &&
+            (CY_RSLT_SUCCESS != flash_dpd_read(&dpd_obj, &mem, 0U,
+                                                IDLE_READ_SIZE, read_buf,
+                                                now_ms)))
+        {
+            out->failed_reads++;
+        }
+
+        if (use_dpd)
+        {
+            (void)flash_dpd_poll(&dpd_obj, now_ms);
+        }
+    }
+
+    target_ns = start_ns + ((uint64_t)duration_ms * NSEC_PER_MSEC);
+
+    if (flash_sim_time_ns() < target_ns)
+    {
+        flash_sim_advance_ns(target_ns - flash_sim_time_ns());
+    }
+
+    out->energy_pj = flash_sim_get_idle_energy_pj(&sim);
+    out->stray_accesses = sim.stats.accesses_while_powered_down;
+    out->timeout_ms = dpd_obj.timeout_ms;
+    out->stats = dpd_obj.stats;
+}
+
+/*******************************************************************************
+ * Function Name: main
+ *******************************************************************************
+ *
+ * Summary:
+ *  Runs each access period once with the memory in standby between reads
+ *  and once with deep power-down, and prints the idle energy of both from
+ *  flash_sim_get_idle_energy_pj() with the deep power-down statistics.
+ *
+ * Parameters:
+ *  argc - number of arguments.
+ *  argv - arguments.
+ *
+ * Return:
+ *  int - exit status; EXIT_FAILURE if a read failed
+ *
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+    flash_sim_config_t config;
+    idle_result_t standby;
+    idle_result_t dpd;
+    uint32_t duration_sec = DEFAULT_DURATION_SEC;
+    uint32_t failures = 0U;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "d:")))
+    {
+        if ('d' != opt)
+        {
+            fprintf(stderr, "Usage: %s [-d seconds]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        duration_sec = (uint32_t)strtoul(optarg, NULL, 0);
+    }
+
+    flash_sim_get_default_config(&config);
+    config.size = IDLE_MEMORY_SIZE;
+
+    if ((0U == duration_sec) ||
+        (CY_RSLT_SUCCESS != flash_sim_init(&sim, &config, NULL)))
+    {
+        fprintf(stderr, "Cannot create the simulated memory\n");
+        return EXIT_FAILURE;
+    }
+
+    flash_sim_attach(&sim, &mem, &cmd);
+
+    printf("Idle energy over %"PRIu32" s, break-even %"PRIu32" ms\n",
+            duration_sec, (uint32_t)FLASH_DPD_BREAK_EVEN_MS);
+    printf("Period   Standby    DPD        Saved  Wakes  Wake max  "
+            "Timeout  Stray\n");
+
+    for (uint32_t index = 0U; index < (sizeof(access_periods_ms) /
+            sizeof(access_periods_ms[0U])); index++)
+    {
+        run_workload(access_periods_ms[index], duration_sec * MSEC_PER_SEC,
+                        false, &standby);
+        run_workload(access_periods_ms[index], duration_sec * MSEC_PER_SEC,
+                        true, &dpd);
+        failures += standby.failed_reads + dpd.failed_reads;
+
+        printf("%5"PRIu32" ms %7"PRIu64" uJ %7"PRIu64" uJ %5"PRIu64"%% "
+                "%6"PRIu32" %6"PRIu32" us %5"PRIu32" ms %6"PRIu32"\n",
+                access_periods_ms[index],
+                (uint64_t)(standby.energy_pj / PJ_PER_UJ),
+                (uint64_t)(dpd.energy_pj / PJ_PER_UJ),
+                (dpd.energy_pj < standby.energy_pj) ?
+                (uint64_t)(((standby.energy_pj - dpd.energy_pj) * PERCENT) /
+                standby.energy_pj) : 0U,
+                dpd.stats.wakes, dpd.stats.wake_usec_max, dpd.timeout_ms,
+                dpd.stray_accesses);
+    }
+
+    flash_sim_free(&sim);
+
+    if (0U != failures)
+    {
+        fprintf(stderr, "%"PRIu32" reads failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
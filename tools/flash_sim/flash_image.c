@@ -0,0 +1,188 @@
+/*******************************************************************************
+ * File Name        : flash_image.c
+ *
+ * Description      : This file maps a flash dump file into memory and uses
+ *                    the mapping as the image of a simulated memory, so the
+ *                    firmware modules can analyze field dumps on a Linux host
+ *                    and scanners can read the dump without copies.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/* mmap() and fstat() are POSIX; dumps may be larger than 2 GB */
+#define _POSIX_C_SOURCE                     200809L
+#define _FILE_OFFSET_BITS                   64
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_image.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: flash_image_open
+ *******************************************************************************
+ *
+ * Summary:
+ *  Maps a dump file and sets up a simulated memory over it. The memory size
+ *  is the file size, which must be a multiple of the sector size of the
+ *  configuration and fit 32-bit addresses; the rest of the configuration is
+ *  used as given. The mapping is read sequentially by the kernel ahead of
+ *  the accesses, which suits the scanners.
+ *
+ * Parameters:
+ *  image - image object.
+ *  path - dump file.
+ *  config - geometry and timing of the memory; size is ignored.
+ *  writable - write programs and erases back to the file.
+ *
+ * Return:
+ *  cy_rslt_t - CY_RSLT_SUCCESS, or FLASH_SIM_RSLT_BAD_PARAM if the file
+ *  cannot be mapped or does not match the geometry
+ *
+ ******************************************************************************/
+cy_rslt_t flash_image_open(flash_image_t *image, const char *path,
+                            const flash_sim_config_t *config, bool writable)
+{
+    flash_sim_config_t image_config = *config;
+    struct stat st;
+    cy_rslt_t result;
+
+    memset(image, 0, sizeof(*image));
+    image->writable = writable;
+    image->fd = open(path, writable ? O_RDWR : O_RDONLY);
+
+    if (0 > image->fd)
+    {
+        return FLASH_SIM_RSLT_BAD_PARAM;
+    }
+
+    if ((0 != fstat(image->fd, &st)) || (0 >= st.st_size) ||
+        ((uint64_t)st.st_size > UINT32_MAX) ||
+        (0U == config->erase_size) ||
+        (0U != ((uint64_t)st.st_size % config->erase_size)))
+    {
+        close(image->fd);
+        return FLASH_SIM_RSLT_BAD_PARAM;
+    }
+
+    image->size = (size_t)st.st_size;
+    image->map = mmap(NULL, image->size, PROT_READ | PROT_WRITE,
+                        writable ? MAP_SHARED : MAP_PRIVATE, image->fd, 0);
+
+    if (MAP_FAILED == image->map)
+    {
+        close(image->fd);
+        return FLASH_SIM_RSLT_BAD_PARAM;
+    }
+
+    (void)posix_madvise(image->map, image->size, POSIX_MADV_SEQUENTIAL);
+
+    image_config.size = (uint32_t)image->size;
+    result = flash_sim_init(&image->sim, &image_config, image->map);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        munmap(image->map, image->size);
+        close(image->fd);
+        return result;
+    }
+
+    flash_sim_attach(&image->sim, &image->mem, &image->cmd);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: flash_image_close
+ *******************************************************************************
+ *
+ * Summary:
+ *  Releases the simulated memory and the mapping. The changes made to a
+ *  writable image are written to the file first.
+ *
+ * Parameters:
+ *  image - image object.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_image_close(flash_image_t *image)
+{
+    flash_sim_free(&image->sim);
+
+    if (image->writable)
+    {
+        (void)msync(image->map, image->size, MS_SYNC);
+    }
+
+    munmap(image->map, image->size);
+    close(image->fd);
+    image->map = NULL;
+    image->fd = -1;
+}
+
+/*******************************************************************************
+ * Function Name: flash_image_data
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns a pointer into the mapping for scanners that read the image
+ *  directly instead of copying it out with mtb_serial_memory_read(). These
+ *  accesses do not advance the virtual clock.
+ *
+ * Parameters:
+ *  image - image object.
+ *  address - memory address.
+ *  length - number of bytes the caller will access.
+ *
+ * Return:
+ *  const uint8_t * - data at address, or NULL if the range is outside the
+ *  image
+ *
+ ******************************************************************************/
+const uint8_t *flash_image_data(const flash_image_t *image, uint32_t address,
+                                uint32_t length)
+{
+    if (((uint64_t)address + length) > image->size)
+    {
+        return NULL;
+    }
+
+    return &image->map[address];
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * File Name        : flash_image.h
+ *
+ * Description      : This file is the public interface of flash_image.c,
+ *                    which maps a flash dump file into memory as the image of a
+ *                    simulated memory.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_IMAGE_H_
+#define _FLASH_IMAGE_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_sim.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+/* A dump file mapped as the image of a simulated memory. Unless the image
+ * is opened writable, the mapping is private: the firmware modules can
+ * program and erase it, for instance during recovery, and the file is left
+ * as it is.
+ */
+typedef struct
+{
+    flash_sim_t             sim;
+    mtb_serial_memory_t     mem;
+    flash_cmd_t             cmd;
+    int                     fd;
+    uint8_t                 *map;
+    size_t                  size;
+    bool                    writable;
+} flash_image_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+cy_rslt_t flash_image_open(flash_image_t *image, const char *path,
+                            const flash_sim_config_t *config, bool writable);
+void flash_image_close(flash_image_t *image);
+const uint8_t *flash_image_data(const flash_image_t *image, uint32_t address,
+                                uint32_t length);
+
+#endif /* _FLASH_IMAGE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,472 @@
+/*******************************************************************************
+ * File Name        : flash_image_tool.c
+ *
+ * Description      : This file is a command-line tool that analyzes a raw flash
+ *                    dump with the firmware modules of proj_cm33_ns: the image
+ *                    statistics, the mount and recovery of a persistent FIFO,
+ *                    and the integrity check of a region protected by a CRC
+ *                    side table.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/* clock_gettime() is POSIX */
+#define _POSIX_C_SOURCE                     200809L
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_image.h"
+#include "flash_fifo.h"
+#include "flash_crc_table.h"
+#include "crc32.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define EXIT_BAD_IMAGE                      (2)
+#define EXIT_CHECK_FAILED                   (3)
+
+#define NSEC_PER_SEC                        (1000000000ULL)
+#define BYTES_PER_MIB                       (1048576U)
+
+/* Records dequeued per batch by the FIFO check */
+#define FIFO_BATCH_SIZE                     (64U)
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t    records;
+    uint64_t    bytes;
+} fifo_count_t;
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: usage
+ *******************************************************************************
+ *
+ * Summary:
+ *  Prints the command line syntax.
+ *
+ * Parameters:
+ *  name - program name.
+ *
+ * Return:
+ *  int - exit status for a bad command line
+ *
+ ******************************************************************************/
+static int usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [-e sector_size] [-p page_size] [-w] image command\n"
+        "Commands:\n"
+        "  stats                              sector and page usage, CRC-32\n"
+        "  fifo base size                     mount the FIFO, read it out\n"
+        "  crc base size granule table_addr   check a CRC side table\n"
+        "Numbers may be given in hex with 0x. The image is not modified "
+        "unless -w is given.\n", name);
+
+    return EXIT_FAILURE;
+}
+
+/*******************************************************************************
+ * Function Name: now_ns
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the host monotonic time.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint64_t - time in nanoseconds
+ *
+ ******************************************************************************/
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * NSEC_PER_SEC) + (uint64_t)ts.tv_nsec;
+}
+
+/*******************************************************************************
+ * Function Name: is_erased
+ *******************************************************************************
+ *
+ * Summary:
+ *  Checks whether a range holds erased bytes only, a word at a time.
+ *
+ * Parameters:
+ *  data - start of the range; any alignment.
+ *  length - size of the range.
+ *
+ * Return:
+ *  bool - true if every byte is FLASH_SIM_ERASED_VALUE
+ *
+ ******************************************************************************/
+static bool is_erased(const uint8_t *data, uint32_t length)
+{
+    uint64_t word;
+    uint32_t index = 0U;
+
+    for (; (index + sizeof(word)) <= length; index += sizeof(word))
+    {
+        memcpy(&word, &data[index], sizeof(word));
+
+        if (UINT64_MAX != word)
+        {
+            return false;
+        }
+    }
+
+    for (; index < length; index++)
+    {
+        if (FLASH_SIM_ERASED_VALUE != data[index])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: run_stats
+ *******************************************************************************
+ *
+ * Summary:
+ *  Scans the mapping directly and prints the erased and programmed sectors,
+ *  the blank pages of the programmed sectors, and the CRC-32 of the image.
+ *
+ * Parameters:
+ *  image - image object.
+ *
+ * Return:
+ *  int - exit status
+ *
+ ******************************************************************************/
+static int run_stats(const flash_image_t *image)
+{
+    uint32_t sector_size = image->sim.config.erase_size;
+    uint32_t page_size = image->sim.config.program_size;
+    uint32_t sectors = (uint32_t)(image->size / sector_size);
+    uint32_t erased_sectors = 0U;
+    uint32_t blank_pages = 0U;
+    uint32_t crc = CRC32_INIT;
+    uint64_t start = now_ns();
+    uint64_t elapsed;
+    const uint8_t *sector_data;
+
+    for (uint32_t sector = 0U; sector < sectors; sector++)
+    {
+        sector_data = flash_image_data(image, sector * sector_size,
+                                        sector_size);
+        crc = crc32_update(crc, sector_data, sector_size);
+
+        if (is_erased(sector_data, sector_size))
+        {
+            erased_sectors++;
+            continue;
+        }
+
+        for (uint32_t page = 0U; page < sector_size; page += page_size)
+        {
+            blank_pages += is_erased(&sector_data[page], page_size) ? 1U : 0U;
+        }
+    }
+
+    elapsed = now_ns() - start;
+
+    printf("Size: %zu bytes, %"PRIu32" sectors of %"PRIu32" bytes\n",
+            image->size, sectors, sector_size);
+    printf("Erased sectors: %"PRIu32", programmed: %"PRIu32"\n",
+            erased_sectors, sectors - erased_sectors);
+    printf("Blank pages in programmed sectors: %"PRIu32" of %"PRIu32"\n",
+            blank_pages,
+            (sectors - erased_sectors) * (sector_size / page_size));
+    printf("CRC-32: 0x%08"PRIX32"\n", crc32_final(crc));
+    printf("Scanned at %"PRIu64" MiB/s\n", (uint64_t)((0U == elapsed) ? 0U :
+            ((uint64_t)image->size * NSEC_PER_SEC) /
+            (elapsed * BYTES_PER_MIB)));
+
+    return EXIT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: fifo_record
+ *******************************************************************************
+ *
+ * Summary:
+ *  Counts a record read out of the FIFO.
+ *
+ * Parameters:
+ *  data - record; unused.
+ *  length - length of the record.
+ *  arg - fifo_count_t to update.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void fifo_record(const uint8_t *data, uint32_t length, void *arg)
+{
+    fifo_count_t *count = arg;
+
+    (void)data;
+    count->records++;
+    count->bytes += length;
+}
+
+/*******************************************************************************
+ * Function Name: run_fifo
+ *******************************************************************************
+ *
+ * Summary:
+ *  Mounts a persistent FIFO the way the firmware does after a reset and
+ *  reads out every pending record.
+ *
+ * Parameters:
+ *  image - image object.
+ *  base - start of the FIFO partition.
+ *  size - size of the partition.
+ *
+ * Return:
+ *  int - exit status
+ *
+ ******************************************************************************/
+static int run_fifo(flash_image_t *image, uint32_t base, uint32_t size)
+{
+    static flash_fifo_t fifo;
+    fifo_count_t count = { 0U, 0U };
+    uint32_t batch = 0U;
+    cy_rslt_t result = flash_fifo_init(&fifo, &image->mem, base, size);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        fprintf(stderr, "Mount failed: 0x%08"PRIX32"\n", (uint32_t)result);
+        return EXIT_CHECK_FAILED;
+    }
+
+    printf("Mounted: head sector %"PRIu32", tail sector %"PRIu32
+            " (sequence %"PRIu32"), torn records %"PRIu32"\n",
+            fifo.head_sector, fifo.tail_sector, fifo.tail_seq,
+            fifo.stats.torn_records);
+
+    do
+    {
+        result = flash_fifo_dequeue(&fifo, &fifo_record, &count,
+                                    FIFO_BATCH_SIZE, &batch);
+    }
+    while ((CY_RSLT_SUCCESS == result) && (0U < batch));
+
+    printf("Pending records: %"PRIu32" (%"PRIu64" bytes)\n", count.records,
+            count.bytes);
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        fprintf(stderr, "Read-out failed: 0x%08"PRIX32"\n", (uint32_t)result);
+        return EXIT_CHECK_FAILED;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: run_crc
+ *******************************************************************************
+ *
+ * Summary:
+ *  Reads a region through its CRC side table and lists the granules whose
+ *  CRC does not match.
+ *
+ * Parameters:
+ *  image - image object.
+ *  base - start of the protected region.
+ *  size - size of the region.
+ *  granule - granule size of the table.
+ *  table_addr - sector of the table.
+ *
+ * Return:
+ *  int - exit status
+ *
+ ******************************************************************************/
+static int run_crc(flash_image_t *image, uint32_t base, uint32_t size,
+                    uint32_t granule, uint32_t table_addr)
+{
+    static flash_crc_table_t table;
+    uint32_t bad_total = 0U;
+    uint32_t bad;
+    uint8_t *buf;
+    cy_rslt_t result = flash_crc_table_init(&table, &image->mem, base, size,
+                                            granule, table_addr);
+
+    if ((CY_RSLT_SUCCESS != result) || !flash_crc_table_is_valid(&table))
+    {
+        fprintf(stderr, "No valid CRC table for this region\n");
+        return EXIT_CHECK_FAILED;
+    }
+
+    buf = malloc(granule);
+
+    if (NULL == buf)
+    {
+        return EXIT_FAILURE;
+    }
+
+    for (uint32_t offset = 0U; (offset < size) &&
+        (CY_RSLT_SUCCESS == result); offset += granule)
+    {
+        result = flash_crc_table_read(&table, base + offset, granule, buf,
+                                        &bad);
+
+        if (0U != bad)
+        {
+            printf("CRC mismatch at 0x%08"PRIX32"\n", base + offset);
+            bad_total++;
+        }
+    }
+
+    free(buf);
+    printf("Granules checked: %"PRIu32", bad: %"PRIu32"\n",
+            size / granule, bad_total);
+
+    return ((CY_RSLT_SUCCESS != result) || (0U != bad_total)) ?
+            EXIT_CHECK_FAILED : EXIT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: main
+ *******************************************************************************
+ *
+ * Summary:
+ *  Maps the image and runs the requested command. The exit status is 0 when
+ *  the check passes, EXIT_CHECK_FAILED when it finds a problem and
+ *  EXIT_BAD_IMAGE when the image cannot be mapped.
+ *
+ * Parameters:
+ *  argc - number of arguments.
+ *  argv - arguments.
+ *
+ * Return:
+ *  int - exit status
+ *
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static flash_image_t image;
+    flash_sim_config_t config;
+    bool writable = false;
+    const char *command;
+    uint32_t args[4U];
+    uint32_t arg_count;
+    int status;
+    int opt;
+
+    flash_sim_get_default_config(&config);
+
+    while (-1 != (opt = getopt(argc, argv, "e:p:w")))
+    {
+        switch (opt)
+        {
+            case 'e':
+                config.erase_size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'p':
+                config.program_size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                writable = true;
+                break;
+            default:
+                return usage(argv[0]);
+        }
+    }
+
+    if ((argc - optind) < 2)
+    {
+        return usage(argv[0]);
+    }
+
+    command = argv[optind + 1];
+    arg_count = (uint32_t)(argc - optind - 2);
+
+    for (uint32_t index = 0U; (index < arg_count) && (index < 4U); index++)
+    {
+        args[index] = (uint32_t)strtoul(argv[optind + 2 + (int)index],
+                                        NULL, 0);
+    }
+
+    /* Bank and timing parameters do not matter for an offline analysis */
+    config.bank_count = 1U;
+
+    if ((0U == config.program_size) ||
+        (0U != (config.erase_size % config.program_size)) ||
+        (CY_RSLT_SUCCESS != flash_image_open(&image, argv[optind], &config,
+                                            writable)))
+    {
+        fprintf(stderr, "Cannot map %s as a memory with %"PRIu32
+                "-byte sectors\n", argv[optind], config.erase_size);
+        return EXIT_BAD_IMAGE;
+    }
+
+    if ((0 == strcmp(command, "stats")) && (0U == arg_count))
+    {
+        status = run_stats(&image);
+    }
+    else if ((0 == strcmp(command, "fifo")) && (2U == arg_count))
+    {
+        status = run_fifo(&image, args[0U], args[1U]);
+    }
+    else if ((0 == strcmp(command, "crc")) && (4U == arg_count))
+    {
+        status = run_crc(&image, args[0U], args[1U], args[2U], args[3U]);
+    }
+    else
+    {
+        status = usage(argv[0]);
+    }
+
+    flash_image_close(&image);
+
+    return status;
+}
+
+/* [] END OF FILE */
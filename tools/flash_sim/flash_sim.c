@@ -0,0 +1,873 @@
+/*******************************************************************************
+ * File Name        : flash_sim.c
+ *
+ * Description      : This file simulates a serial NOR flash on the host. It
+ *                    implements the serial-memory library functions and the raw
+ *                    command interface of flash_cmd.h over a RAM image. Program
+ *                    only clears bits, erase sets whole sectors to 0xFF, and a
+ *                    virtual clock advances by the datasheet time of each
+ *                    operation. Each bank tracks its own busy period so reads
+ *                    of idle banks proceed while another bank is erasing.
+ *                    Deep power-down is tracked with a standby current model
+ *                    and accesses to a powered-down memory fail.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "flash_sim.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define NSEC_PER_USEC                       (1000U)
+#define SIM_ADDR_BYTES                      (4U)
+#define BITS_PER_BYTE                       (8U)
+
+/* mV x uA x ns gives attojoules */
+#define AJ_PER_PJ                           (1000000U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Virtual time shared by all simulated memories */
+static uint64_t sim_now_ns;
+
+/*******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Function Name: in_range
+ *******************************************************************************
+ *
+ * Summary:
+ *  Checks that an access lies within the memory.
+ *
+ * Parameters:
+ *  sim - simulated memory.
+ *  addr - start address of the access.
+ *  length - length of the access.
+ *
+ * Return:
+ *  bool - true if the access is within the memory
+ *
+ ******************************************************************************/
+static bool in_range(const flash_sim_t *sim, uint32_t addr, size_t length)
+{
+    return (addr <= sim->config.size) && (length <= sim->config.size - addr);
+}
+
+/*******************************************************************************
+ * Function Name: is_memory_mapped
+ *******************************************************************************
+ *
+ * Summary:
+ *  Checks whether the memory is configured for XIP, which the firmware
+ *  must not leave busy with an operation started in the background.
+ *
+ * Parameters:
+ *  sim - simulated memory.
+ *
+ * Return:
+ *  bool - true if the memory is memory-mapped
+ *
+ ******************************************************************************/
+static bool is_memory_mapped(const flash_sim_t *sim)
+{
+    return (0U != (sim->mem_config.flags & CY_SMIF_FLAG_MEMORY_MAPPED));
+}
+
+/*******************************************************************************
+ * Function Name: is_powered_down
+ *******************************************************************************
+ *
+ * Summary:
+ *  Checks whether the memory ignores accesses because it is in deep
+ *  power-down, and counts such accesses.
+ *
+ * Parameters:
+ *  sim - simulated memory.
+ *
+ * Return:
+ *  bool - true if the memory is in deep power-down
+ *
+ ******************************************************************************/
+static bool is_powered_down(flash_sim_t *sim)
+{
+    if (sim->powered_down)
+    {
+        sim->stats.accesses_while_powered_down++;
+    }
+
+    return sim->powered_down;
+}
+
+/*******************************************************************************
+ * Function Name: wait_bank
+ *******************************************************************************
+ *
+ * Summary:
+ *  Advances the virtual time until the bank that holds the address is idle.
+ *
+ * Parameters:
+ *  sim - simulated memory.
+ *  addr - address within the bank.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void wait_bank(flash_sim_t *sim, uint32_t addr)
+{
+    uint64_t busy_until = sim->bank_busy_until_ns[addr / sim->bank_size];
+
+    if (busy_until > sim_now_ns)
+    {
+        sim->stats.read_stall_ns += busy_until - sim_now_ns;
+        sim_now_ns = busy_until;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: wait_device
+ *******************************************************************************
+ *
+ * Summary:
+ *  Advances the virtual time until all banks are idle.
+ *
+ * Parameters:
+ *  sim - simulated memory.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void wait_device(flash_sim_t *sim)
+{
+    for (uint32_t bank = 0U; bank < sim->config.bank_count; bank++)
+    {
+        if (sim->bank_busy_until_ns[bank] > sim_now_ns)
+        {
+            sim_now_ns = sim->bank_busy_until_ns[bank];
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: mark_dirty
+ *******************************************************************************
+ *
+ * Summary:
+ *  Records that the sectors of a range hold programmed data.
+ *
+ * Parameters:
+ *  sim - simulated memory.
+ *  addr - start address of the range.
+ *  length - length of the range, not 0.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void mark_dirty(flash_sim_t *sim, uint32_t addr, size_t length)
+{
+    uint32_t last = (uint32_t)((addr + length - 1U) / sim->config.erase_size);
+
+    for (uint32_t sector = addr / sim->config.erase_size; sector <= last;
+        sector++)
+    {
+        sim->dirty[sector / BITS_PER_BYTE] |=
+                                    (uint8_t)(1U << (sector % BITS_PER_BYTE));
+    }
+}
+
+/*******************************************************************************
+ * Function Name: erase_sector
+ *******************************************************************************
+ *
+ * Summary:
+ *  Sets a sector to the erased value.
+ *
+ * Parameters:
+ *  sim - simulated memory.
+ *  sector - index of the sector.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void erase_sector(flash_sim_t *sim, uint32_t sector)
+{
+    memset(&sim->data[sector * sim->config.erase_size],
+            FLASH_SIM_ERASED_VALUE, sim->config.erase_size);
+    sim->dirty[sector / BITS_PER_BYTE] &=
+                                    (uint8_t)~(1U << (sector % BITS_PER_BYTE));
+}
+
+/*******************************************************************************
+ * Function Name: program_bytes
+ *******************************************************************************
+ *
+ * Summary:
+ *  Programs bytes of one page: bits can only be cleared. Bytes that would
+ *  need a bit set back to 1 are counted as conflicts.
+ *
+ * Parameters:
+ *  sim - simulated memory.
+ *  addr - address of the first byte.
+ *  buf - data to program.
+ *  length - number of bytes, within one page.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void program_bytes(flash_sim_t *sim, uint32_t addr, const uint8_t *buf,
+                            uint32_t length)
+{
+    for (uint32_t index = 0U; index < length; index++)
+    {
+        if (0U != (buf[index] & (uint8_t)~sim->data[addr + index]))
+        {
+            sim->stats.program_conflicts++;
+        }
+
+        sim->data[addr + index] &= buf[index];
+    }
+
+    sim->stats.pages_programmed++;
+}
+
+/*******************************************************************************
+ * Function Name: sim_read
+ *******************************************************************************
+ *
+ * Summary:
+ *  Copies data out of the image and books the transfer time.
+ *
+ * Parameters:
+ *  sim - simulated memory.
+ *  addr - address to read from.
+ *  length - number of bytes to read.
+ *  buf - destination buffer.
+ *  setup_ns - duration of the command phases before the data.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void sim_read(flash_sim_t *sim, uint32_t addr, size_t length,
+                    uint8_t *buf, uint32_t setup_ns)
+{
+    wait_bank(sim, addr);
+    memcpy(buf, &sim->data[addr], length);
+
+    sim_now_ns += setup_ns + (uint64_t)length * sim->config.read_ns_per_byte;
+    sim->stats.reads++;
+    sim->stats.bytes_read += length;
+}
+
+/*******************************************************************************
+ * Function Name: flash_sim_get_default_config
+ *******************************************************************************
+ *
+ * Summary:
+ *  Fills in the default geometry and timing of the simulated memory.
+ *
+ * Parameters:
+ *  config - configuration to fill in.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_sim_get_default_config(flash_sim_config_t *config)
+{
+    config->size = FLASH_SIM_DEFAULT_SIZE;
+    config->erase_size = FLASH_SIM_DEFAULT_ERASE_SIZE;
+    config->program_size = FLASH_SIM_DEFAULT_PROGRAM_SIZE;
+    config->bank_count = FLASH_SIM_DEFAULT_BANK_COUNT;
+    config->opcode_ns = FLASH_SIM_DEFAULT_OPCODE_NS;
+    config->read_setup_ns = FLASH_SIM_DEFAULT_READ_SETUP_NS;
+    config->read_ns_per_byte = FLASH_SIM_DEFAULT_READ_NS_PER_BYTE;
+    config->program_us = FLASH_SIM_DEFAULT_PROGRAM_US;
+    config->erase_us = FLASH_SIM_DEFAULT_ERASE_US;
+    config->chip_erase_us = FLASH_SIM_DEFAULT_CHIP_ERASE_US;
+    config->vcc_mv = FLASH_ENERGY_DEFAULT_VCC_MV;
+    config->standby_ua = FLASH_ENERGY_DEFAULT_STANDBY_UA;
+    config->dpd_ua = FLASH_ENERGY_DEFAULT_DPD_UA;
+}
+
+/*******************************************************************************
+ * Function Name: flash_sim_init
+ *******************************************************************************
+ *
+ * Summary:
+ *  Initializes a simulated memory. The memory is backed by the given image,
+ *  or by an erased image allocated here when data is NULL.
+ *
+ * Parameters:
+ *  sim - simulated memory to initialize.
+ *  config - geometry and timing of the memory.
+ *  data - image of config->size bytes, or NULL.
+ *
+ * Return:
+ *  cy_rslt_t - FLASH_SIM_RSLT_BAD_PARAM if the geometry is invalid or the
+ *  image cannot be allocated
+ *
+ ******************************************************************************/
+cy_rslt_t flash_sim_init(flash_sim_t *sim, const flash_sim_config_t *config,
+                        uint8_t *data)
+{
+    memset(sim, 0, sizeof(*sim));
+    sim->config = *config;
+
+    if ((0U == config->bank_count) ||
+        (FLASH_SIM_MAX_BANKS < config->bank_count) ||
+        (0U == config->erase_size) || (0U == config->program_size) ||
+        (0U != (config->size % config->erase_size)) ||
+        (0U != (config->size % config->bank_count)))
+    {
+        return FLASH_SIM_RSLT_BAD_PARAM;
+    }
+
+    sim->dirty = calloc((config->size / config->erase_size +
+                            BITS_PER_BYTE - 1U) / BITS_PER_BYTE, 1U);
+
+    if (NULL == sim->dirty)
+    {
+        return FLASH_SIM_RSLT_BAD_PARAM;
+    }
+
+    if (NULL == data)
+    {
+        data = malloc(config->size);
+
+        if (NULL == data)
+        {
+            free(sim->dirty);
+            sim->dirty = NULL;
+            return FLASH_SIM_RSLT_BAD_PARAM;
+        }
+
+        memset(data, FLASH_SIM_ERASED_VALUE, config->size);
+        sim->owns_data = true;
+    }
+    else
+    {
+        /* The content of a caller image is unknown; reset erases it all */
+        mark_dirty(sim, 0U, config->size);
+    }
+
+    sim->data = data;
+    sim->bank_size = config->size / config->bank_count;
+    sim->created_ns = sim_now_ns;
+
+    sim->read_cmd.command = 0xEBU;
+    sim->read_cmd.mode = CY_SMIF_NO_COMMAND_OR_MODE;
+    sim->read_cmd.dummyCycles = 0U;
+    sim->device_cfg.numOfAddrBytes = SIM_ADDR_BYTES;
+    sim->device_cfg.memSize = config->size;
+    sim->device_cfg.readCmd = &sim->read_cmd;
+    sim->device_cfg.eraseSize = config->erase_size;
+    sim->device_cfg.programSize = config->program_size;
+    sim->mem_config.flags = 0U;
+    sim->mem_config.deviceCfg = &sim->device_cfg;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: flash_sim_free
+ *******************************************************************************
+ *
+ * Summary:
+ *  Releases the image allocated by flash_sim_init().
+ *
+ * Parameters:
+ *  sim - simulated memory.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_sim_free(flash_sim_t *sim)
+{
+    if (sim->owns_data)
+    {
+        free(sim->data);
+    }
+
+    free(sim->dirty);
+    sim->data = NULL;
+    sim->dirty = NULL;
+    sim->owns_data = false;
+}
+
+/*******************************************************************************
+ * Function Name: flash_sim_reset
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the memory to the erased, idle, powered-up state and clears the
+ *  statistics. Only the sectors programmed since the last erase are
+ *  rewritten, so a reset after a short operation sequence costs little even
+ *  for a large memory; host programs that run many short sequences reset
+ *  between them instead of setting the memory up again.
+ *
+ * Parameters:
+ *  sim - simulated memory.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_sim_reset(flash_sim_t *sim)
+{
+    uint32_t sector_count = sim->config.size / sim->config.erase_size;
+
+    for (uint32_t sector = 0U; sector < sector_count; sector += BITS_PER_BYTE)
+    {
+        if (0U == sim->dirty[sector / BITS_PER_BYTE])
+        {
+            continue;
+        }
+
+        for (uint32_t bit = 0U; (bit < BITS_PER_BYTE) &&
+            ((sector + bit) < sector_count); bit++)
+        {
+            if (0U != (sim->dirty[sector / BITS_PER_BYTE] & (1U << bit)))
+            {
+                erase_sector(sim, sector + bit);
+            }
+        }
+    }
+
+    memset(sim->bank_busy_until_ns, 0, sizeof(sim->bank_busy_until_ns));
+    memset(&sim->stats, 0, sizeof(sim->stats));
+    sim->powered_down = false;
+    sim->created_ns = sim_now_ns;
+}
+
+/*******************************************************************************
+ * Function Name: flash_sim_attach
+ *******************************************************************************
+ *
+ * Summary:
+ *  Points a serial memory object and, optionally, a raw command interface at
+ *  the simulated memory. Takes the place of mtb_serial_memory_setup().
+ *
+ * Parameters:
+ *  sim - simulated memory.
+ *  mem - serial memory object.
+ *  cmd - raw command interface, may be NULL.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_sim_attach(flash_sim_t *sim, mtb_serial_memory_t *mem,
+                        flash_cmd_t *cmd)
+{
+    mem->base = sim;
+
+    if (NULL != cmd)
+    {
+        flash_cmd_init(cmd, sim, &mem->context, &sim->mem_config);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: flash_sim_time_ns
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the virtual time.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint64_t - virtual time in nanoseconds
+ *
+ ******************************************************************************/
+uint64_t flash_sim_time_ns(void)
+{
+    return sim_now_ns;
+}
+
+/*******************************************************************************
+ * Function Name: flash_sim_advance_ns
+ *******************************************************************************
+ *
+ * Summary:
+ *  Advances the virtual time, e.g. to model CPU work between operations.
+ *
+ * Parameters:
+ *  ns - time to add in nanoseconds.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_sim_advance_ns(uint64_t ns)
+{
+    sim_now_ns += ns;
+}
+
+/*******************************************************************************
+ * Function Name: flash_sim_get_idle_energy_pj
+ *******************************************************************************
+ *
+ * Summary:
+ *  Returns the energy the memory has drawn in standby and deep power-down
+ *  since it was initialized. Time spent in operations is booked as standby;
+ *  flash_energy.c accounts for operations.
+ *
+ * Parameters:
+ *  sim - simulated memory.
+ *
+ * Return:
+ *  uint64_t - energy in picojoules
+ *
+ ******************************************************************************/
+uint64_t flash_sim_get_idle_energy_pj(const flash_sim_t *sim)
+{
+    uint64_t dpd_ns = sim->stats.dpd_ns;
+    uint64_t total_ns = sim_now_ns - sim->created_ns;
+
+    if (sim->powered_down)
+    {
+        dpd_ns += sim_now_ns - sim->dpd_start_ns;
+    }
+
+    return ((uint64_t)sim->config.vcc_mv *
+            ((uint64_t)sim->config.standby_ua * (total_ns - dpd_ns) +
+            (uint64_t)sim->config.dpd_ua * dpd_ns)) / AJ_PER_PJ;
+}
+
+/*******************************************************************************
+ * Serial-memory library
+ ******************************************************************************/
+size_t mtb_serial_memory_get_size(mtb_serial_memory_t *obj)
+{
+    return obj->base->config.size;
+}
+
+size_t mtb_serial_memory_get_erase_size(mtb_serial_memory_t *obj,
+                                        uint32_t addr)
+{
+    (void)addr;
+    return obj->base->config.erase_size;
+}
+
+size_t mtb_serial_memory_get_prog_size(mtb_serial_memory_t *obj,
+                                        uint32_t addr)
+{
+    (void)addr;
+    return obj->base->config.program_size;
+}
+
+cy_rslt_t mtb_serial_memory_read(mtb_serial_memory_t *obj, uint32_t addr,
+                                size_t length, uint8_t *buf)
+{
+    flash_sim_t *sim = obj->base;
+
+    if (!in_range(sim, addr, length))
+    {
+        return FLASH_SIM_RSLT_BAD_PARAM;
+    }
+
+    if (is_powered_down(sim))
+    {
+        return FLASH_SIM_RSLT_BUSY;
+    }
+
+    sim_read(sim, addr, length, buf, sim->config.read_setup_ns);
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_serial_memory_write(mtb_serial_memory_t *obj, uint32_t addr,
+                                size_t length, const uint8_t *buf)
+{
+    flash_sim_t *sim = obj->base;
+    uint32_t chunk;
+
+    if (!in_range(sim, addr, length))
+    {
+        return FLASH_SIM_RSLT_BAD_PARAM;
+    }
+
+    if (is_powered_down(sim))
+    {
+        return FLASH_SIM_RSLT_BUSY;
+    }
+
+    wait_device(sim);
+
+    if (0U < length)
+    {
+        mark_dirty(sim, addr, length);
+    }
+
+    /* The library splits writes at page boundaries */
+    while (0U < length)
+    {
+        chunk = sim->config.program_size - (addr % sim->config.program_size);
+        chunk = (chunk > length) ? (uint32_t)length : chunk;
+
+        program_bytes(sim, addr, buf, chunk);
+        sim_now_ns += (uint64_t)sim->config.program_us * NSEC_PER_USEC;
+        addr += chunk;
+        buf += chunk;
+        length -= chunk;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_serial_memory_erase(mtb_serial_memory_t *obj, uint32_t addr,
+                                size_t length)
+{
+    flash_sim_t *sim = obj->base;
+
+    if (!in_range(sim, addr, length) ||
+        (0U != (addr % sim->config.erase_size)) ||
+        (0U != (length % sim->config.erase_size)))
+    {
+        return FLASH_SIM_RSLT_BAD_PARAM;
+    }
+
+    if (is_powered_down(sim))
+    {
+        return FLASH_SIM_RSLT_BUSY;
+    }
+
+    wait_device(sim);
+
+    for (size_t offset = 0U; offset < length; offset += sim->config.erase_size)
+    {
+        erase_sector(sim, (uint32_t)((addr + offset) / sim->config.erase_size));
+        sim_now_ns += (uint64_t)sim->config.erase_us * NSEC_PER_USEC;
+        sim->stats.sectors_erased++;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Raw command interface
+ ******************************************************************************/
+void flash_cmd_init(flash_cmd_t *cmd, SMIF_Type *base,
+                    cy_stc_smif_context_t *context,
+                    cy_stc_smif_mem_config_t *mem_config)
+{
+    cmd->base = base;
+    cmd->context = context;
+    cmd->mem_config = mem_config;
+    cmd->saved_intr = 0U;
+    cmd->restore_memory_mode = false;
+}
+
+void flash_cmd_begin(flash_cmd_t *cmd)
+{
+    (void)cmd;
+}
+
+void flash_cmd_end(flash_cmd_t *cmd)
+{
+    (void)cmd;
+}
+
+cy_en_smif_status_t flash_cmd_send(flash_cmd_t *cmd, uint8_t opcode)
+{
+    flash_sim_t *sim = cmd->base;
+
+    sim_now_ns += sim->config.opcode_ns;
+
+    if ((FLASH_CMD_DEEP_POWER_DOWN == opcode) && !sim->powered_down)
+    {
+        sim->powered_down = true;
+        sim->dpd_start_ns = sim_now_ns;
+        sim->stats.dpd_entries++;
+    }
+    else if ((FLASH_CMD_RELEASE_POWER_DOWN == opcode) && sim->powered_down)
+    {
+        sim->powered_down = false;
+        sim->stats.dpd_ns += sim_now_ns - sim->dpd_start_ns;
+    }
+    else
+    {
+        /* Other opcodes have no effect on the simulated memory */
+    }
+
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t flash_cmd_read(flash_cmd_t *cmd, uint32_t address,
+                                    uint32_t length, uint8_t *buf,
+                                    uint32_t mode, bool skip_opcode)
+{
+    flash_sim_t *sim = cmd->base;
+
+    (void)mode;
+
+    if (!in_range(sim, address, length))
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+
+    if (is_powered_down(sim))
+    {
+        return CY_SMIF_BUSY;
+    }
+
+    sim_read(sim, address, length, buf, skip_opcode ?
+                (sim->config.read_setup_ns - sim->config.opcode_ns) :
+                sim->config.read_setup_ns);
+
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t flash_cmd_erase_start(flash_cmd_t *cmd, uint32_t address)
+{
+    flash_sim_t *sim = cmd->base;
+    uint32_t sector = address - (address % sim->config.erase_size);
+
+    if (!in_range(sim, address, 1U) || is_memory_mapped(sim))
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+
+    if (is_powered_down(sim) || flash_cmd_is_busy(cmd))
+    {
+        return CY_SMIF_BUSY;
+    }
+
+    /* Reads of the bank wait for the erase, so the data can change now */
+    erase_sector(sim, sector / sim->config.erase_size);
+    sim->bank_busy_until_ns[sector / sim->bank_size] = sim_now_ns +
+                        (uint64_t)sim->config.erase_us * NSEC_PER_USEC;
+    sim->stats.sectors_erased++;
+
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t flash_cmd_program_start(flash_cmd_t *cmd,
+                                            uint32_t address,
+                                            const uint8_t *data,
+                                            uint32_t length)
+{
+    flash_sim_t *sim = cmd->base;
+    uint32_t page_offset = address % sim->config.program_size;
+
+    if (!in_range(sim, address, length) || (0U == length) ||
+        ((page_offset + length) > sim->config.program_size) ||
+        is_memory_mapped(sim))
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+
+    if (is_powered_down(sim) || flash_cmd_is_busy(cmd))
+    {
+        return CY_SMIF_BUSY;
+    }
+
+    /* Write enable, then the opcode, address and data phases */
+    sim_now_ns += (2U * (uint64_t)sim->config.opcode_ns) +
+                    ((uint64_t)length * sim->config.read_ns_per_byte);
+    mark_dirty(sim, address, length);
+    program_bytes(sim, address, data, length);
+    sim->bank_busy_until_ns[address / sim->bank_size] = sim_now_ns +
+                        (uint64_t)sim->config.program_us * NSEC_PER_USEC;
+
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t flash_cmd_chip_erase_start(flash_cmd_t *cmd)
+{
+    flash_sim_t *sim = cmd->base;
+    uint32_t sector_count = sim->config.size / sim->config.erase_size;
+
+    if (is_memory_mapped(sim))
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+
+    if (is_powered_down(sim) || flash_cmd_is_busy(cmd))
+    {
+        return CY_SMIF_BUSY;
+    }
+
+    sim_now_ns += 2U * (uint64_t)sim->config.opcode_ns;
+
+    for (uint32_t sector = 0U; sector < sector_count; sector++)
+    {
+        erase_sector(sim, sector);
+    }
+
+    for (uint32_t bank = 0U; bank < sim->config.bank_count; bank++)
+    {
+        sim->bank_busy_until_ns[bank] = sim_now_ns +
+                        (uint64_t)sim->config.chip_erase_us * NSEC_PER_USEC;
+    }
+
+    sim->stats.chip_erases++;
+
+    return CY_SMIF_SUCCESS;
+}
+
+bool flash_cmd_is_busy(flash_cmd_t *cmd)
+{
+    flash_sim_t *sim = cmd->base;
+    bool busy = false;
+
+    /* A status register read costs about as much as a short read */
+    sim_now_ns += sim->config.read_setup_ns;
+    sim->stats.status_polls++;
+
+    for (uint32_t bank = 0U; bank < sim->config.bank_count; bank++)
+    {
+        busy = busy || (sim->bank_busy_until_ns[bank] > sim_now_ns);
+    }
+
+    return busy;
+}
+
+void flash_cmd_delay_us(flash_cmd_t *cmd, uint32_t usec)
+{
+    (void)cmd;
+    sim_now_ns += (uint64_t)usec * NSEC_PER_USEC;
+}
+
+/* [] END OF FILE */
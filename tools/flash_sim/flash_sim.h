@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * File Name        : flash_sim.h
+ *
+ * Description      : This file is the public interface of flash_sim.c, a host
+ *                    simulator of a serial NOR flash with a timing model and
+ *                    read-while-write banks.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _FLASH_SIM_H_
+#define _FLASH_SIM_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include "mtb_serial_memory.h"
+#include "flash_cmd.h"
+#include "flash_energy.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define FLASH_SIM_MAX_BANKS                 (8U)
+#define FLASH_SIM_ERASED_VALUE              (0xFFU)
+
+/* Typical parameters of a 512 Mbit quad SPI NOR flash at 100 MHz */
+#define FLASH_SIM_DEFAULT_SIZE              (0x4000000UL)
+#define FLASH_SIM_DEFAULT_ERASE_SIZE        (0x40000UL)
+#define FLASH_SIM_DEFAULT_PROGRAM_SIZE      (256U)
+#define FLASH_SIM_DEFAULT_BANK_COUNT        (1U)
+#define FLASH_SIM_DEFAULT_OPCODE_NS         (80U)
+#define FLASH_SIM_DEFAULT_READ_SETUP_NS     (260U)
+#define FLASH_SIM_DEFAULT_READ_NS_PER_BYTE  (20U)
+#define FLASH_SIM_DEFAULT_PROGRAM_US        (340U)
+#define FLASH_SIM_DEFAULT_ERASE_US          (500000U)
+#define FLASH_SIM_DEFAULT_CHIP_ERASE_US     (100000000U)
+
+/*******************************************************************************
+ * Data Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t    size;
+    uint32_t    erase_size;
+    uint32_t    program_size;
+    uint32_t    bank_count;
+    uint32_t    opcode_ns;          /* Opcode phase of a command */
+    uint32_t    read_setup_ns;      /* Opcode, address, mode and dummy phases */
+    uint32_t    read_ns_per_byte;
+    uint32_t    program_us;         /* tPP of one page */
+    uint32_t    erase_us;           /* tSE of one sector */
+    uint32_t    chip_erase_us;      /* tCE of the whole memory */
+    uint32_t    vcc_mv;
+    uint32_t    standby_ua;
+    uint32_t    dpd_ua;
+} flash_sim_config_t;
+
+typedef struct
+{
+    uint32_t    reads;
+    uint64_t    bytes_read;
+    uint32_t    pages_programmed;
+    uint32_t    sectors_erased;
+    uint32_t    chip_erases;
+    uint32_t    status_polls;
+    uint64_t    read_stall_ns;
+    uint32_t    dpd_entries;
+    uint64_t    dpd_ns;
+    uint32_t    accesses_while_powered_down;
+    uint32_t    program_conflicts;  /* Bytes programmed without an erase */
+} flash_sim_stats_t;
+
+struct flash_sim
+{
+    flash_sim_config_t              config;
+    uint8_t                         *data;
+    bool                            owns_data;
+    uint8_t                         *dirty;     /* Bit per written sector */
+    uint32_t                        bank_size;
+    uint64_t                        bank_busy_until_ns[FLASH_SIM_MAX_BANKS];
+    bool                            powered_down;
+    uint64_t                        dpd_start_ns;
+    uint64_t                        created_ns;
+    cy_stc_smif_mem_cmd_t           read_cmd;
+    cy_stc_smif_mem_device_cfg_t    device_cfg;
+    cy_stc_smif_mem_config_t        mem_config;
+    flash_sim_stats_t               stats;
+};
+
+typedef struct flash_sim flash_sim_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void flash_sim_get_default_config(flash_sim_config_t *config);
+cy_rslt_t flash_sim_init(flash_sim_t *sim, const flash_sim_config_t *config,
+                        uint8_t *data);
+void flash_sim_free(flash_sim_t *sim);
+void flash_sim_reset(flash_sim_t *sim);
+void flash_sim_attach(flash_sim_t *sim, mtb_serial_memory_t *mem,
+                        flash_cmd_t *cmd);
+uint64_t flash_sim_time_ns(void);
+void flash_sim_advance_ns(uint64_t ns);
+uint64_t flash_sim_get_idle_energy_pj(const flash_sim_t *sim);
+
+#endif /* _FLASH_SIM_H_ */
+
+/* [] END OF FILE */
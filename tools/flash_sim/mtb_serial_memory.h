@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * File Name        : mtb_serial_memory.h
+ *
+ * Description      : Host replacement of the serial-memory library interface.
+ *                    It declares the subset of the library and PDL types used
+ *                    by the portable flash modules so that they build unchanged
+ *                    against the flash simulator.
+ *
+ * Related Document : See README.md
+ *
+ *******************************************************************************
+ * (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG. All rights reserved.
+ * This software, associated documentation and materials ("Software") is owned by
+ * Infineon Technologies AG or one of its affiliates ("Infineon") and is protected
+ * by and subject to worldwide patent protection, worldwide copyright laws, and
+ * international treaty provisions. Therefore, you may use this Software only as
+ * provided in the license agreement accompanying the software package from which
+ * you obtained this Software. If no license agreement applies, then any use,
+ * reproduction, modification, translation, or compilation of this Software is
+ * prohibited without the express written permission of Infineon.
+ * Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+ * IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING,
+ * BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF THIRD-PARTY RIGHTS AND
+ * IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A SPECIFIC USE/PURPOSE OR
+ * MERCHANTABILITY. Infineon reserves the right to make changes to the Software
+ * without notice. You are responsible for properly designing, programming, and
+ * testing the functionality and safety of your intended application of the
+ * Software, as well as complying with any legal requirements related to its
+ * use. Infineon does not guarantee that the Software will be free from intrusion,
+ * data theft or loss, or other breaches ("Security Breaches"), and Infineon
+ * shall have no liability arising out of any Security Breaches. Unless otherwise
+ * explicitly approved by Infineon, the Software may not be used in any application
+ * where a failure of the Product or any consequences of the use thereof can
+ * reasonably be expected to result in personal injury.
+ ******************************************************************************/
+
+#ifndef _MTB_SERIAL_MEMORY_H_
+#define _MTB_SERIAL_MEMORY_H_
+
+/*******************************************************************************
+ * Header Files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define CY_RSLT_SUCCESS                     ((cy_rslt_t)0U)
+
+/* Results returned by the simulated serial-memory functions */
+#define FLASH_SIM_RSLT_BAD_PARAM            ((cy_rslt_t)0x01U)
+#define FLASH_SIM_RSLT_BUSY                 ((cy_rslt_t)0x02U)
+
+#define CY_SMIF_NO_COMMAND_OR_MODE          (0xFFFFFFFFUL)
+#define CY_SMIF_FLAG_MEMORY_MAPPED          (0x02U)
+
+/* The host runs everything from RAM; RAM functions are plain functions */
+#define CY_RAMFUNC_BEGIN
+#define CY_RAMFUNC_END
+
+/*******************************************************************************
+ * Data Types
+ ******************************************************************************/
+typedef uint32_t cy_rslt_t;
+
+typedef enum
+{
+    CY_SMIF_SUCCESS,
+    CY_SMIF_EXCEED_TIMEOUT,
+    CY_SMIF_BAD_PARAM,
+    CY_SMIF_BUSY
+} cy_en_smif_status_t;
+
+/* The SMIF block of a simulated memory is the simulator instance itself */
+typedef struct flash_sim SMIF_Type;
+
+typedef struct
+{
+    uint32_t    unused;
+} cy_stc_smif_context_t;
+
+typedef struct
+{
+    uint32_t    command;
+    uint32_t    mode;
+    uint32_t    dummyCycles;
+} cy_stc_smif_mem_cmd_t;
+
+typedef struct
+{
+    uint32_t                numOfAddrBytes;
+    uint32_t                memSize;
+    cy_stc_smif_mem_cmd_t   *readCmd;
+    uint32_t                eraseSize;
+    uint32_t                programSize;
+} cy_stc_smif_mem_device_cfg_t;
+
+typedef struct
+{
+    uint32_t                        flags;
+    cy_stc_smif_mem_device_cfg_t    *deviceCfg;
+} cy_stc_smif_mem_config_t;
+
+typedef struct
+{
+    SMIF_Type               *base;
+    cy_stc_smif_context_t   context;
+} mtb_serial_memory_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+size_t mtb_serial_memory_get_size(mtb_serial_memory_t *obj);
+size_t mtb_serial_memory_get_erase_size(mtb_serial_memory_t *obj,
+                                        uint32_t addr);
+size_t mtb_serial_memory_get_prog_size(mtb_serial_memory_t *obj,
+                                        uint32_t addr);
+cy_rslt_t mtb_serial_memory_read(mtb_serial_memory_t *obj, uint32_t addr,
+                                size_t length, uint8_t *buf);
+cy_rslt_t mtb_serial_memory_write(mtb_serial_memory_t *obj, uint32_t addr,
+                                size_t length, const uint8_t *buf);
+cy_rslt_t mtb_serial_memory_erase(mtb_serial_memory_t *obj, uint32_t addr,
+                                size_t length);
+
+#endif /* _MTB_SERIAL_MEMORY_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+################################################################################
+# \file log_decode.py
+# \version 1.0
+#
+# \brief
+# Decodes the binary log frames of log_intern.c. The format strings are read
+# from the log_strings section of the application ELF file; console text
+# between the frames is passed through unchanged.
+#
+################################################################################
+# \copyright
+# (c) 2023-2025, Infineon Technologies AG, or an affiliate of Infineon Technologies AG.
+# SPDX-License-Identifier: Apache-2.0
+# 
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+# 
+#     http://www.apache.org/licenses/LICENSE-2.0
+# 
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+################################################################################
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+# Must match log_intern.h
+LOG_SYNC = 0xA5
+LOG_MAX_ARGS = 4
+LOG_SECTION = "log_strings"
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+# printf conversion: flags, width, precision, length modifier, conversion
+CONVERSION = re.compile(
+    r"%([-+ #0]*)(\d*)(\.\d+)?(hh|h|ll|l|z|j|t)?([diouxXcsp%])")
+
+
+class ElfFile:
+    """Section contents of a little-endian ELF32 or ELF64 file."""
+
+    def __init__(self, path):
+        with open(path, "rb") as elf:
+            self.data = elf.read()
+
+        if self.data[:4] != b"\x7fELF" or self.data[5] != 1:
+            raise ValueError("%s is not a little-endian ELF file" % path)
+
+        if self.data[4] == 1:
+            shoff, = struct.unpack_from("<I", self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from(
+                "<HHH", self.data, 0x2E)
+            header = "<IIIIIIIIII"
+        else:
+            shoff, = struct.unpack_from("<Q", self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from(
+                "<HHH", self.data, 0x3A)
+            header = "<IIQQQQIIQQ"
+
+        sections = [struct.unpack_from(header, self.data,
+                                       shoff + (index * shentsize))
+                    for index in range(shnum)]
+        names = sections[shstrndx][4]
+
+        # name, type, flags, address, file offset, size
+        self.sections = [(self.c_string(names + sec[0]), sec[1], sec[2],
+                          sec[3], sec[4], sec[5]) for sec in sections]
+
+    def c_string(self, offset):
+        end = self.data.index(b"\0", offset)
+        return self.data[offset:end].decode("latin-1")
+
+    def section(self, name):
+        for sec in self.sections:
+            if sec[0] == name:
+                return sec
+        raise KeyError("%s has no %s section" % (name, name))
+
+    def string_at(self, address):
+        """Returns the string at a load address, as used by %s."""
+        for _, sec_type, flags, start, offset, size in self.sections:
+            if ((flags & SHF_ALLOC) and (sec_type != SHT_NOBITS) and
+                    (start <= address < start + size)):
+                return self.c_string(offset + address - start)
+        return "<0x%08X>" % address
+
+
+class Decoder:
+    """Turns a byte stream of console text and log frames into text."""
+
+    def __init__(self, elf):
+        self.elf = elf
+        _, _, _, _, self.str_offset, self.str_size = elf.section(LOG_SECTION)
+        if self.str_size > 0x10000:
+            raise ValueError("%s exceeds the 16-bit string ID" % LOG_SECTION)
+        self.pending = bytearray()
+        self.frames = 0
+        self.frame_bytes = 0
+        self.text_bytes = 0
+
+    def format(self, string_id, args):
+        fmt = self.elf.c_string(self.str_offset + string_id)
+        args = iter(args)
+
+        def convert(match):
+            flags, width, precision, _, conversion = match.groups()
+            if conversion == "%":
+                return "%"
+            value = next(args, 0)
+            if conversion in "di":
+                value -= (value & 0x80000000) << 1
+                conversion = "d"
+            elif conversion == "u":
+                conversion = "d"
+            elif conversion == "c":
+                value = chr(value & 0xFF)
+            elif conversion == "s":
+                value = self.elf.string_at(value)
+            elif conversion == "p":
+                return "0x%08x" % value
+            spec = "%" + flags + width + (precision or "") + conversion
+            return spec % value
+
+        return CONVERSION.sub(convert, fmt)
+
+    def parse_frame(self):
+        """Returns (length, text) of the frame at the start of pending, or
+        None if more bytes are needed."""
+        buf = self.pending
+        if len(buf) < 4:
+            return None
+        string_id = buf[1] | (buf[2] << 8)
+        argc = min(buf[3], LOG_MAX_ARGS)
+        args = []
+        pos = 4
+        for _ in range(argc):
+            value = 0
+            shift = 0
+            while True:
+                if pos >= len(buf):
+                    return None
+                byte = buf[pos]
+                pos += 1
+                value |= (byte & 0x7F) << shift
+                shift += 7
+                if not byte & 0x80:
+                    break
+            args.append(value & 0xFFFFFFFF)
+        return pos, self.format(string_id, args)
+
+    def feed(self, data):
+        """Decodes a chunk of the stream and returns the resulting text."""
+        self.pending += data
+        out = []
+        while self.pending:
+            if self.pending[0] != LOG_SYNC:
+                end = self.pending.find(bytes([LOG_SYNC]))
+                end = len(self.pending) if end < 0 else end
+                out.append(self.pending[:end].decode("latin-1"))
+                del self.pending[:end]
+                continue
+            frame = self.parse_frame()
+            if frame is None:
+                break
+            length, text = frame
+            self.frames += 1
+            self.frame_bytes += length
+            self.text_bytes += len(text)
+            out.append(text)
+            del self.pending[:length]
+        return "".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decodes the binary log frames of log_intern.c.")
+    parser.add_argument("elf", help="application ELF file")
+    parser.add_argument("input", nargs="?", default="-",
+                        help="captured UART stream or serial device "
+                             "(default: stdin)")
+    parser.add_argument("--stats", action="store_true",
+                        help="print the log byte savings at the end")
+    args = parser.parse_args()
+
+    decoder = Decoder(ElfFile(args.elf))
+    fd = sys.stdin.fileno() if args.input == "-" else \
+        os.open(args.input, os.O_RDONLY)
+
+    try:
+        while True:
+            data = os.read(fd, 4096)
+            if not data:
+                break
+            sys.stdout.write(decoder.feed(data))
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+    if args.stats and decoder.frames:
+        sys.stderr.write(
+            "\n%d messages: %d frame bytes for %d text bytes (%.1f%%)\n" %
+            (decoder.frames, decoder.frame_bytes, decoder.text_bytes,
+             100.0 * decoder.frame_bytes / decoder.text_bytes))
+
+
+if __name__ == "__main__":
+    main()